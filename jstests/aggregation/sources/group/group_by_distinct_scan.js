@@ -0,0 +1,66 @@
+/**
+ * Tests that a $group which only collects the distinct values of an indexed field is answered with
+ * a DISTINCT_SCAN, and that it still returns the same groups as a collection scan.
+ */
+load("jstests/libs/analyze_plan.js");
+
+(function() {
+    "use strict";
+    const coll = db.group_by_distinct_scan;
+
+    coll.drop();
+
+    for (let i = 0; i < 100; i++) {
+        assert.writeOK(coll.insert({a: i % 5, b: i}));
+    }
+    assert.writeOK(coll.insert({b: "missing a"}));
+    assert.writeOK(coll.insert({a: null, b: "null a"}));
+
+    function groupIds(pipeline) {
+        return coll.aggregate(pipeline).toArray().map(doc => doc._id).sort();
+    }
+
+    function winningPlan(pipeline) {
+        const explain = coll.explain().aggregate(pipeline);
+        // Sharded explain output does not have a single cursor stage to inspect.
+        if (!explain.stages) {
+            return null;
+        }
+        return explain.stages[0].$cursor.queryPlanner.winningPlan;
+    }
+
+    const groupByA = [{$group: {_id: "$a"}}];
+    const groupByAWithMatch = [{$match: {a: {$gte: 2}}}, {$group: {_id: "$a"}}];
+    const expected = groupIds(groupByA);
+    const expectedWithMatch = groupIds(groupByAWithMatch);
+    assert.eq([0, 1, 2, 3, 4, null], expected);
+    assert.eq([2, 3, 4], expectedWithMatch);
+
+    assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+
+    let plan = winningPlan(groupByA);
+    if (plan) {
+        assert(planHasStage(plan, "DISTINCT_SCAN"), tojson(plan));
+    }
+    assert.eq(expected, groupIds(groupByA));
+
+    plan = winningPlan(groupByAWithMatch);
+    if (plan) {
+        assert(planHasStage(plan, "DISTINCT_SCAN"), tojson(plan));
+    }
+    assert.eq(expectedWithMatch, groupIds(groupByAWithMatch));
+
+    // A $group with accumulators needs to see every document.
+    plan = winningPlan([{$group: {_id: "$a", count: {$sum: 1}}}]);
+    if (plan) {
+        assert(!planHasStage(plan, "DISTINCT_SCAN"), tojson(plan));
+    }
+
+    // Arrays are grouped as a whole, so a multikey index cannot be used.
+    assert.writeOK(coll.insert({a: [1, 7], b: "array a"}));
+    plan = winningPlan(groupByA);
+    if (plan) {
+        assert(!planHasStage(plan, "DISTINCT_SCAN"), tojson(plan));
+    }
+    assert.eq([0, 1, 2, 3, 4, [1, 7], null].sort(), groupIds(groupByA));
+}());
@@ -0,0 +1,43 @@
+/**
+ * Tests that with internalQueryPlannerEnableCostBasedSelection the planner picks a plan from
+ * sampled collection statistics, without trying out the candidate plans, when one plan is
+ * estimated to be much cheaper than the others.
+ */
+load("jstests/libs/analyze_plan.js");
+
+(function() {
+    "use strict";
+
+    const conn =
+        MongoRunner.runMongod({setParameter: "internalQueryPlannerEnableCostBasedSelection=true"});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const coll = conn.getDB("test").cost_based_plan_selection;
+
+    // 'a' is nearly unique, while almost every document has the same value of 'b'.
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 2000; i++) {
+        bulk.insert({a: i, b: (i % 100 === 0) ? 1 : 0});
+    }
+    assert.writeOK(bulk.execute());
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.createIndex({b: 1}));
+
+    const query = {a: {$gte: 10, $lt: 20}, b: 0};
+    const explain = coll.find(query).explain("executionStats");
+    assert.eq(0, explain.queryPlanner.rejectedPlans.length, tojson(explain));
+    const ixscan = getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN");
+    assert.neq(null, ixscan, tojson(explain));
+    assert.eq("a_1", ixscan.indexName, tojson(explain));
+    assert.eq(10, explain.executionStats.nReturned, tojson(explain));
+
+    // Plans which can stop early are still ranked by running them.
+    const limitExplain = coll.find(query).limit(5).explain();
+    assert.gt(limitExplain.queryPlanner.rejectedPlans.length, 0, tojson(limitExplain));
+
+    // When the estimates are close, the plans are still ranked by running them.
+    assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+    const closeExplain = coll.find(query).explain();
+    assert.gt(closeExplain.queryPlanner.rejectedPlans.length, 0, tojson(closeExplain));
+
+    MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,43 @@
+/**
+ * Tests that a blocking sort in a find fails once it exceeds internalQueryExecMaxBlockingSortBytes,
+ * unless internalQueryExecBlockingSortAllowDiskUse lets it spill to disk.
+ */
+(function() {
+    "use strict";
+
+    const conn =
+        MongoRunner.runMongod({setParameter: "internalQueryExecMaxBlockingSortBytes=100000"});
+    assert.neq(null, conn, "mongod was unable to start up");
+    const coll = conn.getDB("test").find_sort_spill;
+
+    const bigStr = new Array(1024).join("x");
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 500; i++) {
+        bulk.insert({a: i, str: bigStr});
+    }
+    assert.writeOK(bulk.execute());
+
+    function sortedValues(limit) {
+        return coll.find({}, {_id: 0, a: 1}).sort({a: -1}).limit(limit).toArray().map(doc => doc.a);
+    }
+
+    // Without disk use the sort runs out of memory.
+    assert.throws(() => sortedValues(0));
+
+    assert.commandWorked(
+        conn.adminCommand({setParameter: 1, internalQueryExecBlockingSortAllowDiskUse: true}));
+
+    let expected = [];
+    for (let i = 499; i >= 0; i--) {
+        expected.push(i);
+    }
+    assert.eq(expected, sortedValues(0));
+    assert.eq(expected.slice(0, 300), sortedValues(300));
+
+    const explain = coll.find().sort({a: -1}).explain("executionStats");
+    const sortStage = explain.executionStats.executionStages;
+    assert.eq("SORT", sortStage.stage, tojson(explain));
+    assert(sortStage.usedDisk, tojson(explain));
+
+    MongoRunner.stopMongod(conn);
+}());
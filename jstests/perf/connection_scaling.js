@@ -0,0 +1,65 @@
+/**
+ * Connection scaling benchmark: opens a large number of mostly-idle connections against a local
+ * mongod and measures how the server copes, once per transport layer. The legacy transport layer
+ * dedicates a thread to every connection, while the asio transport layer multiplexes them over a
+ * fixed pool of worker threads.
+ *
+ * The number of idle connections defaults to 20000 and can be changed with
+ * TestData.numIdleConnections. The shell and the server each need a file descriptor limit above
+ * that number.
+ */
+(function() {
+    "use strict";
+
+    var numIdleConnections = TestData.numIdleConnections || 20000;
+    var numPings = 1000;
+
+    function runBenchmark(transportLayer) {
+        var conn = MongoRunner.runMongod(
+            {transportLayer: transportLayer, maxConns: numIdleConnections + 100});
+        assert.neq(null, conn, "mongod failed to start with transportLayer " + transportLayer);
+        var adminDB = conn.getDB("admin");
+        var residentBefore = adminDB.serverStatus().mem.resident;
+
+        var idle = [];
+        var openStart = Date.now();
+        try {
+            while (idle.length < numIdleConnections) {
+                var idleConn = new Mongo(conn.host);
+                assert.commandWorked(idleConn.getDB("admin").runCommand({isMaster: 1}));
+                idle.push(idleConn);
+            }
+        } catch (e) {
+            print("Stopped opening connections after " + idle.length + ": " + e);
+        }
+        var openMillis = Date.now() - openStart;
+
+        // Latency of an active connection while the idle ones are held open.
+        var pingStart = Date.now();
+        for (var i = 0; i < numPings; i++) {
+            assert.commandWorked(adminDB.runCommand({ping: 1}));
+        }
+        var pingMillis = Date.now() - pingStart;
+
+        var serverStatus = adminDB.serverStatus();
+        var result = {
+            transportLayer: transportLayer,
+            idleConnections: idle.length,
+            currentConnections: serverStatus.connections.current,
+            connectMicrosPerConnection: Math.round(1000 * openMillis / Math.max(idle.length, 1)),
+            pingMicros: Math.round(1000 * pingMillis / numPings),
+            residentMBIncrease: serverStatus.mem.resident - residentBefore,
+        };
+
+        idle.forEach(function(idleConn) {
+            idleConn.close();
+        });
+        MongoRunner.stopMongod(conn);
+        return result;
+    }
+
+    var results = ["legacy", "asio"].map(runBenchmark);
+    results.forEach(function(result) {
+        print("connection_scaling: " + tojson(result));
+    });
+}());
@@ -28,6 +28,15 @@ function testSecondaryMetrics(secondary, opCount, offset) {
     assert(ss.metrics.repl.apply.batches.num > 0, "no batches");
     assert(ss.metrics.repl.apply.batches.totalMillis >= 0, "missing batch time");
     assert.eq(ss.metrics.repl.apply.ops, opCount + offset, "wrong number of applied ops");
+
+    var writers = ss.metrics.repl.apply.writers;
+    assert(writers.batches > 0, "no writer batches");
+    assert.gt(writers.numWriters, 0, "no writers");
+    assert.eq(writers.numWriters, writers.ops.length, "wrong number of per-writer op counts");
+    assert.eq(writers.numWriters, writers.busyMicros.length, "wrong number of busy times");
+    assert.eq(writers.numWriters, writers.utilization.length, "wrong number of utilizations");
+    assert.gte(Array.sum(writers.ops), opCount, "writers applied too few ops");
+    assert.eq(writers.numWriters, writers.lastBatch.ops.length, "lastBatch missing op counts");
 }
 
 var rt = new ReplSetTest({name: "server_status_metrics", nodes: 2, oplogSize: 100});
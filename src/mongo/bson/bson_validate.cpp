@@ -36,6 +36,7 @@
 #include "mongo/bson/oid.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
 
 namespace mongo {
@@ -56,6 +57,39 @@ Status NOINLINE_DECL makeError(StringData baseMsg, BSONElement idElem) {
     return Status(ErrorCodes::InvalidBSON, msg);
 }
 
+/**
+ * Returns the offset of the first NUL byte in [data, data + length), or 'length' if there is none.
+ *
+ * Field names are usually only a few bytes long, which makes the call overhead of memchr dominate
+ * the search. The first words are therefore checked inline, eight bytes at a time, and only longer
+ * strings are handed to memchr, whose vectorized implementation is faster for them. Reading the
+ * words as little endian keeps the first matching byte in the lowest bits on all platforms.
+ */
+inline uint64_t findNulByte(const char* data, uint64_t length) {
+    const uint64_t kLowBits = 0x0101010101010101ULL;
+    const uint64_t kHighBits = 0x8080808080808080ULL;
+    const int kInlineWords = 4;
+
+    uint64_t offset = 0;
+    for (int i = 0; i < kInlineWords && offset + sizeof(uint64_t) <= length; ++i) {
+        const uint64_t word = ConstDataView(data).read<LittleEndian<uint64_t>>(offset);
+
+        // Sets the high bit of every zero byte. Bytes above the first zero byte may produce false
+        // positives due to borrows, but the lowest bit set always belongs to the first zero byte.
+        const uint64_t zeroBytes = (word - kLowBits) & ~word & kHighBits;
+        if (zeroBytes) {
+            return offset + countTrailingZeros64(zeroBytes) / 8;
+        }
+
+        offset += sizeof(uint64_t);
+    }
+
+    const void* x = memchr(data + offset, 0, length - offset);
+    if (!x)
+        return length;
+    return static_cast<uint64_t>(static_cast<const char*>(x) - data);
+}
+
 class Buffer {
 public:
     Buffer(const char* buffer, uint64_t maxLength, BSONVersion version)
@@ -73,10 +107,10 @@ public:
     }
 
     Status readCString(StringData* out) {
-        const void* x = memchr(_buffer + _position, 0, _maxLength - _position);
-        if (!x)
+        const uint64_t available = _maxLength - _position;
+        const uint64_t len = findNulByte(_buffer + _position, available);
+        if (len == available)
             return makeError("no end of c-string", _idElem);
-        uint64_t len = static_cast<uint64_t>(static_cast<const char*>(x) - (_buffer + _position));
 
         StringData data(_buffer + _position, len);
         _position += len + 1;
@@ -322,6 +322,20 @@ TEST(BSONValidateFast, StringHasSomething) {
     ASSERT_NOT_OK(validateBSON(x.objdata(), x.objsize(), BSONVersion::kLatest));
 }
 
+TEST(BSONValidateFast, FieldNamesOfAllLengths) {
+    for (size_t nameLength = 0; nameLength <= 64; ++nameLength) {
+        const std::string name(nameLength, 'a');
+        const BSONObj x = BSON(name << 1 << name + "b" << BSON(name << "value"));
+        ASSERT_OK(validateBSON(x.objdata(), x.objsize(), BSONVersion::kLatest));
+
+        // Cut the buffer inside of the first field name, so that it is not terminated.
+        const uint64_t truncatedLength = 4 + 1 + nameLength;
+        const Status status = validateBSON(x.objdata(), truncatedLength, BSONVersion::kLatest);
+        ASSERT_NOT_OK(status);
+        ASSERT_EQUALS(status.reason(), "no end of c-string in object with unknown _id");
+    }
+}
+
 TEST(BSONValidateBool, BoolValuesAreValidated) {
     BSONObjBuilder bob;
     bob.append("x", false);
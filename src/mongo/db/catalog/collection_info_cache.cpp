@@ -34,21 +34,41 @@
 
 #include "mongo/db/catalog/collection_info_cache.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_legacy.h"
+#include "mongo/db/index_names.h"
+#include "mongo/db/query/collection_statistics.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/util/clock_source.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
+namespace {
+
+bool statisticsAreStale(const CollectionStatistics& stats, long long numRecords, Date_t now) {
+    const long long drift = std::abs(numRecords - stats.getNumRecords());
+    if (drift > internalQueryStatisticsRefreshFraction.load() *
+            std::max(stats.getNumRecords(), 1LL)) {
+        return true;
+    }
+    return now - stats.getBuildTime() >= Seconds(internalQueryStatisticsMaxAgeSecs.load());
+}
+
+}  // namespace
+
 CollectionInfoCache::CollectionInfoCache(Collection* collection)
     : _collection(collection),
       _keysComputed(false),
@@ -229,6 +249,12 @@ void CollectionInfoCache::droppedIndex(OperationContext* txn, StringData indexNa
 void CollectionInfoCache::rebuildIndexData(OperationContext* txn) {
     clearQueryCache();
 
+    {
+        // The set of indexed fields may have changed.
+        stdx::lock_guard<stdx::mutex> lk(_statisticsMutex);
+        _statistics.reset();
+    }
+
     _keysComputed = false;
     computeIndexKeys(txn);
     updatePlanCacheIndexEntries(txn);
@@ -237,4 +263,66 @@ void CollectionInfoCache::rebuildIndexData(OperationContext* txn) {
 CollectionIndexUsageMap CollectionInfoCache::getIndexUsageStats() const {
     return _indexUsageTracker.getUsageStats();
 }
+
+std::shared_ptr<const CollectionStatistics> CollectionInfoCache::getStatistics(
+    OperationContext* txn) {
+    dassert(txn->lockState()->isCollectionLockedForMode(_collection->ns().ns(), MODE_IS));
+
+    const long long numRecords = _collection->numRecords(txn);
+    const Date_t now = getGlobalServiceContext()->getFastClockSource()->now();
+    {
+        stdx::lock_guard<stdx::mutex> lk(_statisticsMutex);
+        if (_statisticsBuilding ||
+            (_statistics && !statisticsAreStale(*_statistics, numRecords, now))) {
+            return _statistics;
+        }
+        _statisticsBuilding = true;
+    }
+    ON_BLOCK_EXIT([this] {
+        stdx::lock_guard<stdx::mutex> lk(_statisticsMutex);
+        _statisticsBuilding = false;
+    });
+
+    auto cursor = _collection->getRecordStore()->getRandomCursor(txn);
+    if (!cursor) {
+        return nullptr;
+    }
+
+    std::set<std::string> fields;
+    const bool includeUnfinishedIndexes = false;
+    IndexCatalog::IndexIterator ii =
+        _collection->getIndexCatalog()->getIndexIterator(txn, includeUnfinishedIndexes);
+    while (ii.more()) {
+        const IndexDescriptor* desc = ii.next();
+        if (desc->getAccessMethodName() != IndexNames::BTREE) {
+            continue;
+        }
+        BSONObjIterator keyPatternIt(desc->keyPattern());
+        while (keyPatternIt.more()) {
+            fields.insert(keyPatternIt.next().fieldName());
+        }
+    }
+
+    CollectionStatistics::Builder builder(std::move(fields));
+    const long long sampleSize =
+        std::min<long long>(internalQueryStatisticsSampleSize.load(), numRecords);
+    long long numSampled = 0;
+    for (; numSampled < sampleSize; ++numSampled) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        builder.addDocument(record->data.toBson());
+    }
+
+    std::shared_ptr<const CollectionStatistics> stats = builder.done(
+        numRecords, now, std::max(1, internalQueryStatisticsHistogramBuckets.load()));
+    LOG(1) << _collection->ns().ns() << ": built collection statistics from " << numSampled
+           << " of " << numRecords << " documents";
+
+    stdx::lock_guard<stdx::mutex> lk(_statisticsMutex);
+    _statistics = stats;
+    return stats;
 }
+
+}  // namespace mongo
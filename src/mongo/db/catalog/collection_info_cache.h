@@ -30,14 +30,18 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
 class Collection;
+class CollectionStatistics;
 class IndexDescriptor;
 class OperationContext;
 
@@ -75,6 +79,16 @@ public:
      */
     CollectionIndexUsageMap getIndexUsageStats() const;
 
+    /**
+     * Returns sampled statistics about the indexed fields of this collection, for cost-based
+     * plan selection. Statistics which are missing or stale are rebuilt by the calling operation,
+     * while concurrent operations keep using the previous statistics. Returns nullptr if there
+     * are no statistics yet, or the storage engine cannot sample the collection.
+     *
+     * Requires at least an intent shared lock on the collection.
+     */
+    std::shared_ptr<const CollectionStatistics> getStatistics(OperationContext* txn);
+
     /**
      * Builds internal cache state based on the current state of the Collection's IndexCatalog
      */
@@ -124,6 +138,12 @@ private:
     // Tracks index usage statistics for this collection.
     CollectionIndexUsageTracker _indexUsageTracker;
 
+    // Protects the sampled statistics, which operations holding only an intent lock on the
+    // collection may rebuild.
+    stdx::mutex _statisticsMutex;
+    std::shared_ptr<const CollectionStatistics> _statistics;
+    bool _statisticsBuilding = false;
+
     void computeIndexKeys(OperationContext* txn);
     void updatePlanCacheIndexEntries(OperationContext* txn);
 
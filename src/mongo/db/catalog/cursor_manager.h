@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include <array>
 
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/invalidation_type.h"
@@ -143,19 +144,51 @@ public:
     static std::size_t timeoutCursorsGlobal(OperationContext* txn, int millisSinceLastCall);
 
 private:
-    CursorId _allocateCursorId_inlock();
-    void _deregisterCursor_inlock(ClientCursor* cc);
+    // The cursor and executor registries are split into this many independently locked partitions
+    // so that concurrent getMores, and executors registering themselves around yields, do not all
+    // serialize on one mutex.
+    static const size_t kNumPartitions = 16;
+
+    typedef unordered_set<PlanExecutor*> ExecSet;
+    typedef std::map<CursorId, ClientCursor*> CursorMap;
+
+    struct Partition {
+        mutable SimpleMutex mutex;
+        ExecSet nonCachedExecutors;
+        CursorMap cursors;
+    };
+
+    /**
+     * Holds the mutex of every partition, acquired in partition order, for operations that need a
+     * consistent view of the whole registry.
+     */
+    class AllPartitionsLock {
+        MONGO_DISALLOW_COPYING(AllPartitionsLock);
+
+    public:
+        explicit AllPartitionsLock(const CursorManager* cursorManager);
+        ~AllPartitionsLock();
+
+    private:
+        const CursorManager* const _cursorManager;
+    };
+
+    Partition& _partitionForCursor(CursorId id);
+    Partition& _partitionForExecutor(PlanExecutor* exec);
+
+    /**
+     * Returns a randomly generated cursor id belonging to this manager. The caller must check it
+     * against the cursors of its partition, under that partition's lock.
+     */
+    CursorId _generateCursorId();
 
     NamespaceString _nss;
     unsigned _collectionCacheRuntimeId;
-    std::unique_ptr<PseudoRandom> _random;
 
-    mutable SimpleMutex _mutex;
-
-    typedef unordered_set<PlanExecutor*> ExecSet;
-    ExecSet _nonCachedExecutors;
+    // Guards '_random', which is shared by all partitions.
+    SimpleMutex _randomMutex;
+    std::unique_ptr<PseudoRandom> _random;
 
-    typedef std::map<CursorId, ClientCursor*> CursorMap;
-    CursorMap _cursors;
+    std::array<Partition, kNumPartitions> _partitions;
 };
 }
@@ -48,7 +48,11 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -89,6 +93,21 @@ public:
 
 } exportedMaxIndexBuildMemoryUsageParameter;
 
+// Maximum number of threads generating and sorting index keys during a foreground index build. A
+// value of 1 or less keeps the key generation on the thread scanning the collection.
+MONGO_EXPORT_SERVER_PARAMETER(maxIndexBuildKeyGenerationThreads, int, 4);
+
+namespace {
+
+// Collections with fewer records are indexed on a single thread
+const long long kParallelKeyGenerationMinRecords = 10000;
+
+// Limits of the batches of documents handed to the key generation threads
+const size_t kParallelKeyGenerationBatchDocs = 4096;
+const size_t kParallelKeyGenerationBatchBytes = 16 * 1024 * 1024;
+
+}  // namespace
+
 
 /**
  * On rollback sets MultiIndexBlock::_needToCleanup to true.
@@ -124,6 +143,153 @@ private:
     MultiIndexBlock* const _indexer;
 };
 
+/**
+ * Generates and sorts the index keys of a foreground index build on several threads. The collection
+ * is still scanned on the thread owning the OperationContext, which hands batches of owned
+ * documents to the workers. Each worker takes every n-th document of a batch and inserts its keys
+ * into a separate BulkBuilder per index, so the workers never share a Sorter. When the scan is
+ * done, the BulkBuilders of all workers are merged into the BulkBuilders of the MultiIndexBlock, so
+ * that their sorted runs are merged while the index is committed.
+ */
+class MultiIndexBlock::ParallelKeyGenerator {
+    MONGO_DISALLOW_COPYING(ParallelKeyGenerator);
+
+public:
+    ParallelKeyGenerator(MultiIndexBlock* indexer, size_t numWorkers)
+        : _indexer(indexer),
+          _numWorkers(numWorkers),
+          _pool([numWorkers] {
+              ThreadPool::Options options;
+              options.minThreads = numWorkers - 1;
+              options.maxThreads = numWorkers - 1;
+              return options;
+          }()),
+          _workerStatuses(numWorkers, Status::OK()) {
+        invariant(numWorkers > 1);
+
+        // Split the memory budget of each index between the workers
+        const size_t maxMemoryUsageBytes =
+            indexer->_eachIndexBuildMaxMemoryUsageBytes / numWorkers;
+
+        _bulks.resize(numWorkers);
+        for (auto&& workerBulks : _bulks) {
+            for (auto&& index : indexer->_indexes) {
+                invariant(index.bulk);
+                workerBulks.push_back(index.real->initiateBulk(maxMemoryUsageBytes));
+            }
+        }
+
+        _pool.startup();
+    }
+
+    /**
+     * Buffers a document for key generation. Once the buffer is full, waits for the keys of all
+     * buffered documents to be generated and returns the first error any worker encountered.
+     */
+    Status add(const BSONObj& doc, const RecordId& loc) {
+        _batchBytes += doc.objsize();
+        _batch.emplace_back(doc.getOwned(), loc);
+
+        if (_batch.size() < kParallelKeyGenerationBatchDocs &&
+            _batchBytes < kParallelKeyGenerationBatchBytes) {
+            return Status::OK();
+        }
+
+        return flush();
+    }
+
+    /**
+     * Generates the keys of all buffered documents, using the calling thread as one of the workers,
+     * and returns the first error any worker encountered.
+     */
+    Status flush() {
+        if (_batch.empty()) {
+            return Status::OK();
+        }
+
+        for (size_t worker = 1; worker < _numWorkers; worker++) {
+            Status status =
+                _pool.schedule(stdx::bind(&ParallelKeyGenerator::_processBatch, this, worker));
+            if (!status.isOK()) {
+                _pool.waitForIdle();
+                return status;
+            }
+        }
+
+        _processBatch(0);
+        _pool.waitForIdle();
+
+        _batch.clear();
+        _batchBytes = 0;
+
+        for (auto&& status : _workerStatuses) {
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+
+        return Status::OK();
+    }
+
+    /**
+     * Hands the keys generated by all workers over to the BulkBuilders of the MultiIndexBlock.
+     */
+    void done() {
+        invariant(_batch.empty());
+
+        for (auto&& workerBulks : _bulks) {
+            for (size_t i = 0; i < workerBulks.size(); i++) {
+                _indexer->_indexes[i].bulk->merge(std::move(workerBulks[i]));
+            }
+        }
+        _bulks.clear();
+    }
+
+private:
+    void _processBatch(size_t worker) {
+        std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>>& workerBulks = _bulks[worker];
+
+        try {
+            for (size_t i = worker; i < _batch.size(); i += _numWorkers) {
+                const BSONObj& doc = _batch[i].first;
+                const RecordId& loc = _batch[i].second;
+
+                for (size_t j = 0; j < _indexer->_indexes.size(); j++) {
+                    const IndexToBuild& index = _indexer->_indexes[j];
+                    if (index.filterExpression && !index.filterExpression->matchesBSON(doc)) {
+                        continue;
+                    }
+
+                    // BulkBuilder::insert only generates keys and adds them to its own Sorter, so
+                    // it does not access the OperationContext of the index build.
+                    int64_t unused;
+                    Status status =
+                        workerBulks[j]->insert(_indexer->_txn, doc, loc, index.options, &unused);
+                    if (!status.isOK()) {
+                        _workerStatuses[worker] = status;
+                        return;
+                    }
+                }
+            }
+        } catch (...) {
+            _workerStatuses[worker] = exceptionToStatus();
+        }
+    }
+
+    MultiIndexBlock* const _indexer;
+    const size_t _numWorkers;
+    ThreadPool _pool;
+
+    // The BulkBuilders of each worker, in the same order as the indexes of the MultiIndexBlock
+    std::vector<std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>>> _bulks;
+
+    // Outcome of the last batch processed by each worker
+    std::vector<Status> _workerStatuses;
+
+    std::vector<std::pair<BSONObj, RecordId>> _batch;
+    size_t _batchBytes = 0;
+};
+
 MultiIndexBlock::MultiIndexBlock(OperationContext* txn, Collection* collection)
     : _collection(collection),
       _txn(txn),
@@ -215,6 +381,7 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(const std::vector<BSONObj
         eachIndexBuildMaxMemoryUsageBytes =
             std::size_t(maxIndexBuildMemoryUsageMegabytes) * 1024 * 1024 / indexSpecs.size();
     }
+    _eachIndexBuildMaxMemoryUsageBytes = eachIndexBuildMaxMemoryUsageBytes;
 
     for (size_t i = 0; i < indexSpecs.size(); i++) {
         BSONObj info = indexSpecs[i];
@@ -293,6 +460,15 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
 
     unsigned long long n = 0;
 
+    // Foreground builds, where every index has a BulkBuilder, can generate keys in parallel
+    std::unique_ptr<ParallelKeyGenerator> keyGenerator;
+    const int keyGenerationThreads = maxIndexBuildKeyGenerationThreads;
+    if (!_buildInBackground && keyGenerationThreads > 1 &&
+        numRecords >= kParallelKeyGenerationMinRecords) {
+        keyGenerator = stdx::make_unique<ParallelKeyGenerator>(this, keyGenerationThreads);
+        log() << "\t generating index keys on " << keyGenerationThreads << " threads";
+    }
+
     unique_ptr<PlanExecutor> exec(InternalPlanner::collectionScan(
         _txn, _collection->ns().ns(), _collection, PlanExecutor::YIELD_MANUAL));
     if (_buildInBackground) {
@@ -324,7 +500,8 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
             progress->setTotalWhileRunning(_collection->numRecords(_txn));
 
             WriteUnitOfWork wunit(_txn);
-            Status ret = insert(objToIndex.value(), loc);
+            Status ret = keyGenerator ? keyGenerator->add(objToIndex.value(), loc)
+                                      : insert(objToIndex.value(), loc);
             if (_buildInBackground)
                 exec->saveState();
             if (ret.isOK()) {
@@ -362,6 +539,13 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(std::set<RecordId>* dupsO
                 WorkingSetCommon::toStatusString(objToIndex.value()),
             state == PlanExecutor::IS_EOF);
 
+    if (keyGenerator) {
+        Status ret = keyGenerator->flush();
+        if (!ret.isOK())
+            return ret;
+        keyGenerator->done();
+    }
+
     if (MONGO_FAIL_POINT(hangAfterStartingIndexBuild)) {
         // Need the index build to hang before the progress meter is marked as finished so we can
         // reliably check that the index build has actually started in js tests.
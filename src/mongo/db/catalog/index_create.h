@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <string>
@@ -47,6 +48,8 @@ class BSONObj;
 class Collection;
 class OperationContext;
 
+extern std::atomic<int> maxIndexBuildKeyGenerationThreads;  // NOLINT
+
 /**
  * Builds one or more indexes.
  *
@@ -128,6 +131,10 @@ public:
      *
      * Can throw an exception if interrupted.
      *
+     * Foreground builds of large collections generate and sort the index keys on up to
+     * 'maxIndexBuildKeyGenerationThreads' threads, while the collection is scanned on the calling
+     * thread.
+     *
      * Should not be called inside of a WriteUnitOfWork.
      */
     Status insertAllDocumentsInCollection(std::set<RecordId>* dupsOut = NULL);
@@ -189,6 +196,7 @@ public:
 private:
     class SetNeedToCleanupOnRollback;
     class CleanupIndexesVectorOnRollback;
+    class ParallelKeyGenerator;
 
     struct IndexToBuild {
         std::unique_ptr<IndexCatalog::IndexBuildBlock> block;
@@ -202,6 +210,9 @@ private:
 
     std::vector<IndexToBuild> _indexes;
 
+    // Memory budget of the BulkBuilder of each index
+    std::size_t _eachIndexBuildMaxMemoryUsageBytes = 0;
+
     std::unique_ptr<BackgroundOperation> _backgroundOperation;
 
     // Pointers not owned here and must outlive 'this'
@@ -149,6 +149,16 @@ std::string Client::clientAddress(bool includePort) const {
     return getRemote().host();
 }
 
+ServiceContext::UniqueClient Client::releaseCurrent() {
+    invariant(haveClient());
+    return std::move(*currentClient.get());
+}
+
+void Client::setCurrent(ServiceContext::UniqueClient client) {
+    invariant(!haveClient());
+    *currentClient.getMake() = std::move(client);
+}
+
 Client* Client::getCurrent() {
     return currentClient.getMake()->get();
 }
@@ -78,6 +78,17 @@ public:
 
     static Client* getCurrent();
 
+    /**
+     * Moves the Client object out of TLS for the current thread, leaving the thread without a
+     * Client. Used to hand a session's Client between the worker threads that run its requests.
+     */
+    static ServiceContext::UniqueClient releaseCurrent();
+
+    /**
+     * Stores 'client' in TLS for the current thread, which must not already have a Client.
+     */
+    static void setCurrent(ServiceContext::UniqueClient client);
+
     bool getIsLocalHostConnection() {
         if (!hasRemote()) {
             return false;
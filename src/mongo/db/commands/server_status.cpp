@@ -120,9 +120,7 @@ public:
         for (SectionMap::const_iterator i = _sections->begin(); i != _sections->end(); ++i) {
             ServerStatusSection* section = i->second;
 
-            std::vector<Privilege> requiredPrivileges;
-            section->addRequiredPrivileges(&requiredPrivileges);
-            if (!authSession->isAuthorizedForPrivileges(requiredPrivileges))
+            if (!isAuthorizedForSection(authSession, section))
                 continue;
 
             bool include = section->includeByDefault();
@@ -182,7 +180,37 @@ public:
         (*_sections)[section->getSectionName()] = section;
     }
 
+    void appendSections(OperationContext* txn,
+                        const BSONObj& sectionSpecs,
+                        BSONObjBuilder* result) {
+        _runCalled = true;
+
+        const auto authSession = AuthorizationSession::get(Client::getCurrent());
+
+        for (auto&& elem : sectionSpecs) {
+            if (!elem.trueValue())
+                continue;
+
+            auto it = _sections->find(elem.fieldName());
+            if (it == _sections->end())
+                continue;
+
+            ServerStatusSection* section = it->second;
+            if (!isAuthorizedForSection(authSession, section))
+                continue;
+
+            section->appendSection(txn, elem, result);
+        }
+    }
+
 private:
+    static bool isAuthorizedForSection(AuthorizationSession* authSession,
+                                       ServerStatusSection* section) {
+        std::vector<Privilege> requiredPrivileges;
+        section->addRequiredPrivileges(&requiredPrivileges);
+        return authSession->isAuthorizedForPrivileges(requiredPrivileges);
+    }
+
     const Date_t _started;
     bool _runCalled;
 
@@ -193,6 +221,12 @@ private:
 
 CmdServerStatus::SectionMap* CmdServerStatus::_sections = 0;
 
+void appendServerStatusSections(OperationContext* txn,
+                                const BSONObj& sectionSpecs,
+                                BSONObjBuilder* result) {
+    cmdServerStatus.appendSections(txn, sectionSpecs, result);
+}
+
 ServerStatusSection::ServerStatusSection(const string& sectionName) : _sectionName(sectionName) {
     cmdServerStatus.addSection(this);
 }
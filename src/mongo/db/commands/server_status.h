@@ -107,6 +107,16 @@ private:
     const std::string _sectionName;
 };
 
+/**
+ * Appends the sections named by the fields of 'sectionSpecs' to 'result' as serverStatus would,
+ * passing each field to its section as the configElement. Unlike serverStatus, nothing else is
+ * appended, so this is cheap enough to call many times per second for sections that only read
+ * counters. Unknown sections and fields that are false are skipped.
+ */
+void appendServerStatusSections(OperationContext* txn,
+                                const BSONObj& sectionSpecs,
+                                BSONObjBuilder* result);
+
 class OpCounterServerStatusSection : public ServerStatusSection {
 public:
     OpCounterServerStatusSection(const std::string& sectionName, OpCounters* counters);
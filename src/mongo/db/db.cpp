@@ -119,6 +119,7 @@
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/transport/transport_layer_asio.h"
 #include "mongo/transport/transport_layer_legacy.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/cmdline_utils/censor_cmdline.h"
@@ -551,10 +552,6 @@ ExitCode _initAndListen(int listenPort) {
 
     checked_cast<ServiceContextMongoD*>(getGlobalServiceContext())->createLockFile();
 
-    transport::TransportLayerLegacy::Options options;
-    options.port = listenPort;
-    options.ipList = serverGlobalParams.bind_ip;
-
     auto sep =
         stdx::make_unique<ServiceEntryPointMongod>(getGlobalServiceContext()->getTransportLayer());
     auto sepPtr = sep.get();
@@ -562,8 +559,27 @@ ExitCode _initAndListen(int listenPort) {
     getGlobalServiceContext()->setServiceEntryPoint(std::move(sep));
 
     // Create, start, and attach the TL
-    auto transportLayer = stdx::make_unique<transport::TransportLayerLegacy>(options, sepPtr);
-    auto res = transportLayer->setup();
+    std::unique_ptr<transport::TransportLayer> transportLayer;
+    Status res = Status::OK();
+    if (serverGlobalParams.transportLayer == "asio") {
+        transport::TransportLayerASIO::Options options;
+        options.port = listenPort;
+        options.ipList = serverGlobalParams.bind_ip;
+        options.threadCount = serverGlobalParams.transportLayerThreads;
+
+        auto asioTransportLayer = stdx::make_unique<transport::TransportLayerASIO>(options, sepPtr);
+        res = asioTransportLayer->setup();
+        transportLayer = std::move(asioTransportLayer);
+    } else {
+        transport::TransportLayerLegacy::Options options;
+        options.port = listenPort;
+        options.ipList = serverGlobalParams.bind_ip;
+
+        auto legacyTransportLayer =
+            stdx::make_unique<transport::TransportLayerLegacy>(options, sepPtr);
+        res = legacyTransportLayer->setup();
+        transportLayer = std::move(legacyTransportLayer);
+    }
     if (!res.isOK()) {
         error() << "Failed to set up listener: " << res;
         return EXIT_NET_ERROR;
@@ -66,6 +66,10 @@ CollectionScan::CollectionScan(OperationContext* txn,
       _wsidForFetch(_workingSet->allocate()) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
+
+    if (_filter) {
+        _topLevelFieldMatcher = TopLevelFieldMatcher::make(_filter);
+    }
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -179,14 +183,43 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     return returnIfMatches(member, id, out);
 }
 
+PlanStage::StageState CollectionScan::doWorkBatch(size_t maxWorks,
+                                                  std::vector<WorkingSetID>* out,
+                                                  WorkingSetID* stateId,
+                                                  PlanYieldPolicy* yieldPolicy) {
+    const size_t numResultsBefore = out->size();
+    for (size_t i = 0; i < maxWorks; ++i) {
+        if (i > 0 && batchShouldYield(yieldPolicy)) {
+            break;
+        }
+
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState state = doWork(&id);
+        recordWork(state);
+
+        if (PlanStage::ADVANCED == state) {
+            // The record's data may belong to the cursor, which is free to reuse it when it
+            // advances, so it has to be copied before we move on to the next record.
+            _workingSet->get(id)->makeObjOwnedIfNeeded();
+            out->push_back(id);
+        } else if (PlanStage::NEED_TIME != state) {
+            *stateId = id;
+            return state;
+        }
+    }
+
+    return out->size() > numResultsBefore ? PlanStage::ADVANCED : PlanStage::NEED_TIME;
+}
+
 PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID memberID,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _topLevelFieldMatcher.get())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _topLevelFieldMatcher.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
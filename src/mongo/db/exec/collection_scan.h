@@ -33,6 +33,7 @@
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/top_level_field_matcher.h"
 #include "mongo/db/record_id.h"
 
 namespace mongo {
@@ -55,8 +56,16 @@ public:
                    const MatchExpression* filter);
 
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateId,
+                           PlanYieldPolicy* yieldPolicy) final;
     bool isEOF() final;
 
+    bool supportsBatchedWork() const final {
+        return true;
+    }
+
     void doInvalidate(OperationContext* txn, const RecordId& dl, InvalidationType type) final;
     void doSaveState() final;
     void doRestoreState() final;
@@ -86,6 +95,9 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Evaluates _filter against fetched documents if it only has predicates on top-level fields.
+    std::unique_ptr<TopLevelFieldMatcher> _topLevelFieldMatcher;
+
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
     CollectionScanParams _params;
@@ -60,6 +60,10 @@ FetchStage::FetchStage(OperationContext* txn,
       _filter(filter),
       _idRetrying(WorkingSet::INVALID_ID) {
     _children.emplace_back(child);
+
+    if (_filter) {
+        _topLevelFieldMatcher = TopLevelFieldMatcher::make(_filter);
+    }
 }
 
 FetchStage::~FetchStage() {}
@@ -71,6 +75,11 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (!_batchPending.empty() || PlanStage::NEED_TIME != _batchChildState) {
+        // We still have part of a batch to process.
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -79,58 +88,29 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    // Either retry the last WSM we worked on or get a new one from our child.
+    // Either retry the last WSM we worked on, finish off a batch started by doWorkBatch(), or get
+    // a new one from our child.
     WorkingSetID id;
     StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
-    } else {
+    if (_idRetrying != WorkingSet::INVALID_ID) {
         status = ADVANCED;
         id = _idRetrying;
         _idRetrying = WorkingSet::INVALID_ID;
+    } else if (!_batchPending.empty()) {
+        status = ADVANCED;
+        id = _batchPending.front();
+        _batchPending.pop_front();
+    } else if (_batchChildState != NEED_TIME) {
+        status = _batchChildState;
+        id = _batchChildStateId;
+        _batchChildState = NEED_TIME;
+        _batchChildStateId = WorkingSet::INVALID_ID;
+    } else {
+        status = child()->work(&id);
     }
 
     if (PlanStage::ADVANCED == status) {
-        WorkingSetMember* member = _ws->get(id);
-
-        // If there's an obj there, there is no fetching to perform.
-        if (member->hasObj()) {
-            ++_specificStats.alreadyHasObj;
-        } else {
-            // We need a valid RecordId to fetch from and this is the only state that has one.
-            verify(WorkingSetMember::RID_AND_IDX == member->getState());
-            verify(member->hasRecordId());
-
-            try {
-                if (!_cursor)
-                    _cursor = _collection->getCursor(getOpCtx());
-
-                if (auto fetcher = _cursor->fetcherForId(member->recordId)) {
-                    // There's something to fetch. Hand the fetcher off to the WSM, and pass up
-                    // a fetch request.
-                    _idRetrying = id;
-                    member->setFetcher(fetcher.release());
-                    *out = id;
-                    return NEED_YIELD;
-                }
-
-                // The doc is already in memory, so go ahead and grab it. Now we have a RecordId
-                // as well as an unowned object
-                if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor)) {
-                    _ws->free(id);
-                    return NEED_TIME;
-                }
-            } catch (const WriteConflictException& wce) {
-                // Ensure that the BSONObj underlying the WorkingSetMember is owned because it may
-                // be freed when we yield.
-                member->makeObjOwnedIfNeeded();
-                _idRetrying = id;
-                *out = WorkingSet::INVALID_ID;
-                return NEED_YIELD;
-            }
-        }
-
-        return returnIfMatches(member, id, out);
+        return fetchMember(id, out);
     } else if (PlanStage::FAILURE == status || PlanStage::DEAD == status) {
         *out = id;
         // If a stage fails, it may create a status WSM to indicate why it
@@ -150,7 +130,163 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatch(size_t maxWorks,
+                                              std::vector<WorkingSetID>* out,
+                                              WorkingSetID* stateId,
+                                              PlanYieldPolicy* yieldPolicy) {
+    if (isEOF()) {
+        recordWork(PlanStage::IS_EOF);
+        return PlanStage::IS_EOF;
+    }
+
+    // Only ask our child for more once we have dealt with everything from its last batch.
+    if (_batchPending.empty() && WorkingSet::INVALID_ID == _idRetrying &&
+        PlanStage::NEED_TIME == _batchChildState) {
+        _childBatch.clear();
+        _batchChildStateId = WorkingSet::INVALID_ID;
+        _batchChildState =
+            child()->workBatch(maxWorks, &_childBatch, &_batchChildStateId, yieldPolicy);
+        if (PlanStage::ADVANCED == _batchChildState) {
+            // Nothing to report once the results are dealt with.
+            _batchChildState = PlanStage::NEED_TIME;
+        }
+        _batchPending.assign(_childBatch.begin(), _childBatch.end());
+        prefetchPendingBatch();
+    }
+
+    // Either retry the last WSM we worked on, or carry on with the pending ones.
+    if (WorkingSet::INVALID_ID != _idRetrying) {
+        _batchPending.push_front(_idRetrying);
+        _idRetrying = WorkingSet::INVALID_ID;
+    }
+
+    const size_t numResultsBefore = out->size();
+    while (!_batchPending.empty()) {
+        WorkingSetID id = _batchPending.front();
+        _batchPending.pop_front();
+
+        WorkingSetID resultId = WorkingSet::INVALID_ID;
+        StageState state = fetchMember(id, &resultId);
+        recordWork(state);
+
+        if (PlanStage::ADVANCED == state) {
+            // Our cursor is free to reuse the record's data when it next seeks, so the result has
+            // to be copied before we fetch the next one.
+            _ws->get(resultId)->makeObjOwnedIfNeeded();
+            out->push_back(resultId);
+        } else if (PlanStage::NEED_YIELD == state) {
+            // fetchMember() has put the member in '_idRetrying'. The rest of the batch waits
+            // until after the yield.
+            *stateId = resultId;
+            return PlanStage::NEED_YIELD;
+        }
+
+        if (!_batchPending.empty() && batchShouldYield(yieldPolicy)) {
+            // The rest of the batch waits until after the yield, as for a fetch request.
+            return out->size() > numResultsBefore ? PlanStage::ADVANCED : PlanStage::NEED_TIME;
+        }
+    }
+
+    const StageState childState = _batchChildState;
+    *stateId = _batchChildStateId;
+    _batchChildState = PlanStage::NEED_TIME;
+    _batchChildStateId = WorkingSet::INVALID_ID;
+    return finishBatchFromChild(childState, out->size() > numResultsBefore, _ws, stateId);
+}
+
+PlanStage::StageState FetchStage::fetchMember(WorkingSetID id, WorkingSetID* out) {
+    WorkingSetMember* member = _ws->get(id);
+
+    // If there's an obj there, there is no fetching to perform.
+    if (member->hasObj()) {
+        ++_specificStats.alreadyHasObj;
+    } else {
+        // We need a valid RecordId to fetch from and this is the only state that has one.
+        verify(WorkingSetMember::RID_AND_IDX == member->getState());
+        verify(member->hasRecordId());
+
+        try {
+            auto prefetched = _prefetched.find(id);
+            if (prefetched != _prefetched.end()) {
+                auto record = std::move(prefetched->second);
+                _prefetched.erase(prefetched);
+                if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, std::move(record))) {
+                    _ws->free(id);
+                    return NEED_TIME;
+                }
+                return returnIfMatches(member, id, out);
+            }
+
+            if (!_cursor)
+                _cursor = _collection->getCursor(getOpCtx());
+
+            if (auto fetcher = _cursor->fetcherForId(member->recordId)) {
+                // There's something to fetch. Hand the fetcher off to the WSM, and pass up
+                // a fetch request.
+                _idRetrying = id;
+                member->setFetcher(fetcher.release());
+                *out = id;
+                return NEED_YIELD;
+            }
+
+            // The doc is already in memory, so go ahead and grab it. Now we have a RecordId
+            // as well as an unowned object
+            if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor)) {
+                _ws->free(id);
+                return NEED_TIME;
+            }
+        } catch (const WriteConflictException& wce) {
+            // Ensure that the BSONObj underlying the WorkingSetMember is owned because it may
+            // be freed when we yield.
+            member->makeObjOwnedIfNeeded();
+            _idRetrying = id;
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+    }
+
+    return returnIfMatches(member, id, out);
+}
+
+void FetchStage::prefetchPendingBatch() {
+    _prefetched.clear();
+
+    std::vector<WorkingSetID> ids;
+    std::vector<RecordId> recordIds;
+    for (auto&& id : _batchPending) {
+        WorkingSetMember* member = _ws->get(id);
+        if (!member->hasObj() && WorkingSetMember::RID_AND_IDX == member->getState()) {
+            ids.push_back(id);
+            recordIds.push_back(member->recordId);
+        }
+    }
+
+    // Nothing to gain from a batch of one.
+    if (recordIds.size() < 2) {
+        return;
+    }
+
+    if (!_cursor)
+        _cursor = _collection->getCursor(getOpCtx());
+
+    std::vector<boost::optional<Record>> records;
+    try {
+        if (!_cursor->seekExactBatch(recordIds, &records)) {
+            return;
+        }
+    } catch (const WriteConflictException&) {
+        // Let fetchMember() run into the conflict again and ask for a yield.
+        return;
+    }
+
+    invariant(records.size() == ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        _prefetched.emplace(ids[i], std::move(records[i]));
+    }
+}
+
 void FetchStage::doSaveState() {
+    _prefetched.clear();
     if (_cursor)
         _cursor->saveUnpositioned();
 }
@@ -180,6 +316,14 @@ void FetchStage::doInvalidate(OperationContext* txn, const RecordId& dl, Invalid
             WorkingSetCommon::fetchAndInvalidateRecordId(txn, member, _collection);
         }
     }
+
+    // The same goes for the members of a batch that are waiting on us to yield.
+    for (auto&& id : _batchPending) {
+        WorkingSetMember* member = _ws->get(id);
+        if (member->hasRecordId() && (member->recordId == dl)) {
+            WorkingSetCommon::fetchAndInvalidateRecordId(txn, member, _collection);
+        }
+    }
 }
 
 PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
@@ -201,7 +345,7 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     // predicate.
     ++_specificStats.docsExamined;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _topLevelFieldMatcher.get())) {
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
@@ -28,12 +28,16 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/top_level_field_matcher.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -59,6 +63,14 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateId,
+                           PlanYieldPolicy* yieldPolicy) final;
+
+    bool supportsBatchedWork() const final {
+        return true;
+    }
 
     void doSaveState() final;
     void doRestoreState() final;
@@ -77,12 +89,26 @@ public:
     static const char* kStageType;
 
 private:
+    /**
+     * Fetches the document for member 'id' if it doesn't already have one, then applies our
+     * filter to it as returnIfMatches() does. If the fetch needs a yield first, the member is
+     * stored in '_idRetrying' and NEED_YIELD is returned.
+     */
+    StageState fetchMember(WorkingSetID id, WorkingSetID* out);
+
     /**
      * If the member (with id memberID) passes our filter, set *out to memberID and return that
      * ADVANCED.  Otherwise, free memberID and return NEED_TIME.
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Looks up the records of all members in '_batchPending' that still need fetching with a
+     * single SeekableRecordCursor::seekExactBatch() call and keeps them in '_prefetched' for
+     * fetchMember(). Does nothing if the cursor has no batched lookup.
+     */
+    void prefetchPendingBatch();
+
     // Collection which is used by this stage. Used to resolve record ids retrieved by child
     // stages. The lifetime of the collection must supersede that of the stage.
     const Collection* _collection;
@@ -95,9 +121,24 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Evaluates _filter against fetched documents if it only has predicates on top-level fields.
+    std::unique_ptr<TopLevelFieldMatcher> _topLevelFieldMatcher;
+
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // Results of our child's last batch that doWorkBatch() has yet to fetch, followed by the state
+    // that ended that batch and the WorkingSetID that came with that state. They are kept across
+    // calls when fetching one of the results requires a yield.
+    std::deque<WorkingSetID> _batchPending;
+    StageState _batchChildState = PlanStage::NEED_TIME;
+    WorkingSetID _batchChildStateId = WorkingSet::INVALID_ID;
+    std::vector<WorkingSetID> _childBatch;
+
+    // Records looked up ahead of time for members of '_batchPending'. They belong to the current
+    // snapshot, so they are dropped whenever we save our state.
+    stdx::unordered_map<WorkingSetID, boost::optional<Record>> _prefetched;
+
     // Stats
     FetchStats _specificStats;
 };
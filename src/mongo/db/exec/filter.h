@@ -31,6 +31,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/matchable.h"
+#include "mongo/db/matcher/top_level_field_matcher.h"
 
 namespace mongo {
 
@@ -157,6 +158,19 @@ public:
         return filter->matches(&doc, NULL);
     }
 
+    /**
+     * As above, but evaluates 'filter' with 'topLevelFieldMatcher' when the member has an object
+     * and the stage could build a TopLevelFieldMatcher for the filter.
+     */
+    static bool passes(WorkingSetMember* wsm,
+                       const MatchExpression* filter,
+                       TopLevelFieldMatcher* topLevelFieldMatcher) {
+        if (topLevelFieldMatcher && wsm->hasObj()) {
+            return topLevelFieldMatcher->matches(wsm->obj.value());
+        }
+        return passes(wsm, filter);
+    }
+
     static bool passes(const BSONObj& keyData,
                        const BSONObj& keyPattern,
                        const MatchExpression* filter) {
@@ -134,6 +134,7 @@ static void extractGeometries(const BSONObj& doc,
 }
 
 static StatusWith<double> computeGeoNearDistance(const GeoNearParams& nearParams,
+                                                 WorkingSet* workingSet,
                                                  WorkingSetMember* member) {
     //
     // Generic GeoNear distance computation
@@ -187,14 +188,15 @@ static StatusWith<double> computeGeoNearDistance(const GeoNearParams& nearParams
             // Hack for nearSphere
             // TODO: Remove nearSphere?
             invariant(SPHERE == queryCRS);
-            member->addComputed(new GeoDistanceComputedData(minDistance / kRadiusOfEarthInMeters));
+            member->addComputed(workingSet->makeComputed<GeoDistanceComputedData>(
+                minDistance / kRadiusOfEarthInMeters));
         } else {
-            member->addComputed(new GeoDistanceComputedData(minDistance));
+            member->addComputed(workingSet->makeComputed<GeoDistanceComputedData>(minDistance));
         }
     }
 
     if (nearParams.addPointMeta) {
-        member->addComputed(new GeoNearPointComputedData(minDistanceObj));
+        member->addComputed(workingSet->makeComputed<GeoNearPointComputedData>(minDistanceObj));
     }
 
     return StatusWith<double>(minDistance);
@@ -746,8 +748,9 @@ StatusWith<NearStage::CoveredInterval*>  //
                                                             isLastInterval));
 }
 
-StatusWith<double> GeoNear2DStage::computeDistance(WorkingSetMember* member) {
-    return computeGeoNearDistance(_nearParams, member);
+StatusWith<double> GeoNear2DStage::computeDistance(WorkingSet* workingSet,
+                                                   WorkingSetMember* member) {
+    return computeGeoNearDistance(_nearParams, workingSet, member);
 }
 
 //
@@ -1105,8 +1108,9 @@ StatusWith<NearStage::CoveredInterval*>  //
                                                             isLastInterval));
 }
 
-StatusWith<double> GeoNear2DSphereStage::computeDistance(WorkingSetMember* member) {
-    return computeGeoNearDistance(_nearParams, member);
+StatusWith<double> GeoNear2DSphereStage::computeDistance(WorkingSet* workingSet,
+                                                         WorkingSetMember* member) {
+    return computeGeoNearDistance(_nearParams, workingSet, member);
 }
 
 }  // namespace mongo
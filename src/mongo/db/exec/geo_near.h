@@ -76,7 +76,7 @@ protected:
                                               WorkingSet* workingSet,
                                               Collection* collection) final;
 
-    StatusWith<double> computeDistance(WorkingSetMember* member) final;
+    StatusWith<double> computeDistance(WorkingSet* workingSet, WorkingSetMember* member) final;
 
     PlanStage::StageState initialize(OperationContext* txn,
                                      WorkingSet* workingSet,
@@ -124,7 +124,7 @@ protected:
                                               WorkingSet* workingSet,
                                               Collection* collection) final;
 
-    StatusWith<double> computeDistance(WorkingSetMember* member) final;
+    StatusWith<double> computeDistance(WorkingSet* workingSet, WorkingSetMember* member) final;
 
     PlanStage::StageState initialize(OperationContext* txn,
                                      WorkingSet* workingSet,
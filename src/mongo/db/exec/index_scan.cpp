@@ -229,7 +229,7 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
     if (_params.addKeyMetadata) {
         BSONObjBuilder bob;
         bob.appendKeys(_keyPattern, kv->key);
-        member->addComputed(new IndexKeyComputedData(bob.obj()));
+        member->addComputed(_workingSet->makeComputed<IndexKeyComputedData>(bob.obj()));
     }
 
     *out = id;
@@ -97,6 +97,11 @@ public:
 
     StageState doWork(WorkingSetID* out) final;
     bool isEOF() final;
+
+    bool supportsBatchedWork() const final {
+        return true;
+    }
+
     void doSaveState() final;
     void doRestoreState() final;
     void doDetachFromOperationContext() final;
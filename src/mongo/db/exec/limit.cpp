@@ -86,6 +86,33 @@ PlanStage::StageState LimitStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState LimitStage::doWorkBatch(size_t maxWorks,
+                                              std::vector<WorkingSetID>* out,
+                                              WorkingSetID* stateId,
+                                              PlanYieldPolicy* yieldPolicy) {
+    if (0 == _numToReturn) {
+        // We've returned as many results as we're limited to.
+        recordWork(PlanStage::IS_EOF);
+        return PlanStage::IS_EOF;
+    }
+
+    // Never ask our child for more than we can return, so that it does not read past the limit.
+    _childBatch.clear();
+    StageState childState =
+        child()->workBatch(std::min(maxWorks, static_cast<size_t>(_numToReturn)),
+                           &_childBatch,
+                           stateId,
+                           yieldPolicy);
+
+    for (auto&& id : _childBatch) {
+        out->push_back(id);
+        --_numToReturn;
+        recordWork(PlanStage::ADVANCED);
+    }
+
+    return finishBatchFromChild(childState, !_childBatch.empty(), _ws, stateId);
+}
+
 unique_ptr<PlanStageStats> LimitStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_LIMIT);
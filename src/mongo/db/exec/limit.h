@@ -49,6 +49,14 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateId,
+                           PlanYieldPolicy* yieldPolicy) final;
+
+    bool supportsBatchedWork() const final {
+        return true;
+    }
 
     StageType stageType() const final {
         return STAGE_LIMIT;
@@ -66,6 +74,9 @@ private:
     // We only return this many results.
     long long _numToReturn;
 
+    // Holds the results of our child's batch while doWorkBatch() processes them.
+    std::vector<WorkingSetID> _childBatch;
+
     // Stats
     LimitStats _specificStats;
 };
@@ -195,7 +195,7 @@ PlanStage::StageState NearStage::bufferNext(WorkingSetID* toReturn, Status* erro
 
     ++_nextIntervalStats->numResultsBuffered;
 
-    StatusWith<double> distanceStatus = computeDistance(nextMember);
+    StatusWith<double> distanceStatus = computeDistance(_workingSet, nextMember);
 
     if (!distanceStatus.isOK()) {
         _searchState = SearchState_Finished;
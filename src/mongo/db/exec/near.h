@@ -133,11 +133,13 @@ protected:
 
     /**
      * Computes the distance value for the given member data, or -1 if the member should not be
-     * returned in the sorted results.
+     * returned in the sorted results. Any computed data attached to the member should be
+     * allocated from the provided working set.
      *
      * Returns !OK on invalid member data.
      */
-    virtual StatusWith<double> computeDistance(WorkingSetMember* member) = 0;
+    virtual StatusWith<double> computeDistance(WorkingSet* workingSet,
+                                               WorkingSetMember* member) = 0;
 
     /*
      * Initialize near stage before buffering the data.
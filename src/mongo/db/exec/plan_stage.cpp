@@ -33,27 +33,124 @@
 #include "mongo/db/exec/plan_stage.h"
 
 #include "mongo/db/exec/scoped_timer.h"
+#include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/plan_yield_policy.h"
 #include "mongo/db/service_context.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 
 PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     invariant(_opCtx);
     ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
-    ++_commonStats.works;
 
     StageState workResult = doWork(out);
+    recordWork(workResult);
+
+    return workResult;
+}
+
+PlanStage::StageState PlanStage::workBatch(size_t maxWorks,
+                                           std::vector<WorkingSetID>* out,
+                                           WorkingSetID* stateId,
+                                           PlanYieldPolicy* yieldPolicy) {
+    invariant(_opCtx);
+    invariant(supportsBatchedWork());
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+
+    return doWorkBatch(maxWorks, out, stateId, yieldPolicy);
+}
+
+bool PlanStage::treeSupportsBatchedWork() const {
+    if (!supportsBatchedWork()) {
+        return false;
+    }
+
+    for (auto&& child : _children) {
+        if (!child->treeSupportsBatchedWork()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+PlanStage::StageState PlanStage::doWorkBatch(size_t maxWorks,
+                                             std::vector<WorkingSetID>* out,
+                                             WorkingSetID* stateId,
+                                             PlanYieldPolicy* yieldPolicy) {
+    const size_t numResultsBefore = out->size();
+    for (size_t i = 0; i < maxWorks; ++i) {
+        if (i > 0 && batchShouldYield(yieldPolicy)) {
+            break;
+        }
+
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState state = doWork(&id);
+        recordWork(state);
+
+        if (StageState::ADVANCED == state) {
+            out->push_back(id);
+        } else if (StageState::NEED_TIME != state) {
+            *stateId = id;
+            return state;
+        }
+    }
+
+    return out->size() > numResultsBefore ? StageState::ADVANCED : StageState::NEED_TIME;
+}
+
+bool PlanStage::batchShouldYield(PlanYieldPolicy* yieldPolicy) {
+    if (!yieldPolicy || !yieldPolicy->shouldYield()) {
+        return false;
+    }
 
-    if (StageState::ADVANCED == workResult) {
+    // shouldYield() has restarted the yield timer, so it would not say to yield again by the time
+    // the batch gets back to the PlanExecutor.
+    yieldPolicy->forceYield();
+    return true;
+}
+
+void PlanStage::recordWork(StageState state) {
+    ++_commonStats.works;
+
+    if (StageState::ADVANCED == state) {
         ++_commonStats.advanced;
-    } else if (StageState::NEED_TIME == workResult) {
+    } else if (StageState::NEED_TIME == state) {
         ++_commonStats.needTime;
-    } else if (StageState::NEED_YIELD == workResult) {
+    } else if (StageState::NEED_YIELD == state) {
         ++_commonStats.needYield;
     }
+}
 
-    return workResult;
+PlanStage::StageState PlanStage::finishBatchFromChild(StageState childState,
+                                                      bool producedResults,
+                                                      WorkingSet* ws,
+                                                      WorkingSetID* stateId) {
+    switch (childState) {
+        case StageState::ADVANCED:
+        case StageState::NEED_TIME:
+            // The child's batch ended because it ran out of works, not because of its state.
+            return producedResults ? StageState::ADVANCED : StageState::NEED_TIME;
+        case StageState::FAILURE:
+        case StageState::DEAD:
+            // If a stage fails, it may create a status WSM to indicate why it failed, in which
+            // case '*stateId' is valid. If it is invalid, we create our own error message.
+            if (WorkingSet::INVALID_ID == *stateId) {
+                Status status(ErrorCodes::InternalError,
+                              str::stream() << _commonStats.stageTypeStr
+                                            << " stage failed to read in results from child");
+                *stateId = WorkingSetCommon::allocateStatusMember(ws, status);
+            }
+            break;
+        case StageState::NEED_YIELD:
+        case StageState::IS_EOF:
+            break;
+    }
+
+    recordWork(childState);
+    return childState;
 }
 
 void PlanStage::saveState() {
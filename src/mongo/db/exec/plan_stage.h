@@ -40,6 +40,7 @@ namespace mongo {
 class ClockSource;
 class Collection;
 class OperationContext;
+class PlanYieldPolicy;
 class RecordId;
 
 /**
@@ -188,6 +189,39 @@ public:
      */
     StageState work(WorkingSetID* out);
 
+    /**
+     * Batched counterpart to work(). Performs up to 'maxWorks' units of work, appending the
+     * WorkingSetID of every result produced to 'out'.
+     *
+     * Stops early if the stage reaches a state other than ADVANCED or NEED_TIME, in which case
+     * that state is returned and '*stateId' is set as work() would set its out parameter for that
+     * state. Otherwise returns ADVANCED if any results were appended and NEED_TIME if not. The
+     * results appended to 'out' are valid whatever the return value. They stay valid across
+     * further calls to workBatch(), but the caller must be done with them before yielding.
+     *
+     * If 'yieldPolicy' is given, it is consulted after every unit of work but the last, and the
+     * batch ends early once it says to yield. The policy is then left forced to yield, so that
+     * the caller yields as soon as it has dealt with the batch.
+     *
+     * May only be called if supportsBatchedWork() is true.
+     */
+    StageState workBatch(size_t maxWorks,
+                         std::vector<WorkingSetID>* out,
+                         WorkingSetID* stateId,
+                         PlanYieldPolicy* yieldPolicy = nullptr);
+
+    /**
+     * Returns true if this stage implements workBatch().
+     */
+    virtual bool supportsBatchedWork() const {
+        return false;
+    }
+
+    /**
+     * Returns true if every stage in the tree rooted at this stage implements workBatch().
+     */
+    bool treeSupportsBatchedWork() const;
+
     /**
      * Returns true if no more work can be done on the query / out of results.
      */
@@ -324,6 +358,43 @@ protected:
      */
     virtual StageState doWork(WorkingSetID* out) = 0;
 
+    /**
+     * Performs a batch of work. See comment at workBatch() above.
+     *
+     * The default implementation calls doWork() repeatedly, which suits leaf stages whose results
+     * are not invalidated by producing the next one. Stages overriding this must call
+     * recordWork() for every unit of work they perform, check batchShouldYield() after each one
+     * but the last, and pass 'yieldPolicy' on to their child's batch.
+     */
+    virtual StageState doWorkBatch(size_t maxWorks,
+                                   std::vector<WorkingSetID>* out,
+                                   WorkingSetID* stateId,
+                                   PlanYieldPolicy* yieldPolicy);
+
+    /**
+     * Returns true if a batch should end early because 'yieldPolicy', which may be null, says it
+     * is time to yield. See workBatch().
+     */
+    static bool batchShouldYield(PlanYieldPolicy* yieldPolicy);
+
+    /**
+     * Updates the common stats for a single unit of work, performed by either work() or
+     * doWorkBatch(), that ended in 'state'.
+     */
+    void recordWork(StageState state);
+
+    /**
+     * Helper for doWorkBatch() implementations that transform their child's batch. Once the
+     * results of the child's batch have been handled, reports the state 'childState' that ended
+     * it, with '*stateId' as set by the child, as the state of this stage's batch. Mirrors what
+     * doWork() does with a non-ADVANCED child state, including allocating a status member in
+     * 'ws' for a failure that did not come with one.
+     */
+    StageState finishBatchFromChild(StageState childState,
+                                    bool producedResults,
+                                    WorkingSet* ws,
+                                    WorkingSetID* stateId);
+
     /**
      * Saves any stage-specific state required to resume where it was if the underlying data
      * changes.
@@ -508,7 +508,7 @@ struct ProjectionStats : public SpecificStats {
 };
 
 struct SortStats : public SpecificStats {
-    SortStats() : forcedFetches(0), memUsage(0), memLimit(0) {}
+    SortStats() : forcedFetches(0), memUsage(0), memLimit(0), usedDisk(false) {}
 
     SpecificStats* clone() const final {
         SortStats* specific = new SortStats(*this);
@@ -524,6 +524,9 @@ struct SortStats : public SpecificStats {
     // What's our memory limit?
     size_t memLimit;
 
+    // Did we run out of memory and spill the data to sort to disk?
+    bool usedDisk;
+
     // The number of results to return from the sort.
     size_t limit;
 
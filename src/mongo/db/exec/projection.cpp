@@ -227,6 +227,33 @@ PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState ProjectionStage::doWorkBatch(size_t maxWorks,
+                                                   std::vector<WorkingSetID>* out,
+                                                   WorkingSetID* stateId,
+                                                   PlanYieldPolicy* yieldPolicy) {
+    _childBatch.clear();
+    StageState childState = child()->workBatch(maxWorks, &_childBatch, stateId, yieldPolicy);
+
+    for (size_t i = 0; i < _childBatch.size(); ++i) {
+        const WorkingSetID id = _childBatch[i];
+        Status projStatus = transform(_ws->get(id));
+        if (!projStatus.isOK()) {
+            warning() << "Couldn't execute projection, status = " << redact(projStatus);
+            for (size_t j = i; j < _childBatch.size(); ++j) {
+                _ws->free(_childBatch[j]);
+            }
+            *stateId = WorkingSetCommon::allocateStatusMember(_ws, projStatus);
+            recordWork(PlanStage::FAILURE);
+            return PlanStage::FAILURE;
+        }
+
+        out->push_back(id);
+        recordWork(PlanStage::ADVANCED);
+    }
+
+    return finishBatchFromChild(childState, !_childBatch.empty(), _ws, stateId);
+}
+
 unique_ptr<PlanStageStats> ProjectionStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_PROJECTION);
@@ -88,6 +88,14 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateId,
+                           PlanYieldPolicy* yieldPolicy) final;
+
+    bool supportsBatchedWork() const final {
+        return true;
+    }
 
     StageType stageType() const final {
         return STAGE_PROJECTION;
@@ -150,6 +158,9 @@ private:
 
     // If the i-th entry of _includeKey is true this is the field name for the i-th key field.
     std::vector<StringData> _keyFieldNames;
+
+    // Holds the results of our child's batch while doWorkBatch() processes them.
+    std::vector<WorkingSetID> _childBatch;
 };
 
 }  // namespace mongo
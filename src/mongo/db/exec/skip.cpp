@@ -87,6 +87,30 @@ PlanStage::StageState SkipStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState SkipStage::doWorkBatch(size_t maxWorks,
+                                             std::vector<WorkingSetID>* out,
+                                             WorkingSetID* stateId,
+                                             PlanYieldPolicy* yieldPolicy) {
+    _childBatch.clear();
+    StageState childState = child()->workBatch(maxWorks, &_childBatch, stateId, yieldPolicy);
+
+    const size_t numResultsBefore = out->size();
+    for (auto&& id : _childBatch) {
+        // If we're still skipping results, drop the result.
+        if (_toSkip > 0) {
+            --_toSkip;
+            _ws->free(id);
+            recordWork(PlanStage::NEED_TIME);
+            continue;
+        }
+
+        out->push_back(id);
+        recordWork(PlanStage::ADVANCED);
+    }
+
+    return finishBatchFromChild(childState, out->size() > numResultsBefore, _ws, stateId);
+}
+
 unique_ptr<PlanStageStats> SkipStage::getStats() {
     _commonStats.isEOF = isEOF();
     _specificStats.skip = _toSkip;
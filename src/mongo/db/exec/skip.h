@@ -48,6 +48,14 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(size_t maxWorks,
+                           std::vector<WorkingSetID>* out,
+                           WorkingSetID* stateId,
+                           PlanYieldPolicy* yieldPolicy) final;
+
+    bool supportsBatchedWork() const final {
+        return true;
+    }
 
     StageType stageType() const final {
         return STAGE_SKIP;
@@ -65,6 +73,9 @@ private:
     // We drop the first _toSkip results that we would have returned.
     long long _toSkip;
 
+    // Holds the results of our child's batch while doWorkBatch() processes them.
+    std::vector<WorkingSetID> _childBatch;
+
     // Stats
     SkipStats _specificStats;
 };
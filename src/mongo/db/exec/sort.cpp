@@ -41,6 +41,8 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
@@ -67,6 +69,94 @@ bool SortStage::WorkingSetComparator::operator()(const SortableDataItem& lhs,
     return lhs.recordId < rhs.recordId;
 }
 
+/**
+ * Sorts the input of a SortStage which has run out of memory, using the external Sorter.
+ */
+class SortStage::Spiller {
+public:
+    /**
+     * The sort key of a document together with the RecordId which breaks ties between equal sort
+     * keys, in a form the Sorter can write to disk.
+     */
+    struct Key {
+        struct SorterDeserializeSettings {};
+
+        void serializeForSorter(BufBuilder& buf) const {
+            sortKey.serializeForSorter(buf);
+            recordId.serializeForSorter(buf);
+        }
+
+        static Key deserializeForSorter(BufReader& buf, const SorterDeserializeSettings&) {
+            Key key;
+            key.sortKey = BSONObj::deserializeForSorter(buf, BSONObj::SorterDeserializeSettings());
+            key.recordId =
+                RecordId::deserializeForSorter(buf, RecordId::SorterDeserializeSettings());
+            return key;
+        }
+
+        int memUsageForSorter() const {
+            return sizeof(Key) + sortKey.objsize();
+        }
+
+        Key getOwned() const {
+            return {sortKey.getOwned(), recordId};
+        }
+
+        BSONObj sortKey;
+        RecordId recordId;
+    };
+
+    typedef Sorter<Key, BSONObj> MySorter;
+
+    Spiller(const SortOptions& opts, const BSONObj& pattern)
+        : _sorter(MySorter::make(opts, Comparator(pattern))) {}
+
+    void add(const BSONObj& sortKey, const RecordId& recordId, const BSONObj& obj) {
+        _sorter->add({sortKey, recordId}, obj);
+    }
+
+    /**
+     * Called once all the input has been added. Starts returning the sorted results.
+     */
+    void done() {
+        _output.reset(_sorter->done());
+        _sorter.reset();
+    }
+
+    bool more() {
+        return _output && _output->more();
+    }
+
+    /**
+     * The returned key and document are only valid until the next call to next().
+     */
+    MySorter::Data next() {
+        return _output->next();
+    }
+
+private:
+    // Orders items the same way as WorkingSetComparator.
+    class Comparator {
+    public:
+        explicit Comparator(const BSONObj& pattern) : _pattern(pattern) {}
+
+        int operator()(const MySorter::Data& lhs, const MySorter::Data& rhs) const {
+            // False means ignore field names.
+            int result = lhs.first.sortKey.woCompare(rhs.first.sortKey, _pattern, false);
+            if (0 != result) {
+                return result;
+            }
+            return lhs.first.recordId.compare(rhs.first.recordId);
+        }
+
+    private:
+        BSONObj _pattern;
+    };
+
+    std::unique_ptr<MySorter> _sorter;
+    std::unique_ptr<MySorter::Iterator> _output;
+};
+
 SortStage::SortStage(OperationContext* opCtx,
                      const SortStageParams& params,
                      WorkingSet* ws,
@@ -76,6 +166,7 @@ SortStage::SortStage(OperationContext* opCtx,
       _ws(ws),
       _pattern(params.pattern),
       _limit(params.limit),
+      _allowDiskUse(params.allowDiskUse),
       _sorted(false),
       _resultIterator(_data.end()),
       _memUsage(0) {
@@ -97,12 +188,13 @@ SortStage::~SortStage() {}
 bool SortStage::isEOF() {
     // We're done when our child has no more results, we've sorted the child's results, and
     // we've returned all sorted results.
-    return child()->isEOF() && _sorted && (_data.end() == _resultIterator);
+    return child()->isEOF() && _sorted &&
+        (_spiller ? !_spiller->more() : _data.end() == _resultIterator);
 }
 
 PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes);
-    if (_memUsage > maxBytes) {
+    if (_memUsage > maxBytes && !_spiller) {
         mongoutils::str::stream ss;
         ss << "Sort operation used more than the maximum " << maxBytes
            << " bytes of RAM. Add an index, or specify a smaller limit.";
@@ -130,7 +222,7 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
             verify(member->hasObj());
 
             // We might be sorting something that was invalidated at some point.
-            if (member->hasRecordId()) {
+            if (member->hasRecordId() && !_spiller) {
                 _wsidByRecordId[member->recordId] = id;
             }
 
@@ -148,14 +240,26 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
                 item.recordId = member->recordId;
             }
 
+            if (_spiller) {
+                addToSpiller(item);
+                return PlanStage::NEED_TIME;
+            }
+
             addToBuffer(item);
+            if (_memUsage > maxBytes && _allowDiskUse) {
+                spill();
+            }
 
             return PlanStage::NEED_TIME;
         } else if (PlanStage::IS_EOF == code) {
             // TODO: We don't need the lock for this.  We could ask for a yield and do this work
             // unlocked.  Also, this is performing a lot of work for one call to work(...)
-            sortBuffer();
-            _resultIterator = _data.begin();
+            if (_spiller) {
+                _spiller->done();
+            } else {
+                sortBuffer();
+                _resultIterator = _data.begin();
+            }
             _sorted = true;
             return PlanStage::NEED_TIME;
         } else if (PlanStage::FAILURE == code || PlanStage::DEAD == code) {
@@ -178,6 +282,23 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
     }
 
     // Returning results.
+    if (_spiller) {
+        // The sorted data now lives outside of the working set, so each result is copied into a new
+        // working set member.
+        auto result = _spiller->next();
+        *out = _ws->allocate();
+        WorkingSetMember* member = _ws->get(*out);
+        member->obj = Snapshotted<BSONObj>(SnapshotId(), result.second.getOwned());
+        member->addComputed(new SortKeyComputedData(result.first.sortKey));
+        if (result.first.recordId.isNull()) {
+            _ws->transitionToOwnedObj(*out);
+        } else {
+            member->recordId = result.first.recordId;
+            _ws->transitionToRecordIdAndObj(*out);
+        }
+        return PlanStage::ADVANCED;
+    }
+
     verify(_resultIterator != _data.end());
     verify(_sorted);
     *out = _resultIterator->wsid;
@@ -222,6 +343,7 @@ unique_ptr<PlanStageStats> SortStage::getStats() {
     const size_t maxBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes);
     _specificStats.memLimit = maxBytes;
     _specificStats.memUsage = _memUsage;
+    _specificStats.usedDisk = bool(_spiller);
     _specificStats.limit = _limit;
     _specificStats.sortPattern = _pattern.getOwned();
 
@@ -323,6 +445,39 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
     }
 }
 
+void SortStage::spill() {
+    SortOptions opts;
+    opts.limit = _limit;
+    opts.maxMemoryUsageBytes = static_cast<size_t>(internalQueryExecMaxBlockingSortBytes);
+    opts.extSortAllowed = true;
+    opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+    _spiller = stdx::make_unique<Spiller>(opts, _sortKeyComparator->pattern);
+
+    if (_dataSet) {
+        for (auto&& item : *_dataSet) {
+            addToSpiller(item);
+        }
+        _dataSet.reset();
+    }
+    for (auto&& item : _data) {
+        addToSpiller(item);
+    }
+    _data.clear();
+    _resultIterator = _data.end();
+}
+
+void SortStage::addToSpiller(const SortableDataItem& item) {
+    WorkingSetMember* member = _ws->get(item.wsid);
+    if (member->hasRecordId()) {
+        _spiller->add(item.sortKey, item.recordId, member->obj.value());
+        _wsidByRecordId.erase(member->recordId);
+    } else {
+        // The document was invalidated, so only a copy of it is returned.
+        _spiller->add(item.sortKey, RecordId(), member->obj.value());
+    }
+    _ws->free(item.wsid);
+}
+
 void SortStage::sortBuffer() {
     if (_limit == 0) {
         const WorkingSetComparator& cmp = *_sortKeyComparator;
@@ -341,3 +496,6 @@ void SortStage::sortBuffer() {
 }
 
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
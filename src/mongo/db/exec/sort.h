@@ -46,7 +46,7 @@ class BtreeKeyGenerator;
 // Parameters that must be provided to a SortStage
 class SortStageParams {
 public:
-    SortStageParams() : collection(NULL), limit(0) {}
+    SortStageParams() : collection(NULL), limit(0), allowDiskUse(false) {}
 
     // Used for resolving RecordIds to BSON
     const Collection* collection;
@@ -56,11 +56,18 @@ public:
 
     // Equal to 0 for no limit.
     size_t limit;
+
+    // If true, the data to sort is spilled to disk once it uses more memory than
+    // internalQueryExecMaxBlockingSortBytes. Otherwise the sort fails at that point.
+    bool allowDiskUse;
 };
 
 /**
  * Sorts the input received from the child according to the sort pattern provided.
  *
+ * If allowed to use disk, the stage hands its buffered data to an external Sorter once it runs out
+ * of memory. The documents it returns afterwards are owned copies read back from that Sorter.
+ *
  * Preconditions:
  *   -- For each field in 'pattern', all inputs in the child must handle a getFieldDotted for that
  *   field.
@@ -106,6 +113,8 @@ private:
     // Equal to 0 for no limit.
     size_t _limit;
 
+    bool _allowDiskUse;
+
     //
     // Data storage
     //
@@ -152,6 +161,16 @@ private:
      */
     void sortBuffer();
 
+    /**
+     * Moves all buffered data to '_spiller', which takes over sorting the rest of the input.
+     */
+    void spill();
+
+    /**
+     * Hands one item to '_spiller' and frees its working set member.
+     */
+    void addToSpiller(const SortableDataItem& item);
+
     // Comparator for data buffer
     // Initialization follows sort key generator
     std::unique_ptr<WorkingSetComparator> _sortKeyComparator;
@@ -170,6 +189,12 @@ private:
     // Iterates through _data post-sort returning it.
     std::vector<SortableDataItem>::iterator _resultIterator;
 
+    // Wraps the external Sorter used once the buffered data outgrows the memory limit. Once this is
+    // set, all remaining input goes to it rather than to the buffers above, and the results are
+    // read back from it.
+    class Spiller;
+    std::unique_ptr<Spiller> _spiller;
+
     // We buffer a lot of data and we want to look it up by RecordId quickly upon invalidation.
     typedef unordered_map<RecordId, WorkingSetID, RecordId::Hasher> DataMap;
     DataMap _wsidByRecordId;
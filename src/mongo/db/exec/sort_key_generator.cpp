@@ -332,7 +332,7 @@ PlanStage::StageState SortKeyGeneratorStage::doWork(WorkingSetID* out) {
         }
 
         // Add the sort key to the WSM as computed data.
-        member->addComputed(new SortKeyComputedData(sortKey));
+        member->addComputed(_ws->makeComputed<SortKeyComputedData>(sortKey));
 
         return PlanStage::ADVANCED;
     }
@@ -28,6 +28,9 @@
 
 #include "mongo/db/exec/working_set.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/service_context.h"
@@ -39,15 +42,114 @@ using std::string;
 
 namespace dps = ::mongo::dotted_path_support;
 
+namespace {
+
+// Every block handed out by WorkingSetComputedDataArena is preceded by a header recording its size
+// class, so that blocks can be returned without the caller knowing the dynamic type's size. The
+// header is padded to the block granularity to keep the payload aligned.
+union BlockHeader {
+    size_t sizeClass;
+    char padding[WorkingSetComputedDataArena::kBlockGranularity];
+};
+
+// Marks a block that was too large to pool and came straight from the heap.
+const size_t kUnpooledSizeClass = size_t(-1);
+
+}  // namespace
+
+//
+// WorkingSetComputedDataArena
+//
+
+WorkingSetComputedDataArena::WorkingSetComputedDataArena() {
+    std::fill(std::begin(_freeLists), std::end(_freeLists), nullptr);
+}
+
+WorkingSetComputedDataArena::~WorkingSetComputedDataArena() {}
+
+void* WorkingSetComputedDataArena::allocate(size_t bytes) {
+    if (bytes > kMaxPooledSize) {
+        void* mem = ::operator new(sizeof(BlockHeader) + bytes);
+        BlockHeader* header = static_cast<BlockHeader*>(mem);
+        header->sizeClass = kUnpooledSizeClass;
+        return header + 1;
+    }
+
+    const size_t sizeClass = (bytes == 0 ? 0 : (bytes - 1) / kBlockGranularity);
+    BlockHeader* header;
+    if (_freeLists[sizeClass]) {
+        // Reuse a block released by an earlier member. The first word of the payload holds the
+        // next link of the free list.
+        void* payload = _freeLists[sizeClass];
+        _freeLists[sizeClass] = *static_cast<void**>(payload);
+        header = static_cast<BlockHeader*>(payload) - 1;
+    } else {
+        const size_t blockBytes = sizeof(BlockHeader) + (sizeClass + 1) * kBlockGranularity;
+        if (static_cast<size_t>(_slabEnd - _slabNext) < blockBytes) {
+            // Whatever is left of the current slab is abandoned; it is smaller than one block.
+            _slabs.emplace_back(new char[kSlabSize]);
+            _slabNext = _slabs.back().get();
+            _slabEnd = _slabNext + kSlabSize;
+        }
+        header = reinterpret_cast<BlockHeader*>(_slabNext);
+        _slabNext += blockBytes;
+    }
+
+    header->sizeClass = sizeClass;
+    return header + 1;
+}
+
+void WorkingSetComputedDataArena::deallocate(void* ptr) {
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    if (header->sizeClass == kUnpooledSizeClass) {
+        ::operator delete(header);
+        return;
+    }
+
+    dassert(header->sizeClass < kNumSizeClasses);
+    *static_cast<void**>(ptr) = _freeLists[header->sizeClass];
+    _freeLists[header->sizeClass] = ptr;
+}
+
+void WorkingSetComputedDataArena::destroy(WorkingSetComputedData* data) {
+    // The block starts at the most-derived object, which need not be where the base subobject is.
+    void* block = dynamic_cast<void*>(data);
+    data->~WorkingSetComputedData();
+    deallocate(block);
+}
+
+void WorkingSetComputedDataDeleter::operator()(WorkingSetComputedData* data) const {
+    if (_arena) {
+        _arena->destroy(data);
+    } else {
+        delete data;
+    }
+}
+
+//
+// WorkingSet
+//
+
+const size_t WorkingSet::kMinMemberSlabSize;
+const size_t WorkingSet::kMaxMemberSlabSize;
+
 WorkingSet::MemberHolder::MemberHolder() : member(NULL) {}
 WorkingSet::MemberHolder::~MemberHolder() {}
 
 WorkingSet::WorkingSet() : _freeList(INVALID_ID) {}
 
-WorkingSet::~WorkingSet() {
-    for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
+WorkingSet::~WorkingSet() {}
+
+WorkingSetMember* WorkingSet::nextMemberFromSlab() {
+    if (_lastSlabUsed == _lastSlabSize) {
+        // Grow geometrically so that small queries stay small while large ones quickly reach
+        // slabs big enough to make the per-slab allocation negligible.
+        _lastSlabSize = _memberSlabs.empty() ? kMinMemberSlabSize
+                                             : std::min(_lastSlabSize * 2, kMaxMemberSlabSize);
+        _memberSlabs.emplace_back(new WorkingSetMember[_lastSlabSize]);
+        _lastSlabUsed = 0;
     }
+    return &_memberSlabs.back()[_lastSlabUsed++];
 }
 
 WorkingSetID WorkingSet::allocate() {
@@ -58,7 +160,7 @@ WorkingSetID WorkingSet::allocate() {
         WorkingSetID id = _data.size();
         _data.resize(_data.size() + 1);
         _data.back().nextFreeOrSelf = id;
-        _data.back().member = new WorkingSetMember();
+        _data.back().member = nextMemberFromSlab();
         return id;
     }
 
@@ -96,10 +198,10 @@ bool WorkingSet::isFlagged(WorkingSetID id) const {
 }
 
 void WorkingSet::clear() {
-    for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
-    }
     _data.clear();
+    _memberSlabs.clear();
+    _lastSlabUsed = 0;
+    _lastSlabSize = 0;
 
     // Since working set is now empty, the free list pointer should
     // point to nothing.
@@ -190,7 +292,14 @@ const WorkingSetComputedData* WorkingSetMember::getComputed(
 
 void WorkingSetMember::addComputed(WorkingSetComputedData* data) {
     verify(!hasComputed(data->type()));
-    _computed[data->type()].reset(data);
+    // Not reset(), which would keep whatever deleter the slot last held.
+    _computed[data->type()] = WorkingSetComputedDataPtr(data);
+}
+
+void WorkingSetMember::addComputed(WorkingSetComputedDataPtr data) {
+    verify(!hasComputed(data->type()));
+    const WorkingSetComputedDataType type = data->type();
+    _computed[type] = std::move(data);
 }
 
 void WorkingSetMember::setFetcher(RecordFetcher* fetcher) {
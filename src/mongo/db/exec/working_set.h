@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <memory>
+#include <new>
+#include <utility>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
@@ -41,10 +44,97 @@ namespace mongo {
 
 class IndexAccessMethod;
 class RecordFetcher;
+class WorkingSetComputedData;
 class WorkingSetMember;
 
 typedef size_t WorkingSetID;
 
+/**
+ * Operation-scoped storage for WorkingSetComputedData. Blocks are carved out of large slabs and
+ * recycled through per-size free lists when a member drops its computed data, so the sort keys,
+ * text scores and geo distances attached to every document do not each cost a trip through the
+ * global allocator. All slabs are released together when the arena is destroyed.
+ *
+ * Not thread-safe; owned and used by a single WorkingSet.
+ */
+class WorkingSetComputedDataArena {
+    MONGO_DISALLOW_COPYING(WorkingSetComputedDataArena);
+
+public:
+    // Bytes of slab memory requested from the heap at a time.
+    static const size_t kSlabSize = 16 * 1024;
+
+    // Allocations are rounded up to a multiple of this. Also the alignment of each block.
+    static const size_t kBlockGranularity = 16;
+
+    // Objects larger than this are not worth pooling and go straight to the heap.
+    static const size_t kMaxPooledSize = 256;
+
+    WorkingSetComputedDataArena();
+    ~WorkingSetComputedDataArena();
+
+    /**
+     * Constructs a T in arena memory. The result must be released with destroy().
+     */
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        void* mem = allocate(sizeof(T));
+        try {
+            return new (mem) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(mem);
+            throw;
+        }
+    }
+
+    /**
+     * Runs the destructor of 'data', which must have come from make() on this arena, and returns
+     * its block to the free list for reuse.
+     */
+    void destroy(WorkingSetComputedData* data);
+
+    /**
+     * Returns the number of bytes of slab memory currently held by this arena.
+     */
+    size_t bytesReserved() const {
+        return _slabs.size() * kSlabSize;
+    }
+
+private:
+    static const size_t kNumSizeClasses = kMaxPooledSize / kBlockGranularity;
+
+    void* allocate(size_t bytes);
+    void deallocate(void* ptr);
+
+    std::vector<std::unique_ptr<char[]>> _slabs;
+
+    // Unused tail of the most recently allocated slab.
+    char* _slabNext = nullptr;
+    char* _slabEnd = nullptr;
+
+    // Heads of the intrusive singly-linked free lists, indexed by size class. Size class 'c' holds
+    // blocks of (c + 1) * kBlockGranularity bytes.
+    void* _freeLists[kNumSizeClasses];
+};
+
+/**
+ * Deleter for computed data held by a WorkingSetMember. Data allocated from a
+ * WorkingSetComputedDataArena is handed back to it; anything else was allocated with plain 'new'.
+ */
+class WorkingSetComputedDataDeleter {
+public:
+    WorkingSetComputedDataDeleter() = default;
+    explicit WorkingSetComputedDataDeleter(WorkingSetComputedDataArena* arena) : _arena(arena) {}
+
+    void operator()(WorkingSetComputedData* data) const;
+
+private:
+    WorkingSetComputedDataArena* _arena = nullptr;
+};
+
+using WorkingSetComputedDataPtr =
+    std::unique_ptr<WorkingSetComputedData, WorkingSetComputedDataDeleter>;
+
 /**
  * All data in use by a query.  Data is passed through the stage tree by referencing the ID of
  * an element of the working set.  Stages can add elements to the working set, delete elements
@@ -139,7 +229,22 @@ public:
      */
     std::vector<WorkingSetID> getAndClearYieldSensitiveIds();
 
+    /**
+     * Constructs computed data of type T from this working set's arena. The result is released
+     * back to the arena when the member it is added to is freed, so it must only be attached to
+     * members of this working set.
+     */
+    template <typename T, typename... Args>
+    WorkingSetComputedDataPtr makeComputed(Args&&... args) {
+        return WorkingSetComputedDataPtr(_computedArena.make<T>(std::forward<Args>(args)...),
+                                         WorkingSetComputedDataDeleter(&_computedArena));
+    }
+
 private:
+    // Members are allocated in slabs that start at this size and double up to the maximum.
+    static const size_t kMinMemberSlabSize = 16;
+    static const size_t kMaxMemberSlabSize = 1024;
+
     struct MemberHolder {
         MemberHolder();
         ~MemberHolder();
@@ -147,10 +252,29 @@ private:
         // Free list link if freed. Points to self if in use.
         WorkingSetID nextFreeOrSelf;
 
-        // Owning pointer
+        // Points into one of '_memberSlabs'.
         WorkingSetMember* member;
     };
 
+    /**
+     * Returns a pointer to an unused member from the current slab, allocating a new slab first if
+     * the current one is exhausted.
+     */
+    WorkingSetMember* nextMemberFromSlab();
+
+    // Must be declared before the member slabs so that it outlives any computed data the members
+    // still hold when the working set is destroyed.
+    WorkingSetComputedDataArena _computedArena;
+
+    // Storage for all members. Members are never returned to the heap individually; they are
+    // recycled through '_freeList' and released together with their slab in clear() or the
+    // destructor.
+    std::vector<std::unique_ptr<WorkingSetMember[]>> _memberSlabs;
+
+    // Number of members of the last slab in '_memberSlabs' that have been handed out.
+    size_t _lastSlabUsed = 0;
+    size_t _lastSlabSize = 0;
+
     // All WorkingSetIDs are indexes into this, except for INVALID_ID.
     // Elements are added to _freeList rather than removed when freed.
     std::vector<MemberHolder> _data;
@@ -304,8 +428,17 @@ public:
 
     bool hasComputed(const WorkingSetComputedDataType type) const;
     const WorkingSetComputedData* getComputed(const WorkingSetComputedDataType type) const;
+
+    /**
+     * Takes ownership of 'data', which must have been allocated with 'new'.
+     */
     void addComputed(WorkingSetComputedData* data);
 
+    /**
+     * Takes ownership of 'data', typically obtained from WorkingSet::makeComputed().
+     */
+    void addComputed(WorkingSetComputedDataPtr data);
+
     //
     // Fetching
     //
@@ -336,7 +469,7 @@ private:
 
     MemberState _state = WorkingSetMember::INVALID;
 
-    std::unique_ptr<WorkingSetComputedData> _computed[WSM_COMPUTED_NUM_TYPES];
+    WorkingSetComputedDataPtr _computed[WSM_COMPUTED_NUM_TYPES];
 
     std::unique_ptr<RecordFetcher> _fetcher;
 };
@@ -100,10 +100,23 @@ bool WorkingSetCommon::fetch(OperationContext* txn,
     invariant(member->hasRecordId());
 
     member->obj.reset();
-    auto record = cursor->seekExact(member->recordId);
+    return fetch(txn, workingSet, id, cursor->seekExact(member->recordId));
+}
+
+// static
+bool WorkingSetCommon::fetch(OperationContext* txn,
+                             WorkingSet* workingSet,
+                             WorkingSetID id,
+                             boost::optional<Record> record) {
+    WorkingSetMember* member = workingSet->get(id);
+    invariant(!member->hasFetcher());
+    invariant(member->hasRecordId());
+
+    member->obj.reset();
     if (!record) {
         return false;
     }
+    dassert(record->id == member->recordId);
 
     member->obj = {txn->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
 
@@ -28,7 +28,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/working_set.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/util/unowned_ptr.h"
 
 namespace mongo {
@@ -75,6 +78,16 @@ public:
                       WorkingSetID id,
                       unowned_ptr<SeekableRecordCursor> cursor);
 
+    /**
+     * As above, but uses 'record', which the caller has already looked up for the member's
+     * RecordId in the current snapshot, instead of seeking a cursor. boost::none means that no
+     * such record exists.
+     */
+    static bool fetch(OperationContext* txn,
+                      WorkingSet* workingSet,
+                      WorkingSetID id,
+                      boost::optional<Record> record);
+
     static bool fetchIfUnfetched(OperationContext* txn,
                                  WorkingSet* workingSet,
                                  WorkingSetID id,
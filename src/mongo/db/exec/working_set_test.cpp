@@ -32,6 +32,7 @@
 
 
 #include "mongo/db/exec/working_set.h"
+#include "mongo/db/exec/working_set_computed_data.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
 #include "mongo/db/storage/snapshot.h"
@@ -154,4 +155,66 @@ TEST_F(WorkingSetFixture, getDottedFieldFromIndex) {
     ASSERT_FALSE(member->getFieldDotted("y", &elt));
 }
 
+TEST_F(WorkingSetFixture, MembersStayPutAcrossSlabGrowth) {
+    // Allocate enough members to span several slabs and make sure earlier members are not moved
+    // or disturbed as later slabs are added.
+    std::vector<WorkingSetID> ids;
+    std::vector<WorkingSetMember*> members;
+    for (int i = 0; i < 5000; ++i) {
+        WorkingSetID newId = ws->allocate();
+        WorkingSetMember* newMember = ws->get(newId);
+        newMember->obj = {SnapshotId(), BSON("i" << i)};
+        ws->transitionToOwnedObj(newId);
+        ids.push_back(newId);
+        members.push_back(newMember);
+    }
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_EQUALS(members[i], ws->get(ids[i]));
+        ASSERT_EQUALS(static_cast<int>(i), members[i]->obj.value()["i"].numberInt());
+    }
+
+    // Freed members are handed out again before any new storage is used.
+    ws->free(ids[10]);
+    WorkingSetID reused = ws->allocate();
+    ASSERT_EQUALS(ids[10], reused);
+    ASSERT_EQUALS(members[10], ws->get(reused));
+    ASSERT_EQUALS(WorkingSetMember::INVALID, ws->get(reused)->getState());
+
+    ws->clear();
+    WorkingSetID afterClear = ws->allocate();
+    ASSERT_EQUALS(0U, afterClear);
+    ASSERT_EQUALS(WorkingSetMember::INVALID, ws->get(afterClear)->getState());
+}
+
+TEST_F(WorkingSetFixture, ComputedDataFromArenaIsRecycled) {
+    member->addComputed(ws->makeComputed<TextScoreComputedData>(1.5));
+    const WorkingSetComputedData* firstScore = member->getComputed(WSM_COMPUTED_TEXT_SCORE);
+    ASSERT_EQUALS(1.5, static_cast<const TextScoreComputedData*>(firstScore)->getScore());
+
+    // Freeing the member returns its computed data to the arena, and the next allocation of the
+    // same size reuses the block.
+    ws->free(id);
+    ASSERT_FALSE(member->hasComputed(WSM_COMPUTED_TEXT_SCORE));
+    id = ws->allocate();
+    member = ws->get(id);
+    member->addComputed(ws->makeComputed<TextScoreComputedData>(2.5));
+    ASSERT_EQUALS(firstScore, member->getComputed(WSM_COMPUTED_TEXT_SCORE));
+    ASSERT_EQUALS(2.5,
+                  static_cast<const TextScoreComputedData*>(
+                      member->getComputed(WSM_COMPUTED_TEXT_SCORE))->getScore());
+}
+
+TEST_F(WorkingSetFixture, HeapAndArenaComputedDataCanShareASlot) {
+    // A slot that last held arena data must release heap data with 'delete', and vice versa.
+    member->addComputed(ws->makeComputed<TextScoreComputedData>(1.0));
+    member->clear();
+    member->addComputed(new TextScoreComputedData(2.0));
+    member->clear();
+    member->addComputed(ws->makeComputed<TextScoreComputedData>(3.0));
+    ASSERT_EQUALS(3.0,
+                  static_cast<const TextScoreComputedData*>(
+                      member->getComputed(WSM_COMPUTED_TEXT_SCORE))->getScore());
+}
+
 }  // namespace
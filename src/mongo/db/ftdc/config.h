@@ -46,7 +46,9 @@ struct FTDCConfig {
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault),
+          highResolutionEnabled(kHighResolutionEnabledDefault),
+          highResolutionPeriod(kHighResolutionPeriodMillisDefault) {}
 
     /**
      * True if FTDC is collecting data. False otherwise
@@ -83,11 +85,30 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * True if the high resolution collectors are sampled as well. Only takes effect while FTDC is
+     * enabled.
+     */
+    bool highResolutionEnabled;
+
+    /**
+     * Period at which to sample the high resolution collectors. Their samples are stored in a
+     * subdirectory of the FTDC directory, in the same file format.
+     *
+     * While high resolution collection is enabled, the subdirectory gets
+     * 1/kHighResolutionDirectorySizeDivisor of maxDirectorySizeBytes and the periodic files get
+     * the rest.
+     */
+    Milliseconds highResolutionPeriod;
+
     static const bool kEnabledDefault = true;
+    static const bool kHighResolutionEnabledDefault = false;
 
     static const std::int64_t kPeriodMillisDefault;
+    static const std::int64_t kHighResolutionPeriodMillisDefault;
     static const std::uint64_t kMaxDirectorySizeBytesDefault = 200 * 1024 * 1024;
     static const std::uint64_t kMaxFileSizeBytesDefault = 10 * 1024 * 1024;
+    static const std::uint64_t kHighResolutionDirectorySizeDivisor = 4;
 
     static const std::uint64_t kMaxFileUniqifier = 65000;
 
@@ -31,6 +31,8 @@ namespace mongo {
 extern const char kFTDCInterimFile[];
 extern const char kFTDCArchiveFile[];
 
+extern const char kFTDCHighResolutionDirectory[];
+
 extern const char kFTDCIdField[];
 extern const char kFTDCTypeField[];
 
@@ -34,6 +34,7 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/stdx/condition_variable.h"
@@ -46,6 +47,34 @@
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Returns the settings the periodic or, if 'highResolution' is true, the high resolution file
+ * manager should use. While high resolution collection is enabled, the two share the directory
+ * size budget so that they stay within it together.
+ */
+FTDCConfig configForFiles(const FTDCConfig& config,
+                          bool hasHighResolutionCollectors,
+                          bool highResolution) {
+    FTDCConfig result = config;
+    if (!hasHighResolutionCollectors || !config.highResolutionEnabled) {
+        return result;
+    }
+
+    const std::uint64_t highResolutionBytes =
+        config.maxDirectorySizeBytes / FTDCConfig::kHighResolutionDirectorySizeDivisor;
+    if (highResolution) {
+        result.maxDirectorySizeBytes = highResolutionBytes;
+    } else {
+        result.maxDirectorySizeBytes -= highResolutionBytes;
+    }
+
+    return result;
+}
+
+}  // namespace
+
 void FTDCController::setEnabled(bool enabled) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.enabled = enabled;
@@ -54,31 +83,43 @@ void FTDCController::setEnabled(bool enabled) {
 void FTDCController::setPeriod(Milliseconds millis) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.period = millis;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxFileSizeBytes(std::uint64_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxFileSizeBytes = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxSamplesPerArchiveMetricChunk(size_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxSamplesPerArchiveMetricChunk = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxSamplesPerInterimMetricChunk = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
+}
+
+void FTDCController::setHighResolutionEnabled(bool enabled) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _configTemp.highResolutionEnabled = enabled;
+    _condvar.notify_all();
+}
+
+void FTDCController::setHighResolutionPeriod(Milliseconds millis) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _configTemp.highResolutionPeriod = millis;
+    _condvar.notify_all();
 }
 
 void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
@@ -99,6 +140,16 @@ void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addHighResolutionCollector(
+    std::unique_ptr<FTDCCollectorInterface> collector) {
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        _highResolutionCollectors.add(std::move(collector));
+    }
+}
+
 BSONObj FTDCController::getMostRecentPeriodicDocument() {
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
@@ -113,6 +164,11 @@ void FTDCController::start() {
     // Start the thread
     _thread = stdx::thread(stdx::bind(&FTDCController::doLoop, this));
 
+    if (!_highResolutionCollectors.empty()) {
+        _highResolutionThread =
+            stdx::thread(stdx::bind(&FTDCController::doHighResolutionLoop, this));
+    }
+
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
 
@@ -140,11 +196,15 @@ void FTDCController::stop() {
         _state = State::kStopRequested;
 
         // Wake up the thread if sleeping so that it will check if we are done
-        _condvar.notify_one();
+        _condvar.notify_all();
     }
 
     _thread.join();
 
+    if (_highResolutionThread.joinable()) {
+        _highResolutionThread.join();
+    }
+
     _state = State::kDone;
 
     if (_mgr) {
@@ -153,6 +213,14 @@ void FTDCController::stop() {
             log() << "Failed to close full-time diagnostic data capture file manager: " << s;
         }
     }
+
+    if (_highResolutionMgr) {
+        auto s = _highResolutionMgr->close();
+        if (!s.isOK()) {
+            log() << "Failed to close high resolution diagnostic data capture file manager: "
+                  << s;
+        }
+    }
 }
 
 void FTDCController::doLoop() {
@@ -160,7 +228,7 @@ void FTDCController::doLoop() {
         // Update config
         {
             stdx::lock_guard<stdx::mutex> lock(_mutex);
-            _config = _configTemp;
+            _config = configForFiles(_configTemp, !_highResolutionCollectors.empty(), false);
         }
 
         Client::initThread("ftdc");
@@ -191,7 +259,7 @@ void FTDCController::doLoop() {
                 // MSVC 2013 converts wait_until(now() + 1ms) into ~ wait_for(0) which means it will
                 // not wait for the condition variable to be signaled because it uses
                 // GetFileSystemTime for now which has ~10 ms granularity.
-                _config = _configTemp;
+                _config = configForFiles(_configTemp, !_highResolutionCollectors.empty(), false);
 
                 // if we hit a timeout on the condvar, we need to do another collection
                 // if we were signalled, then we have a config update only or were asked to stop
@@ -233,4 +301,66 @@ void FTDCController::doLoop() {
     }
 }
 
+void FTDCController::doHighResolutionLoop() {
+    try {
+        Client::initThread("ftdc-highres");
+        Client* client = &cc();
+
+        while (true) {
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+
+                if (_state == State::kStopRequested) {
+                    break;
+                }
+
+                _highResolutionConfig = configForFiles(_configTemp, true, true);
+                const FTDCConfig& config = _highResolutionConfig;
+
+                // Sleep until the configuration changes while there is nothing to collect
+                if (!config.enabled || !config.highResolutionEnabled) {
+                    _condvar.wait(lock);
+                    continue;
+                }
+
+                auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
+                auto next_time = FTDCUtil::roundTime(now, config.highResolutionPeriod);
+
+                // As in doLoop(), a signal means a config update or a request to stop, so start
+                // over rather than collecting
+                auto status = _condvar.wait_until(lock, next_time.toSystemTimePoint());
+                if (status == stdx::cv_status::no_timeout) {
+                    continue;
+                }
+
+                if (_state == State::kStopRequested) {
+                    break;
+                }
+            }
+
+            // Delay initialization of FTDCFileManager until we are sure the user has enabled
+            // high resolution collection
+            if (!_highResolutionMgr) {
+                auto swMgr = FTDCFileManager::create(&_highResolutionConfig,
+                                                     _path / kFTDCHighResolutionDirectory,
+                                                     &_highResolutionRotateCollectors,
+                                                     client);
+
+                _highResolutionMgr = uassertStatusOK(std::move(swMgr));
+            }
+
+            auto collectSample = _highResolutionCollectors.collect(client);
+
+            Status s = _highResolutionMgr->writeSampleAndRotateIfNeeded(
+                client, std::get<0>(collectSample), std::get<1>(collectSample));
+
+            uassertStatusOK(s);
+        }
+    } catch (...) {
+        warning() << "Uncaught exception in '" << exceptionToStatus()
+                  << "' in high resolution diagnostic data capture. Shutting down high resolution "
+                     "diagnostic data capture.";
+    }
+}
+
 }  // namespace mongo
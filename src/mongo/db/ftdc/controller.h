@@ -56,7 +56,10 @@ class FTDCController {
 
 public:
     FTDCController(const boost::filesystem::path path, FTDCConfig config)
-        : _path(path), _config(std::move(config)), _configTemp(_config) {}
+        : _path(path),
+          _config(std::move(config)),
+          _configTemp(_config),
+          _highResolutionConfig(_config) {}
 
     ~FTDCController() = default;
 
@@ -94,6 +97,16 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set whether the high resolution collectors are sampled.
+     */
+    void setHighResolutionEnabled(bool enabled);
+
+    /**
+     * Set the period for high resolution data collection.
+     */
+    void setHighResolutionPeriod(Milliseconds millis);
+
     /**
      * Add a metric collector to collect periodically. i.e., serverStatus
      */
@@ -106,6 +119,15 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a metric collector to collect on the high resolution period. These should only read
+     * cheap counters, since they may run tens of times per second. i.e., ticket usage
+     *
+     * Their samples are written to the kFTDCHighResolutionDirectory subdirectory, so that the
+     * periodic samples keep their own schema and compression.
+     */
+    void addHighResolutionCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+
     /**
      * Start the controller.
      *
@@ -136,6 +158,11 @@ private:
      */
     void doLoop();
 
+    /**
+     * Do high resolution statistics collection on its own background thread.
+     */
+    void doHighResolutionLoop();
+
 private:
     /**
     * Private enum to track state.
@@ -200,6 +227,22 @@ private:
 
     // Background collection and writing thread
     stdx::thread _thread;
+
+    // Config settings used by the high resolution thread and its file manager.
+    // Copied from _configTemp like _config, but by the high resolution thread.
+    FTDCConfig _highResolutionConfig;
+
+    // Set of high resolution collectors
+    FTDCCollectorCollection _highResolutionCollectors;
+
+    // Never has any collectors, the high resolution files do not repeat the rotate collectors
+    FTDCCollectorCollection _highResolutionRotateCollectors;
+
+    // File manager for the high resolution subdirectory
+    std::unique_ptr<FTDCFileManager> _highResolutionMgr;
+
+    // High resolution collection and writing thread, only started if there are collectors
+    stdx::thread _highResolutionThread;
 };
 
 }  // namespace mongo
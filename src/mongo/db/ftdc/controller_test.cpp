@@ -277,4 +277,61 @@ TEST(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs);
 }
 
+// Test that high resolution samples are written to their own subdirectory, in the same format as
+// the periodic samples
+TEST(FTDCControllerTest, TestHighResolution) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path dir(tempdir.path());
+
+    createDirectoryClean(dir);
+
+    FTDCConfig config;
+    config.enabled = true;
+    config.period = Milliseconds(1);
+    config.highResolutionEnabled = true;
+    config.highResolutionPeriod = Milliseconds(1);
+    config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+    config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+
+    FTDCController c(dir, config);
+
+    auto c1 = stdx::make_unique<FTDCMetricsCollectorMock2>();
+    auto c2 = stdx::make_unique<FTDCMetricsCollectorMock2>();
+
+    auto c1Ptr = c1.get();
+    auto c2Ptr = c2.get();
+
+    c1Ptr->setSignalOnCount(10);
+    c2Ptr->setSignalOnCount(50);
+
+    c.addPeriodicCollector(std::move(c1));
+
+    c.addHighResolutionCollector(std::move(c2));
+
+    c.start();
+
+    // Wait for samples from both threads to have occured
+    c1Ptr->wait();
+    c2Ptr->wait();
+
+    c.stop();
+
+    auto docsPeriodic = c1Ptr->getDocs();
+    ASSERT_GREATER_THAN_OR_EQUALS(docsPeriodic.size(), 10UL);
+
+    auto docsHighResolution = c2Ptr->getDocs();
+    ASSERT_GREATER_THAN_OR_EQUALS(docsHighResolution.size(), 50UL);
+
+    // The archive file and the high resolution subdirectory
+    auto files = scanDirectory(dir);
+
+    ASSERT_EQUALS(files.size(), 2UL);
+
+    auto highResolutionFiles = scanDirectory(dir / kFTDCHighResolutionDirectory);
+
+    ASSERT_EQUALS(highResolutionFiles.size(), 1UL);
+
+    ValidateDocumentList(highResolutionFiles[0], docsHighResolution);
+}
+
 }  // namespace mongo
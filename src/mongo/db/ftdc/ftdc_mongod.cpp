@@ -38,6 +38,7 @@
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/controller.h"
@@ -247,6 +248,58 @@ public:
 
 } exportedFTDCInterimChunkSizeParameter;
 
+std::atomic<bool> localHighResolutionEnabledFlag(  // NOLINT
+    FTDCConfig::kHighResolutionEnabledDefault);
+
+class ExportedFTDCHighResolutionEnabledParameter
+    : public ExportedServerParameter<bool, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedFTDCHighResolutionEnabledParameter()
+        : ExportedServerParameter<bool, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "diagnosticDataCollectionHighResolutionEnabled",
+              &localHighResolutionEnabledFlag) {}
+
+    virtual Status validate(const bool& potentialNewValue) {
+        auto controller = getGlobalFTDCController();
+        if (controller) {
+            controller->setHighResolutionEnabled(potentialNewValue);
+        }
+
+        return Status::OK();
+    }
+
+} exportedFTDCHighResolutionEnabledParameter;
+
+std::atomic<std::int32_t> localHighResolutionPeriodMillis(  // NOLINT
+    FTDCConfig::kHighResolutionPeriodMillisDefault);
+
+class ExportedFTDCHighResolutionPeriodParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedFTDCHighResolutionPeriodParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "diagnosticDataCollectionHighResolutionPeriodMillis",
+              &localHighResolutionPeriodMillis) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue < 10) {
+            return Status(ErrorCodes::BadValue,
+                          "diagnosticDataCollectionHighResolutionPeriodMillis must be greater "
+                          "than or equal to 10ms");
+        }
+
+        auto controller = getGlobalFTDCController();
+        if (controller) {
+            controller->setHighResolutionPeriod(Milliseconds(potentialNewValue));
+        }
+
+        return Status::OK();
+    }
+
+} exportedFTDCHighResolutionPeriodParameter;
+
 class FTDCSimpleInternalCommandCollector final : public FTDCCollectorInterface {
 public:
     FTDCSimpleInternalCommandCollector(StringData command,
@@ -283,6 +336,28 @@ private:
     Command* _command;
 };
 
+/**
+ * Collects a few serverStatus sections without running the rest of serverStatus, for sampling
+ * on the high resolution period.
+ */
+class FTDCServerStatusSectionsCollector final : public FTDCCollectorInterface {
+public:
+    FTDCServerStatusSectionsCollector(StringData name, BSONObj sectionSpecs)
+        : _name(name.toString()), _sectionSpecs(std::move(sectionSpecs)) {}
+
+    void collect(OperationContext* txn, BSONObjBuilder& builder) override {
+        appendServerStatusSections(txn, _sectionSpecs, &builder);
+    }
+
+    std::string name() const override {
+        return _name;
+    }
+
+private:
+    std::string _name;
+    BSONObj _sectionSpecs;
+};
+
 }  // namespace
 
 // Register the FTDC system
@@ -301,6 +376,8 @@ void startFTDC() {
     config.maxDirectorySizeBytes = localMaxDirectorySizeMB * 1024 * 1024;
     config.maxSamplesPerArchiveMetricChunk = localMaxSamplesPerArchiveMetricChunk;
     config.maxSamplesPerInterimMetricChunk = localMaxSamplesPerInterimMetricChunk;
+    config.highResolutionEnabled = localHighResolutionEnabledFlag;
+    config.highResolutionPeriod = Milliseconds(localHighResolutionPeriodMillis.load());
 
     auto controller = stdx::make_unique<FTDCController>(dir, config);
 
@@ -339,6 +416,17 @@ void startFTDC() {
     // Install System Metric Collector as a periodic collector
     installSystemMetricsCollector(controller.get());
 
+    // Install high resolution collectors
+    // These are collected on the high resolution period in FTDCConfig when it is enabled, and
+    // only include sections which read counters so that sampling many times a second is cheap.
+    // Queueing shows up in globalLock and in the WiredTiger concurrentTransactions tickets before
+    // it can be seen at the one second period.
+    controller->addHighResolutionCollector(stdx::make_unique<FTDCServerStatusSectionsCollector>(
+        "serverStatus",
+        BSON("globalLock" << 1 << "opLatencies" << 1 << "opcounters" << 1 << "wiredTiger"
+                          << BSON("include" << BSON_ARRAY("cache"
+                                                          << "concurrentTransactions")))));
+
     // Install file rotation collectors
     // These are collected on each file rotation.
 
@@ -63,7 +63,10 @@ const char kFTDCDocsField[] = "docs";
 const char kFTDCCollectStartField[] = "start";
 const char kFTDCCollectEndField[] = "end";
 
+const char kFTDCHighResolutionDirectory[] = "highres";
+
 const std::int64_t FTDCConfig::kPeriodMillisDefault = 1000;
+const std::int64_t FTDCConfig::kHighResolutionPeriodMillisDefault = 100;
 
 const std::size_t kMaxRecursion = 10;
 
@@ -93,6 +93,11 @@ public:
     typedef std::pair<BSONObj, RecordId> Data;
 
     int operator()(const Data& l, const Data& r) const {
+        // Duplicate keys are common in index builds and identical bytes always compare equal.
+        if (l.first.binaryEqual(r.first)) {
+            return l.second.compare(r.second);
+        }
+
         int x = (_version == IndexVersion::kV0
                      ? oldCompare(l.first, r.first, _ordering)
                      : l.first.woCompare(r.first, _ordering, /*considerfieldname*/ false));
@@ -431,16 +436,7 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* txn,
 
     _everGeneratedMultipleKeys = _everGeneratedMultipleKeys || (keys.size() > 1);
 
-    if (!multikeyPaths.empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
-            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
-                _indexMultikeyPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
-            }
-        }
-    }
+    _mergeMultikeyPaths(multikeyPaths);
 
     for (BSONObjSet::iterator it = keys.begin(); it != keys.end(); ++it) {
         _sorter->add(*it, loc);
@@ -455,6 +451,34 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* txn,
 }
 
 
+void IndexAccessMethod::BulkBuilder::merge(std::unique_ptr<BulkBuilder> other) {
+    invariant(other->_real == _real);
+
+    _mergedSorters.push_back(std::move(other->_sorter));
+    for (auto&& sorter : other->_mergedSorters) {
+        _mergedSorters.push_back(std::move(sorter));
+    }
+
+    _keysInserted += other->_keysInserted;
+    _everGeneratedMultipleKeys = _everGeneratedMultipleKeys || other->_everGeneratedMultipleKeys;
+    _mergeMultikeyPaths(other->_indexMultikeyPaths);
+}
+
+void IndexAccessMethod::BulkBuilder::_mergeMultikeyPaths(const MultikeyPaths& multikeyPaths) {
+    if (multikeyPaths.empty()) {
+        return;
+    }
+
+    if (_indexMultikeyPaths.empty()) {
+        _indexMultikeyPaths = multikeyPaths;
+    } else {
+        invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+        for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+            _indexMultikeyPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
+        }
+    }
+}
+
 Status IndexAccessMethod::commitBulk(OperationContext* txn,
                                      std::unique_ptr<BulkBuilder> bulk,
                                      bool mayInterrupt,
@@ -462,7 +486,21 @@ Status IndexAccessMethod::commitBulk(OperationContext* txn,
                                      set<RecordId>* dupsToDrop) {
     Timer timer;
 
-    std::unique_ptr<BulkBuilder::Sorter::Iterator> i(bulk->_sorter->done());
+    std::unique_ptr<BulkBuilder::Sorter::Iterator> i;
+    if (bulk->_mergedSorters.empty()) {
+        i.reset(bulk->_sorter->done());
+    } else {
+        std::vector<std::shared_ptr<BulkBuilder::Sorter::Iterator>> iterators;
+        iterators.emplace_back(bulk->_sorter->done());
+        for (auto&& sorter : bulk->_mergedSorters) {
+            iterators.emplace_back(sorter->done());
+        }
+
+        i.reset(BulkBuilder::Sorter::Iterator::merge(
+            iterators,
+            SortOptions(),
+            BtreeExternalSortComparison(_descriptor->keyPattern(), _descriptor->version())));
+    }
 
     stdx::unique_lock<Client> lk(*txn->getClient());
     ProgressMeterHolder pm(*txn->setMessage_inlock("Index Bulk Build: (2/3) btree bottom up",
@@ -207,6 +207,14 @@ public:
                       const InsertDeleteOptions& options,
                       int64_t* numInserted);
 
+        /**
+         * Takes over the keys inserted into 'other', which must have been initiated on the same
+         * index, so that they get committed together with the keys of this BulkBuilder. This
+         * allows several threads to generate the keys for one index, each into its own
+         * BulkBuilder. The sorted runs of all merged BulkBuilders are merged by commitBulk.
+         */
+        void merge(std::unique_ptr<BulkBuilder> other);
+
     private:
         friend class IndexAccessMethod;
 
@@ -216,7 +224,13 @@ public:
                     const IndexDescriptor* descriptor,
                     size_t maxMemoryUsageBytes);
 
+        void _mergeMultikeyPaths(const MultikeyPaths& multikeyPaths);
+
         std::unique_ptr<Sorter> _sorter;
+
+        // Sorters taken over from other BulkBuilders by merge()
+        std::vector<std::unique_ptr<Sorter>> _mergedSorters;
+
         const IndexAccessMethod* _real;
         int64_t _keysInserted = 0;
 
@@ -0,0 +1,191 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/top_level_field_matcher.h"
+
+#include <algorithm>
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_leaf.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Returns the rank a predicate of type 'matchType' starts with before any documents have been
+ * seen, lower ranks being tried first, or -1 if it cannot be evaluated by a TopLevelFieldMatcher.
+ * These are the leaves which match an element that is not an array exactly when
+ * matchesSingleElement() does, including a missing field as EOO.
+ */
+int initialRank(MatchExpression::MatchType matchType) {
+    switch (matchType) {
+        case MatchExpression::EQ:
+            return 0;
+        case MatchExpression::MATCH_IN:
+            return 1;
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return 2;
+        case MatchExpression::EXISTS:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+bool isTopLevelPath(StringData path) {
+    return !path.empty() && path.find('.') == std::string::npos;
+}
+
+/**
+ * Returns true if 'expr' is the negation of an $exists, which is how {a: {$exists: false}} is
+ * parsed.
+ */
+bool isNegatedExists(const MatchExpression* expr) {
+    return expr->matchType() == MatchExpression::NOT && expr->numChildren() == 1 &&
+        expr->getChild(0)->matchType() == MatchExpression::EXISTS;
+}
+
+}  // namespace
+
+std::unique_ptr<TopLevelFieldMatcher> TopLevelFieldMatcher::make(const MatchExpression* expr) {
+    std::vector<const MatchExpression*> leaves;
+    if (expr->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            leaves.push_back(expr->getChild(i));
+        }
+    } else {
+        leaves.push_back(expr);
+    }
+
+    if (leaves.empty()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<TopLevelFieldMatcher> matcher(new TopLevelFieldMatcher());
+    std::vector<int> ranks;
+    for (auto leaf : leaves) {
+        const bool negated = isNegatedExists(leaf);
+        if (negated) {
+            leaf = leaf->getChild(0);
+        }
+
+        int rank = initialRank(leaf->matchType());
+        if (rank < 0 || !isTopLevelPath(leaf->path())) {
+            return nullptr;
+        }
+
+        auto fieldIt =
+            std::find(matcher->_fieldNames.begin(), matcher->_fieldNames.end(), leaf->path());
+        if (fieldIt == matcher->_fieldNames.end()) {
+            fieldIt = matcher->_fieldNames.insert(fieldIt, leaf->path());
+        }
+
+        Predicate predicate;
+        predicate.expr = static_cast<const LeafMatchExpression*>(leaf);
+        predicate.negated = negated;
+        predicate.fieldIndex = fieldIt - matcher->_fieldNames.begin();
+        predicate.tested = 0;
+        predicate.rejected = 0;
+        matcher->_predicates.push_back(predicate);
+        ranks.push_back(rank);
+    }
+
+    // Start with equalities, which usually reject the most documents.
+    std::vector<size_t> order(ranks.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(
+        order.begin(), order.end(), [&ranks](size_t l, size_t r) { return ranks[l] < ranks[r]; });
+
+    std::vector<Predicate> predicates;
+    for (size_t i : order) {
+        predicates.push_back(matcher->_predicates[i]);
+    }
+    matcher->_predicates = std::move(predicates);
+
+    matcher->_elements.resize(matcher->_fieldNames.size());
+    return matcher;
+}
+
+bool TopLevelFieldMatcher::matches(const BSONObj& doc) {
+    if (++_docsTested % kReorderInterval == 0) {
+        reorderPredicates();
+    }
+
+    // Find the first element of each field, as BSONObj::getField() would, in one pass.
+    std::fill(_elements.begin(), _elements.end(), BSONElement());
+    size_t remaining = _elements.size();
+    BSONObjIterator it(doc);
+    while (remaining > 0 && it.more()) {
+        BSONElement elem = it.next();
+        StringData fieldName = elem.fieldNameStringData();
+        for (size_t i = 0; i < _fieldNames.size(); ++i) {
+            if (_elements[i].eoo() && _fieldNames[i] == fieldName) {
+                _elements[i] = elem;
+                --remaining;
+                break;
+            }
+        }
+    }
+
+    for (auto&& predicate : _predicates) {
+        ++predicate.tested;
+
+        const BSONElement& elem = _elements[predicate.fieldIndex];
+        bool matched = (elem.type() == Array) ? predicate.expr->matchesBSON(doc)
+                                              : predicate.expr->matchesSingleElement(elem);
+        if (matched == predicate.negated) {
+            ++predicate.rejected;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TopLevelFieldMatcher::reorderPredicates() {
+    // Compare rejection rates l.rejected / l.tested > r.rejected / r.tested without dividing.
+    // Predicates which have not been tested yet keep their place behind the ones that have.
+    std::stable_sort(
+        _predicates.begin(), _predicates.end(), [](const Predicate& l, const Predicate& r) {
+            if (l.tested == 0 || r.tested == 0) {
+                return l.tested != 0 && r.tested == 0;
+            }
+            return static_cast<double>(l.rejected) * r.tested >
+                static_cast<double>(r.rejected) * l.tested;
+        });
+}
+
+}  // namespace mongo
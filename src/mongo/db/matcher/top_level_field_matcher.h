@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+class LeafMatchExpression;
+class MatchExpression;
+
+/**
+ * Evaluates a MatchExpression that is a single predicate, or a conjunction of predicates, on
+ * top-level fields, e.g. {a: 5, b: {$gte: 1, $lt: 10}, c: {$in: [1, 2]}, d: {$exists: false}}.
+ *
+ * Each document is walked once to find the first element of every field used by the
+ * predicates, which are then tested against those elements directly instead of building an
+ * ElementIterator per predicate. A field holding an array is left to the predicate's own
+ * matches(), so the results are always the same as MatchExpression::matchesBSON().
+ *
+ * The predicates are tried in order of how often they have rejected a document so far, so that
+ * the conjunction usually fails on its first predicate.
+ *
+ * The MatchExpression must outlive the TopLevelFieldMatcher.
+ */
+class TopLevelFieldMatcher {
+    MONGO_DISALLOW_COPYING(TopLevelFieldMatcher);
+
+public:
+    /**
+     * Returns nullptr if 'expr' cannot be evaluated by a TopLevelFieldMatcher.
+     */
+    static std::unique_ptr<TopLevelFieldMatcher> make(const MatchExpression* expr);
+
+    /**
+     * Returns true if 'doc' matches the expression.
+     */
+    bool matches(const BSONObj& doc);
+
+    /**
+     * Number of documents between reorderings of the predicates by their rejection rates.
+     */
+    static const std::uint64_t kReorderInterval = 1024;
+
+private:
+    struct Predicate {
+        const LeafMatchExpression* expr;
+        bool negated;  // Set for {$exists: false}, which matches when 'expr' does not.
+        size_t fieldIndex;
+        std::uint64_t tested;
+        std::uint64_t rejected;
+    };
+
+    TopLevelFieldMatcher() = default;
+
+    void reorderPredicates();
+
+    // Distinct fields used by the predicates. Point into the paths of the predicates.
+    std::vector<StringData> _fieldNames;
+
+    std::vector<Predicate> _predicates;
+
+    // The element found for each of _fieldNames in the current document, EOO if it is missing.
+    std::vector<BSONElement> _elements;
+
+    std::uint64_t _docsTested = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,146 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/top_level_field_matcher.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& query,
+                                       const CollatorInterface* collator = nullptr) {
+    auto statusWithMatcher =
+        MatchExpressionParser::parse(query, ExtensionsCallbackDisallowExtensions(), collator);
+    ASSERT_OK(statusWithMatcher.getStatus());
+    return std::move(statusWithMatcher.getValue());
+}
+
+/**
+ * Asserts that a TopLevelFieldMatcher can be built for 'query' and that it matches exactly the
+ * documents of 'docs' that the MatchExpression itself matches.
+ */
+void assertMatchesSameDocuments(const BSONObj& query,
+                                const std::vector<BSONObj>& docs,
+                                const CollatorInterface* collator = nullptr) {
+    auto expr = parse(query, collator);
+    auto matcher = TopLevelFieldMatcher::make(expr.get());
+    ASSERT(matcher);
+
+    for (auto&& doc : docs) {
+        ASSERT_EQ(expr->matchesBSON(doc), matcher->matches(doc)) << "query: " << query
+                                                                  << " doc: " << doc;
+    }
+}
+
+const std::vector<BSONObj> kDocs = {
+    fromjson("{}"),
+    fromjson("{a: 1}"),
+    fromjson("{a: 5, b: 'x'}"),
+    fromjson("{b: 2, a: 3}"),
+    fromjson("{a: null, b: 1}"),
+    fromjson("{a: [1, 5], b: 3}"),
+    fromjson("{a: [], b: []}"),
+    fromjson("{a: [[3]], b: 3}"),
+    fromjson("{a: {c: 1}, b: 3}"),
+    fromjson("{a: NaN, b: NaN}"),
+    fromjson("{a: 3, a: 4, b: 3}"),
+    fromjson("{c: 1, b: 3, a: 4.5}"),
+    fromjson("{a: 'abc', b: 'ABC'}"),
+    fromjson("{a: {$minKey: 1}, b: {$maxKey: 1}}"),
+};
+
+TEST(TopLevelFieldMatcherTest, CanBeMadeForConjunctionsOfSimpleTopLevelPredicates) {
+    ASSERT(TopLevelFieldMatcher::make(parse(fromjson("{a: 1}")).get()));
+    ASSERT(TopLevelFieldMatcher::make(parse(fromjson("{a: {$gt: 1, $lte: 5}, b: 'x'}")).get()));
+    ASSERT(TopLevelFieldMatcher::make(
+        parse(fromjson("{a: {$in: [1, 2]}, b: {$exists: true}}")).get()));
+    ASSERT(TopLevelFieldMatcher::make(parse(fromjson("{a: {$exists: false}}")).get()));
+    ASSERT(TopLevelFieldMatcher::make(parse(fromjson("{a: 1, b: {$exists: false}}")).get()));
+}
+
+TEST(TopLevelFieldMatcherTest, CannotBeMadeForOtherExpressions) {
+    ASSERT_FALSE(TopLevelFieldMatcher::make(parse(fromjson("{'a.b': 1}")).get()));
+    ASSERT_FALSE(TopLevelFieldMatcher::make(parse(fromjson("{a: 1, 'b.c': 1}")).get()));
+    ASSERT_FALSE(TopLevelFieldMatcher::make(parse(fromjson("{$or: [{a: 1}, {b: 1}]}")).get()));
+    ASSERT_FALSE(TopLevelFieldMatcher::make(parse(fromjson("{a: {$ne: 1}}")).get()));
+    ASSERT_FALSE(TopLevelFieldMatcher::make(parse(fromjson("{a: {$not: {$gt: 1}}}")).get()));
+    ASSERT_FALSE(TopLevelFieldMatcher::make(parse(fromjson("{a: /abc/}")).get()));
+    ASSERT_FALSE(TopLevelFieldMatcher::make(parse(fromjson("{a: {$elemMatch: {$gt: 1}}}")).get()));
+}
+
+TEST(TopLevelFieldMatcherTest, ComparisonsMatchSameDocumentsAsMatchExpression) {
+    assertMatchesSameDocuments(fromjson("{a: 3}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: null}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: [3]}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: {$gte: 3}}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: {$lt: 5}, b: {$gte: 3}}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: {$gt: 1, $lte: 5}, b: 3}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: NaN}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{b: {$lte: {$maxKey: 1}}}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: {c: 1}}"), kDocs);
+}
+
+TEST(TopLevelFieldMatcherTest, InAndExistsMatchSameDocumentsAsMatchExpression) {
+    assertMatchesSameDocuments(fromjson("{a: {$in: [1, 4, null]}}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: {$in: [[], /^ab/]}}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: {$exists: true}, b: {$exists: false}}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{b: {$exists: false}}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: {$not: {$exists: true}}}"), kDocs);
+    assertMatchesSameDocuments(fromjson("{a: {$in: [3, 4]}, b: {$exists: true}}"), kDocs);
+}
+
+TEST(TopLevelFieldMatcherTest, UsesTheCollatorOfTheExpression) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    assertMatchesSameDocuments(fromjson("{a: 'xyz'}"), kDocs, &collator);
+    assertMatchesSameDocuments(fromjson("{b: {$in: ['xyz']}}"), kDocs, &collator);
+}
+
+TEST(TopLevelFieldMatcherTest, ResultsDoNotChangeWhenPredicatesAreReordered) {
+    // The predicate on 'b' rejects most documents, so it is moved ahead of the predicate on 'a'.
+    auto expr = parse(fromjson("{a: {$gte: 0}, b: {$lt: 10}}"));
+    auto matcher = TopLevelFieldMatcher::make(expr.get());
+    ASSERT(matcher);
+
+    for (int i = 0; i < static_cast<int>(TopLevelFieldMatcher::kReorderInterval) * 4; ++i) {
+        BSONObj doc = BSON("a" << i << "b" << i);
+        ASSERT_EQ(i < 10, matcher->matches(doc));
+        ASSERT_EQ(expr->matchesBSON(doc), matcher->matches(doc));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
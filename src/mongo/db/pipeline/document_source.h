@@ -565,6 +565,18 @@ public:
                                           const BSONObj& param,
                                           BSONObjBuilder* builder) const = 0;
 
+        /**
+         * Returns the size in bytes of the documents in collection "nss", or 0 if it does not
+         * exist.
+         */
+        virtual long long getCollectionDataSize(const NamespaceString& nss) = 0;
+
+        /**
+         * Returns the specs of the indexes on collection "nss", or an empty list if it does not
+         * exist.
+         */
+        virtual std::list<BSONObj> getIndexSpecs(const NamespaceString& nss) = 0;
+
         /**
          * Gets the collection options for the collection given by 'nss'.
          */
@@ -28,9 +28,14 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/expression.h"
@@ -38,7 +43,12 @@
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_pool.h"
 
 namespace mongo {
 
@@ -51,6 +61,265 @@ REGISTER_DOCUMENT_SOURCE(group,
                          LiteParsedDocumentSourceDefault::parse,
                          DocumentSourceGroup::createFromBson);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupParallelism, int, 1);
+
+/**
+ * Groups the input of an unsorted $group on a pool of worker threads. The pipeline thread still
+ * pulls every document from the previous stage, since the stages below it share an
+ * OperationContext that is not safe to use concurrently, but hands them out in batches. Each
+ * batch is folded into one of 'numPartials' partial groups maps, and the partial maps are then
+ * combined through the same accumulator merge path that mongos uses to merge shard results.
+ *
+ * Which partial a document lands in, and the order in which the partials are merged, have
+ * nothing to do with the input order, so this is only used when every accumulator's result is
+ * independent of the order of its input.
+ *
+ * Memory use is checked after every document. Once the partials together exceed the limit, the
+ * workers stop grouping, and the documents they have not grouped are handed back to be grouped
+ * (and if necessary spilled) on the pipeline thread.
+ */
+class DocumentSourceGroup::ParallelPreAggregation {
+    MONGO_DISALLOW_COPYING(ParallelPreAggregation);
+
+public:
+    static const size_t kBatchSize = 1024;
+
+    ParallelPreAggregation(DocumentSourceGroup* group,
+                           size_t numPartials,
+                           size_t maxMemoryUsageBytes);
+    ~ParallelPreAggregation();
+
+    /**
+     * Queues 'input' to be grouped. Blocks while every partial is busy, and throws if grouping an
+     * earlier batch failed.
+     */
+    void add(Document input);
+
+    /**
+     * Returns true once the partial groups together have exceeded the memory limit. No more input
+     * may be added after that.
+     */
+    bool exceededMemoryLimit() const {
+        return _exceededMemoryLimit.load();
+    }
+
+    /**
+     * Waits for all queued documents to be grouped. Throws if grouping any of them failed.
+     */
+    void finish();
+
+    /**
+     * Combines the partial groups into 'groups', adjusting '*memoryUsageBytes' to account for the
+     * groups it adds. Returns the documents which were not grouped because the memory limit was
+     * exceeded. Must be called after finish().
+     */
+    std::vector<Document> mergeInto(GroupsMap* groups, size_t* memoryUsageBytes);
+
+private:
+    struct Partial {
+        boost::optional<GroupsMap> groups;
+        std::unique_ptr<Variables> variables;
+        size_t memoryUsageBytes = 0;
+    };
+
+    void _dispatchBatch();
+    void _processBatch(std::vector<Document>* batch);
+
+    DocumentSourceGroup* const _group;
+    const size_t _maxMemoryUsageBytes;
+    std::vector<Document> _batch;
+    std::vector<std::unique_ptr<Partial>> _partials;
+
+    // Total memory used by the partials, updated after every document.
+    AtomicInt64 _memoryUsageBytes;
+    AtomicWord<bool> _exceededMemoryLimit;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _batchDone;
+    std::vector<Partial*> _idlePartials;  // Partials not currently owned by a batch.
+    size_t _batchesInFlight = 0;
+    std::vector<Document> _ungrouped;  // Left over once the memory limit was exceeded.
+    Status _status = Status::OK();
+};
+
+namespace {
+
+/**
+ * Returns the pool shared by the pre-aggregation of every $group, which bounds the number of
+ * threads concurrent aggregations can use between them. It lives as long as the process.
+ */
+ThreadPool* getPreAggregationThreadPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "groupPreAggregation";
+        options.minThreads = 0;
+        options.maxThreads = std::max(1U, stdx::thread::hardware_concurrency());
+        auto pool = new ThreadPool(options);
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
+
+/**
+ * Returns true if the results of these accumulators do not depend on the order of their input,
+ * so that partial results over arbitrary slices of the input may be merged in any order.
+ */
+bool areOrderInsensitive(const std::vector<Accumulator::Factory>& factories) {
+    static const std::set<StringData> kOrderInsensitiveOps{
+        "$avg"_sd, "$max"_sd, "$min"_sd, "$stdDevPop"_sd, "$stdDevSamp"_sd, "$sum"_sd};
+    for (auto&& factory : factories) {
+        if (!kOrderInsensitiveOps.count(factory()->getOpName())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+DocumentSourceGroup::ParallelPreAggregation::ParallelPreAggregation(DocumentSourceGroup* group,
+                                                                    size_t numPartials,
+                                                                    size_t maxMemoryUsageBytes)
+    : _group(group), _maxMemoryUsageBytes(maxMemoryUsageBytes), _exceededMemoryLimit(false) {
+    _batch.reserve(kBatchSize);
+    for (size_t i = 0; i < numPartials; i++) {
+        auto partial = stdx::make_unique<Partial>();
+        partial->groups =
+            group->pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+        partial->variables = stdx::make_unique<Variables>(group->_numVariables);
+        _idlePartials.push_back(partial.get());
+        _partials.push_back(std::move(partial));
+    }
+}
+
+DocumentSourceGroup::ParallelPreAggregation::~ParallelPreAggregation() {
+    // The batches still queued on the shared pool refer to this object.
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _batchDone.wait(lk, [this] { return _batchesInFlight == 0; });
+}
+
+void DocumentSourceGroup::ParallelPreAggregation::add(Document input) {
+    dassert(!exceededMemoryLimit());
+    _batch.push_back(std::move(input));
+    if (_batch.size() >= kBatchSize) {
+        _dispatchBatch();
+    }
+}
+
+void DocumentSourceGroup::ParallelPreAggregation::_dispatchBatch() {
+    {
+        // Only dispatch a batch once a partial is free for it.
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _batchDone.wait(lk, [this] { return _batchesInFlight < _partials.size(); });
+        uassertStatusOK(_status);
+        ++_batchesInFlight;
+    }
+
+    auto batch = std::make_shared<std::vector<Document>>(std::move(_batch));
+    _batch = std::vector<Document>();
+    _batch.reserve(kBatchSize);
+
+    Status scheduleStatus =
+        getPreAggregationThreadPool()->schedule([this, batch] { _processBatch(batch.get()); });
+    if (!scheduleStatus.isOK()) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        --_batchesInFlight;
+        _batchDone.notify_all();
+        uassertStatusOK(scheduleStatus);
+    }
+}
+
+void DocumentSourceGroup::ParallelPreAggregation::_processBatch(std::vector<Document>* batch) {
+    Partial* partial;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        // There is never more than one batch in flight per partial, so one is always free here.
+        invariant(!_idlePartials.empty());
+        partial = _idlePartials.back();
+        _idlePartials.pop_back();
+    }
+
+    size_t numGrouped = 0;
+    Status status = Status::OK();
+    try {
+        for (; numGrouped < batch->size() && !exceededMemoryLimit(); ++numGrouped) {
+            const size_t oldMemoryUsageBytes = partial->memoryUsageBytes;
+            partial->variables->setRoot((*batch)[numGrouped]);
+            _group->accumulate(
+                partial->variables.get(), &*partial->groups, &partial->memoryUsageBytes);
+            partial->variables->clearRoot();
+
+            const long long totalMemoryUsageBytes = _memoryUsageBytes.addAndFetch(
+                static_cast<long long>(partial->memoryUsageBytes) -
+                static_cast<long long>(oldMemoryUsageBytes));
+            if (totalMemoryUsageBytes > static_cast<long long>(_maxMemoryUsageBytes)) {
+                _exceededMemoryLimit.store(true);
+            }
+        }
+    } catch (...) {
+        status = exceptionToStatus();
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!status.isOK() && _status.isOK()) {
+        _status = std::move(status);
+    }
+    if (status.isOK()) {
+        std::move(batch->begin() + numGrouped, batch->end(), std::back_inserter(_ungrouped));
+    }
+    _idlePartials.push_back(partial);
+    --_batchesInFlight;
+    _batchDone.notify_all();
+}
+
+void DocumentSourceGroup::ParallelPreAggregation::finish() {
+    if (exceededMemoryLimit()) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        std::move(_batch.begin(), _batch.end(), std::back_inserter(_ungrouped));
+        _batch.clear();
+    } else if (!_batch.empty()) {
+        _dispatchBatch();
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _batchDone.wait(lk, [this] { return _batchesInFlight == 0; });
+    uassertStatusOK(_status);
+}
+
+std::vector<Document> DocumentSourceGroup::ParallelPreAggregation::mergeInto(
+    GroupsMap* groups, size_t* memoryUsageBytes) {
+    const size_t numAccumulators = _group->vpAccumulatorFactory.size();
+    for (auto&& partial : _partials) {
+        for (auto&& entry : *partial->groups) {
+            const size_t oldSize = groups->size();
+            Accumulators& group = (*groups)[entry.first];
+            if (groups->size() != oldSize) {
+                // First time we have seen this group, so we can take the partial's accumulators.
+                group = std::move(entry.second);
+                *memoryUsageBytes += entry.first.getApproximateSize();
+                for (size_t i = 0; i < numAccumulators; i++) {
+                    *memoryUsageBytes += group[i]->memUsageForSorter();
+                }
+                continue;
+            }
+
+            for (size_t i = 0; i < numAccumulators; i++) {
+                *memoryUsageBytes -= group[i]->memUsageForSorter();
+                group[i]->process(entry.second[i]->getValue(/*toBeMerged=*/true), /*merging=*/true);
+                *memoryUsageBytes += group[i]->memUsageForSorter();
+            }
+        }
+        partial->groups->clear();
+        partial->memoryUsageBytes = 0;
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return std::move(_ungrouped);
+}
+
+DocumentSourceGroup::~DocumentSourceGroup() = default;
+
 const char* DocumentSourceGroup::getSourceName() const {
     return "$group";
 }
@@ -171,6 +440,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
 
 void DocumentSourceGroup::dispose() {
     // Free our resources.
+    _parallel.reset();
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
 
@@ -280,6 +550,7 @@ intrusive_ptr<DocumentSourceGroup> DocumentSourceGroup::create(
         groupStage->addAccumulator(statement);
     }
     groupStage->_variables = stdx::make_unique<Variables>(numVariables);
+    groupStage->_numVariables = numVariables;
     groupStage->injectExpressionContext(pExpCtx);
     return groupStage;
 }
@@ -351,6 +622,23 @@ void DocumentSourceGroup::setIdExpression(const boost::intrusive_ptr<Expression>
     }
 }
 
+boost::optional<std::string> DocumentSourceGroup::getDistinctGroupKey() const {
+    if (!vFieldName.empty() || !_idFieldNames.empty() || _idExpressions.size() != 1 ||
+        !dynamic_cast<ExpressionFieldPath*>(_idExpressions[0].get())) {
+        return boost::none;
+    }
+
+    // Only paths of the input document are recorded as field dependencies. "$$ROOT" and paths
+    // of other variables are not.
+    DepsTracker deps;
+    _idExpressions[0]->addDependencies(&deps);
+    if (deps.needWholeDocument || deps.fields.size() != 1) {
+        return boost::none;
+    }
+
+    return *deps.fields.begin();
+}
+
 intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
     BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
     uassert(15947, "a group's fields must be specified in an object", elem.type() == Object);
@@ -384,6 +672,7 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
     uassert(15955, "a group specification must include an _id", !pGroup->_idExpressions.empty());
 
     pGroup->_variables.reset(new Variables(idGenerator.getIdCount()));
+    pGroup->_numVariables = idGenerator.getIdCount();
 
     return pGroup;
 }
@@ -514,65 +803,30 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
 
     dassert(numAccumulators == vpExpression.size());
 
+    if (!_parallelConsidered) {
+        _parallelConsidered = true;
+        const int parallelism = internalDocumentSourceGroupParallelism.load();
+        if (parallelism > 1 && areOrderInsensitive(vpAccumulatorFactory)) {
+            _parallel =
+                stdx::make_unique<ParallelPreAggregation>(this, parallelism, _maxMemoryUsageBytes);
+        }
+    }
+
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
     for (; input.isAdvanced(); input = pSource->getNext()) {
-        if (_memoryUsageBytes > _maxMemoryUsageBytes) {
-            uassert(16945,
-                    "Exceeded memory limit for $group, but didn't allow external sort."
-                    " Pass allowDiskUse:true to opt in.",
-                    _extSortAllowed);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
-        }
-
-        _variables->setRoot(input.releaseDocument());
-
-        Value id = computeId(_variables.get());
-
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Add the accumulators
-            group.reserve(numAccumulators);
-            for (size_t i = 0; i < numAccumulators; i++) {
-                group.push_back(vpAccumulatorFactory[i]());
-                group.back()->injectExpressionContext(pExpCtx);
-            }
-        } else {
-            for (size_t i = 0; i < numAccumulators; i++) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= group[i]->memUsageForSorter();
+        if (_parallel) {
+            if (!_parallel->exceededMemoryLimit()) {
+                _parallel->add(input.releaseDocument());
+                continue;
             }
-        }
 
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(vpExpression[i]->evaluate(_variables.get()), _doingMerge);
-            _memoryUsageBytes += group[i]->memUsageForSorter();
+            // The partial groups no longer fit in memory. Fold them together and fall back to
+            // grouping, and if necessary spilling, on this thread.
+            mergeParallelGroups();
         }
 
-        // We are done with the ROOT document so release it.
-        _variables->clearRoot();
-
-        if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                 // is a dup
-                !pExpCtx->inRouter &&        // can't spill to disk in router
-                !_extSortAllowed &&          // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
-
-                _sortedFiles.push_back(spill());
-            }
-        }
+        groupInput(input.releaseDocument());
     }
 
     switch (input.getStatus()) {
@@ -583,6 +837,20 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             return input;  // Propagate pause.
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
+            if (_parallel) {
+                mergeParallelGroups();
+
+                // Merging the partial groups may itself have taken the groups over the limit.
+                if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+                    uassert(16945,
+                            "Exceeded memory limit for $group, but didn't allow external sort."
+                            " Pass allowDiskUse:true to opt in.",
+                            _extSortAllowed);
+                    _sortedFiles.push_back(spill());
+                    _memoryUsageBytes = 0;
+                }
+            }
+
             // Do any final steps necessary to prepare to output results.
             if (!_sortedFiles.empty()) {
                 _spilled = true;
@@ -619,6 +887,85 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     MONGO_UNREACHABLE;
 }
 
+void DocumentSourceGroup::groupInput(Document input) {
+    if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+        uassert(16945,
+                "Exceeded memory limit for $group, but didn't allow external sort."
+                " Pass allowDiskUse:true to opt in.",
+                _extSortAllowed);
+        _sortedFiles.push_back(spill());
+        _memoryUsageBytes = 0;
+    }
+
+    _variables->setRoot(std::move(input));
+
+    const bool inserted = accumulate(_variables.get(), &*_groups, &_memoryUsageBytes);
+
+    // We are done with the ROOT document so release it.
+    _variables->clearRoot();
+
+    if (kDebugBuild && !storageGlobalParams.readOnly) {
+        // In debug mode, spill every time we have a duplicate id to stress merge logic.
+        if (!inserted &&                 // is a dup
+            !pExpCtx->inRouter &&        // can't spill to disk in router
+            !_extSortAllowed &&          // don't change behavior when testing external sort
+            _sortedFiles.size() < 20) {  // don't open too many FDs
+
+            _sortedFiles.push_back(spill());
+        }
+    }
+}
+
+bool DocumentSourceGroup::accumulate(Variables* vars,
+                                     GroupsMap* groups,
+                                     size_t* memoryUsageBytes) {
+    const size_t numAccumulators = vpAccumulatorFactory.size();
+
+    Value id = computeId(vars);
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in 'groups' multiple times.
+    const size_t oldSize = groups->size();
+    vector<intrusive_ptr<Accumulator>>& group = (*groups)[id];
+    const bool inserted = groups->size() != oldSize;
+
+    if (inserted) {
+        *memoryUsageBytes += id.getApproximateSize();
+
+        // Add the accumulators
+        group.reserve(numAccumulators);
+        for (size_t i = 0; i < numAccumulators; i++) {
+            group.push_back(vpAccumulatorFactory[i]());
+            group.back()->injectExpressionContext(pExpCtx);
+        }
+    } else {
+        for (size_t i = 0; i < numAccumulators; i++) {
+            // subtract old mem usage. New usage added back after processing.
+            *memoryUsageBytes -= group[i]->memUsageForSorter();
+        }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(vpExpression[i]->evaluate(vars), _doingMerge);
+        *memoryUsageBytes += group[i]->memUsageForSorter();
+    }
+
+    return inserted;
+}
+
+void DocumentSourceGroup::mergeParallelGroups() {
+    _parallel->finish();
+    auto ungrouped = _parallel->mergeInto(&*_groups, &_memoryUsageBytes);
+    _parallel.reset();
+
+    for (auto&& input : ungrouped) {
+        groupInput(std::move(input));
+    }
+}
+
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
     ptrs.reserve(_groups->size());
@@ -894,6 +1241,7 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::getMergeSource() {
     }
 
     pMerger->_variables.reset(new Variables(idGenerator.getIdCount()));
+    pMerger->_numVariables = idGenerator.getIdCount();
     pMerger->injectExpressionContext(pExpCtx);
 
     return pMerger;
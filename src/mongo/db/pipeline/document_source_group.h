@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -38,6 +39,11 @@
 
 namespace mongo {
 
+// Number of partial results an unsorted $group pre-aggregates its input into on other threads, if
+// all of its accumulators are insensitive to the order of their input. A value of 1 or less keeps
+// the whole group on the pipeline's thread.
+extern std::atomic<int> internalDocumentSourceGroupParallelism;  // NOLINT
+
 class DocumentSourceGroup final : public DocumentSource, public SplittableDocumentSource {
 public:
     using Accumulators = std::vector<boost::intrusive_ptr<Accumulator>>;
@@ -45,6 +51,8 @@ public:
 
     static const size_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
 
+    ~DocumentSourceGroup();
+
     // Virtuals from DocumentSource.
     boost::intrusive_ptr<DocumentSource> optimize() final;
     GetDepsReturn getDependencies(DepsTracker* deps) const final;
@@ -81,6 +89,13 @@ public:
      */
     void setIdExpression(const boost::intrusive_ptr<Expression> idExpression);
 
+    /**
+     * If this $group has no accumulators and groups by a single field path of the input document,
+     * as in {$group: {_id: "$a.b"}}, returns that path ("a.b"). Such a $group only needs to see
+     * each distinct value of the path once. Otherwise returns boost::none.
+     */
+    boost::optional<std::string> getDistinctGroupKey() const;
+
     /**
      * Tell this source if it is doing a merge from shards. Defaults to false.
      */
@@ -100,6 +115,8 @@ protected:
     void doInjectExpressionContext() final;
 
 private:
+    class ParallelPreAggregation;
+
     explicit DocumentSourceGroup(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
                                  size_t maxMemoryUsageBytes = kDefaultMaxMemoryUsageBytes);
 
@@ -137,6 +154,27 @@ private:
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
+    /**
+     * Groups 'input' into '_groups' on this thread, first spilling '_groups' to disk if it has
+     * outgrown the memory limit.
+     */
+    void groupInput(Document input);
+
+    /**
+     * Folds the document currently set as ROOT in 'vars' into the matching entry of 'groups',
+     * creating the entry if needed, and adjusts '*memoryUsageBytes' accordingly. Returns true if a
+     * new group was created. Only reads the stage's expressions and accumulator factories, so it
+     * may be called concurrently with distinct 'vars' and 'groups'.
+     */
+    bool accumulate(Variables* vars, GroupsMap* groups, size_t* memoryUsageBytes);
+
+    /**
+     * Waits for the parallel pre-aggregation to drain, folds its partial groups into '_groups'
+     * and stops using it. The documents it left ungrouped, and all subsequent input, are grouped
+     * on this thread.
+     */
+    void mergeParallelGroups();
+
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
     /**
@@ -164,6 +202,7 @@ private:
     size_t _memoryUsageBytes = 0;
     size_t _maxMemoryUsageBytes;
     std::unique_ptr<Variables> _variables;
+    Variables::Id _numVariables = 0;
     std::vector<std::string> _idFieldNames;  // used when id is a document
     std::vector<boost::intrusive_ptr<Expression>> _idExpressions;
 
@@ -182,6 +221,10 @@ private:
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
 
+    // Only set while an unsorted $group is pre-aggregating its input on other threads.
+    std::unique_ptr<ParallelPreAggregation> _parallel;
+    bool _parallelConsidered = false;
+
     // Only used when '_spilled' is false.
     GroupsMap::iterator groupsIterator;
 
@@ -192,6 +192,241 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     ASSERT_THROWS_CODE(group->getNext(), UserException, 16945);
 }
 
+/**
+ * Sets internalDocumentSourceGroupParallelism for the lifetime of the object.
+ */
+class ScopedGroupParallelism {
+public:
+    explicit ScopedGroupParallelism(int parallelism)
+        : _oldParallelism(internalDocumentSourceGroupParallelism.load()) {
+        internalDocumentSourceGroupParallelism.store(parallelism);
+    }
+
+    ~ScopedGroupParallelism() {
+        internalDocumentSourceGroupParallelism.store(_oldParallelism);
+    }
+
+private:
+    const int _oldParallelism;
+};
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupShouldMatchSerialResults) {
+    ScopedGroupParallelism parallelism(4);
+    auto expCtx = getExpCtx();
+
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    AccumulationStatement sumStatement{"total",
+                                       AccumulationStatement::getFactory("$sum"),
+                                       ExpressionFieldPath::parse("$b", vps)};
+    AccumulationStatement maxStatement{"largest",
+                                       AccumulationStatement::getFactory("$max"),
+                                       ExpressionFieldPath::parse("$b", vps)};
+    auto groupByExpression = ExpressionFieldPath::parse("$a", vps);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {sumStatement, maxStatement}, idGen.getIdCount());
+
+    // Use enough documents to fill several batches, with a pause in the middle.
+    const int numDocs = 10000;
+    const int numGroups = 37;
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < numDocs; ++i) {
+        inputs.emplace_back(Document{{"a", i % numGroups}, {"b", i}});
+        if (i == numDocs / 2) {
+            inputs.emplace_back(DocumentSource::GetNextResult::makePauseExecution());
+        }
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    map<int, std::pair<long long, int>> results;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        results[doc["_id"].coerceToInt()] = {doc["total"].coerceToLong(),
+                                             doc["largest"].coerceToInt()};
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+
+    ASSERT_EQ(results.size(), static_cast<size_t>(numGroups));
+    for (int groupId = 0; groupId < numGroups; ++groupId) {
+        long long expectedTotal = 0;
+        int expectedLargest = 0;
+        for (int i = groupId; i < numDocs; i += numGroups) {
+            expectedTotal += i;
+            expectedLargest = i;
+        }
+        ASSERT_EQ(results[groupId].first, expectedTotal);
+        ASSERT_EQ(results[groupId].second, expectedLargest);
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupShouldErrorIfNotAllowedToSpillToDisk) {
+    ScopedGroupParallelism parallelism(4);
+    auto expCtx = getExpCtx();
+    const size_t maxMemoryUsageBytes = 1000;
+    expCtx->inRouter = true;  // Disallow external sort.
+
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    AccumulationStatement maxStatement{"spaceHog",
+                                       AccumulationStatement::getFactory("$max"),
+                                       ExpressionFieldPath::parse("$largeStr", vps)};
+    auto groupByExpression = ExpressionFieldPath::parse("$_id", vps);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {maxStatement}, idGen.getIdCount(), maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                            Document{{"_id", 1}, {"largeStr", largeStr}}});
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(group->getNext(), UserException, 16945);
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelismShouldNotAffectOrderSensitiveAccumulators) {
+    ScopedGroupParallelism parallelism(4);
+    auto expCtx = getExpCtx();
+
+    // The input arrives sorted on 'b', as it would after a $sort, so $first and $push must see it
+    // in that order.
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    AccumulationStatement firstStatement{"first",
+                                         AccumulationStatement::getFactory("$first"),
+                                         ExpressionFieldPath::parse("$b", vps)};
+    AccumulationStatement pushStatement{"all",
+                                        AccumulationStatement::getFactory("$push"),
+                                        ExpressionFieldPath::parse("$b", vps)};
+    AccumulationStatement sumStatement{"total",
+                                       AccumulationStatement::getFactory("$sum"),
+                                       ExpressionFieldPath::parse("$b", vps)};
+    auto groupByExpression = ExpressionFieldPath::parse("$a", vps);
+    auto group = DocumentSourceGroup::create(expCtx,
+                                             groupByExpression,
+                                             {firstStatement, pushStatement, sumStatement},
+                                             idGen.getIdCount());
+
+    // Use enough documents to fill several batches.
+    const int numDocs = 10000;
+    const int numGroups = 7;
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < numDocs; ++i) {
+        inputs.emplace_back(Document{{"a", i % numGroups}, {"b", i}});
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    int numResults = 0;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        const int groupId = doc["_id"].coerceToInt();
+        ASSERT_EQ(doc["first"].coerceToInt(), groupId);
+
+        long long expectedTotal = 0;
+        vector<Value> expectedAll;
+        for (int i = groupId; i < numDocs; i += numGroups) {
+            expectedTotal += i;
+            expectedAll.push_back(Value(i));
+        }
+        ASSERT_VALUE_EQ(doc["all"], Value(expectedAll));
+        ASSERT_EQ(doc["total"].coerceToLong(), expectedTotal);
+        ++numResults;
+    }
+    ASSERT_EQ(numResults, numGroups);
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupShouldSpillOnceInputOutgrowsMemoryLimit) {
+    ScopedGroupParallelism parallelism(2);
+    auto expCtx = getExpCtx();
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->extSortAllowed = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    AccumulationStatement countStatement{"count",
+                                         AccumulationStatement::getFactory("$sum"),
+                                         ExpressionConstant::create(expCtx, Value(1))};
+    auto groupByExpression = ExpressionFieldPath::parse("$_id", vps);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {countStatement}, idGen.getIdCount(), maxMemoryUsageBytes);
+
+    // Every document is its own group, so the partial groups exceed the limit partway through the
+    // first batches, and the rest of the input is grouped, and spilled, serially.
+    const int numDocs = 5000;
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < numDocs; ++i) {
+        inputs.emplace_back(Document{{"_id", i}});
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    stdx::unordered_set<int> idSet;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        ASSERT_EQ(doc["count"].coerceToInt(), 1);
+        idSet.insert(doc["_id"].coerceToInt());
+    }
+    ASSERT_EQ(idSet.size(), static_cast<size_t>(numDocs));
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupShouldPropagateErrorsFromWorkers) {
+    ScopedGroupParallelism parallelism(4);
+    auto expCtx = getExpCtx();
+
+    VariablesIdGenerator idGen;
+    VariablesParseState vps(&idGen);
+    BSONObj divideSpec = BSON("" << BSON("$divide" << BSON_ARRAY(1 << "$b")));
+    AccumulationStatement sumStatement{"quotient",
+                                       AccumulationStatement::getFactory("$sum"),
+                                       Expression::parseOperand(divideSpec.firstElement(), vps)};
+    auto groupByExpression = ExpressionConstant::create(expCtx, Value(BSONNULL));
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {sumStatement}, idGen.getIdCount());
+
+    // Only one document divides by zero.
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 5000; ++i) {
+        inputs.emplace_back(Document{{"b", i == 3000 ? 0 : 1}});
+    }
+    auto mock = DocumentSourceMock::create(inputs);
+    group->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(group->getNext(), UserException, 16608);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReportDistinctGroupKeyOnlyForSingleFieldPathWithoutAccs) {
+    auto expCtx = getExpCtx();
+    auto distinctKey = [&](const BSONObj& spec) {
+        auto group = DocumentSourceGroup::createFromBson(BSON("$group" << spec).firstElement(),
+                                                         expCtx);
+        return static_cast<DocumentSourceGroup*>(group.get())->getDistinctGroupKey();
+    };
+
+    ASSERT_EQ(*distinctKey(BSON("_id"
+                                << "$a")),
+              "a");
+    ASSERT_EQ(*distinctKey(BSON("_id"
+                                << "$a.b")),
+              "a.b");
+
+    ASSERT_FALSE(distinctKey(BSON("_id"
+                                  << "$a"
+                                  << "count"
+                                  << BSON("$sum" << 1))));
+    ASSERT_FALSE(distinctKey(BSON("_id" << BSON("a"
+                                                << "$a"))));
+    ASSERT_FALSE(distinctKey(BSON("_id"
+                                  << "$$ROOT")));
+    ASSERT_FALSE(distinctKey(BSON("_id" << BSON("$add" << BSON_ARRAY("$a" << 1)))));
+    ASSERT_FALSE(distinctKey(BSON("_id" << BSONNULL)));
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
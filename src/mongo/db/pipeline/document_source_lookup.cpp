@@ -30,13 +30,21 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <numeric>
+
 #include "mongo/base/init.h"
+#include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/matcher/path.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -44,6 +52,22 @@ namespace mongo {
 using boost::intrusive_ptr;
 using std::vector;
 
+namespace {
+
+// The most memory, in bytes, that a $lookup may use to hold the foreign collection for a hash join.
+// If the foreign documents do not fit, the $lookup falls back to a nested loop join.
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupHashJoinMaxMemoryBytes,
+                              int,
+                              100 * 1024 * 1024);
+
+// Foreign collections no larger than this are hash joined even when they have an index on the
+// foreign field, since reading them once is cheaper than running a query per input document.
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupHashJoinMaxIndexedCollectionBytes,
+                              int,
+                              1024 * 1024);
+
+}  // namespace
+
 DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
                                            std::string as,
                                            std::string localField,
@@ -138,13 +162,11 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
 
     auto matchStage =
         makeMatchStageFromInput(inputDoc, _localField, _foreignFieldFieldName, BSONObj());
-    // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-    _fromPipeline.back() = matchStage;
-    auto pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+    findForeignMatches(inputDoc, matchStage);
 
     std::vector<Value> results;
     int objsize = 0;
-    while (auto result = pipeline->getNext()) {
+    while (auto result = getNextForeignMatch()) {
         objsize += result->getApproximateSize();
         uassert(4568,
                 str::stream() << "Total size of documents in " << _fromNs.coll() << " matching "
@@ -153,6 +175,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
                 objsize <= BSONObjMaxInternalSize);
         results.emplace_back(std::move(*result));
     }
+    _pipeline.reset();
 
     MutableDocument output(std::move(inputDoc));
     output.setNestedField(_as, Value(std::move(results)));
@@ -275,6 +298,11 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
 
 void DocumentSourceLookUp::dispose() {
     _pipeline.reset();
+    _candidateFilter.reset();
+    _candidates.clear();
+    _foreignDocs.clear();
+    _foreignDocsByHash.clear();
+    _unhashedForeignDocs.clear();
     pSource->dispose();
 }
 
@@ -359,7 +387,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
     // Loop until we get a document that has at least one match.
     // Note we may return early from this loop if our source stage is exhausted or if the unwind
     // source was asked to return empty arrays and we get a document without a match.
-    while (!_pipeline || !_nextValue) {
+    while (!_nextValue) {
         auto nextInput = pSource->getNext();
         if (!nextInput.isAdvanced()) {
             return nextInput;
@@ -370,12 +398,10 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
         BSONObj filter = _additionalFilter.value_or(BSONObj());
         auto matchStage =
             makeMatchStageFromInput(*_input, _localField, _foreignFieldFieldName, filter);
-        // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-        _fromPipeline.back() = matchStage;
-        _pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+        findForeignMatches(*_input, matchStage);
 
         _cursorIndex = 0;
-        _nextValue = _pipeline->getNext();
+        _nextValue = getNextForeignMatch();
 
         if (_unwindSrc->preserveNullAndEmptyArrays() && !_nextValue) {
             // There were no results for this cursor, but the $unwind was asked to preserve empty
@@ -393,7 +419,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
 
     invariant(bool(_input) && bool(_nextValue));
     auto currentValue = *_nextValue;
-    _nextValue = _pipeline->getNext();
+    _nextValue = getNextForeignMatch();
 
     // Move input document into output if this is the last or only result, otherwise perform a copy.
     MutableDocument output(_nextValue ? *_input : std::move(*_input));
@@ -407,6 +433,171 @@ DocumentSource::GetNextResult DocumentSourceLookUp::unwindResult() {
     return output.freeze();
 }
 
+DocumentSourceLookUp::JoinStrategy DocumentSourceLookUp::planJoinStrategy() const {
+    if (internalDocumentSourceLookupHashJoinMaxMemoryBytes <= 0) {
+        return JoinStrategy::kNestedLoop;
+    }
+
+    // If the foreign namespace is a view, a nested loop join would run the view's pipeline once for
+    // every input document.
+    if (_fromPipeline.size() > 1) {
+        return JoinStrategy::kHashJoin;
+    }
+
+    const long long dataSize = _mongod->getCollectionDataSize(_fromExpCtx->ns);
+    if (dataSize > internalDocumentSourceLookupHashJoinMaxMemoryBytes) {
+        return JoinStrategy::kNestedLoop;
+    }
+    if (dataSize <= internalDocumentSourceLookupHashJoinMaxIndexedCollectionBytes) {
+        return JoinStrategy::kHashJoin;
+    }
+
+    // Otherwise, only hash join if each query of a nested loop join would scan the whole foreign
+    // collection. Any non-partial index with 'foreignField' as its leading field can answer the
+    // equality predicates of those queries.
+    for (auto&& indexSpec : _mongod->getIndexSpecs(_fromExpCtx->ns)) {
+        if (indexSpec.hasField("partialFilterExpression")) {
+            continue;
+        }
+        const BSONElement leadingField = indexSpec.getObjectField("key").firstElement();
+        if (leadingField.fieldNameStringData() == _foreignFieldFieldName &&
+            (leadingField.isNumber() || leadingField.valueStringData() == "hashed")) {
+            return JoinStrategy::kNestedLoop;
+        }
+    }
+    return JoinStrategy::kHashJoin;
+}
+
+bool DocumentSourceLookUp::buildHashTable() {
+    invariant(_foreignDocs.empty());
+
+    // The hash table is built once for all input documents, so it can only apply the filter which
+    // does not depend on them.
+    _fromPipeline.back() = BSON("$match" << _additionalFilter.value_or(BSONObj()));
+    auto pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+
+    ElementPath foreignPath;
+    uassertStatusOK(foreignPath.init(_foreignFieldFieldName));
+    const BSONElementComparator hasher(BSONElementComparator::FieldNamesMode::kIgnore,
+                                       _fromExpCtx->getCollator());
+
+    long long memoryUsageBytes = 0;
+    while (auto result = pipeline->getNext()) {
+        BSONObj foreignDoc = result->toBson();
+        const size_t position = _foreignDocs.size();
+        memoryUsageBytes += foreignDoc.objsize();
+
+        // Index the document under every value the query {<foreignField>: {$eq: <value>}} would
+        // match it by, including array elements and the arrays themselves.
+        BSONElementIterator it(&foreignPath, foreignDoc);
+        while (it.more()) {
+            const BSONElement value = it.next().element();
+            std::vector<size_t>* positions;
+            if (value.eoo() || value.isNull() || value.type() == BSONType::Undefined) {
+                // Only nullish input values match these, and those are checked against every
+                // foreign document anyway.
+                continue;
+            } else if (value.type() == BSONType::Symbol) {
+                positions = &_unhashedForeignDocs;
+            } else {
+                positions = &_foreignDocsByHash[hasher.hash(value)];
+            }
+
+            if (positions->empty() || positions->back() != position) {
+                positions->push_back(position);
+                memoryUsageBytes += sizeof(size_t);
+            }
+        }
+        _foreignDocs.push_back(std::move(foreignDoc));
+
+        if (memoryUsageBytes > internalDocumentSourceLookupHashJoinMaxMemoryBytes) {
+            _foreignDocs.clear();
+            _foreignDocsByHash.clear();
+            _unhashedForeignDocs.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void DocumentSourceLookUp::findForeignMatches(const Document& input, const BSONObj& matchStage) {
+    if (!_joinStrategy) {
+        _joinStrategy = planJoinStrategy();
+        if (*_joinStrategy == JoinStrategy::kHashJoin && !buildHashTable()) {
+            _joinStrategy = JoinStrategy::kNestedLoop;
+        }
+    }
+
+    if (*_joinStrategy == JoinStrategy::kNestedLoop) {
+        // We've already allocated space for the trailing $match stage in '_fromPipeline'.
+        _fromPipeline.back() = matchStage;
+        _pipeline = uassertStatusOK(_mongod->makePipeline(_fromPipeline, _fromExpCtx));
+        return;
+    }
+
+    // The hash table only narrows down the foreign documents to those which may match. Each one is
+    // then checked against the same query a nested loop join would have run, so that both
+    // strategies produce the same results.
+    _candidateFilter = uassertStatusOK(
+        MatchExpressionParser::parse(matchStage.firstElement().embeddedObject(),
+                                     ExtensionsCallbackNoop(),
+                                     _fromExpCtx->getCollator()));
+    _candidates.clear();
+    _nextCandidate = 0;
+
+    const BSONElementComparator hasher(BSONElementComparator::FieldNamesMode::kIgnore,
+                                       _fromExpCtx->getCollator());
+    bool mustScanAll = false;
+    auto probe = [&](const Value& value) -> void {
+        // Nullish values also match foreign documents which are missing 'foreignField', and
+        // symbols compare equal to strings which may not hash alike, so neither can be looked up.
+        if (value.nullish() || value.getType() == BSONType::Symbol) {
+            mustScanAll = true;
+            return;
+        }
+        const BSONObj wrapped = BSON("" << value);
+        auto it = _foreignDocsByHash.find(hasher.hash(wrapped.firstElement()));
+        if (it != _foreignDocsByHash.end()) {
+            _candidates.insert(_candidates.end(), it->second.begin(), it->second.end());
+        }
+    };
+
+    const Value localValue = input.getNestedField(_localField);
+    if (localValue.isArray()) {
+        for (auto&& element : localValue.getArray()) {
+            probe(element);
+        }
+    } else {
+        probe(localValue);
+    }
+
+    if (mustScanAll) {
+        _candidates.resize(_foreignDocs.size());
+        std::iota(_candidates.begin(), _candidates.end(), 0);
+        return;
+    }
+
+    // Return the candidates in the order the foreign pipeline produced them, without duplicates.
+    _candidates.insert(
+        _candidates.end(), _unhashedForeignDocs.begin(), _unhashedForeignDocs.end());
+    std::sort(_candidates.begin(), _candidates.end());
+    _candidates.erase(std::unique(_candidates.begin(), _candidates.end()), _candidates.end());
+}
+
+boost::optional<Document> DocumentSourceLookUp::getNextForeignMatch() {
+    if (*_joinStrategy == JoinStrategy::kNestedLoop) {
+        return _pipeline->getNext();
+    }
+
+    while (_nextCandidate < _candidates.size()) {
+        const BSONObj& candidate = _foreignDocs[_candidates[_nextCandidate++]];
+        if (_candidateFilter->matchesBSON(candidate)) {
+            return Document(candidate);
+        }
+    }
+    return boost::none;
+}
+
 void DocumentSourceLookUp::serializeToArray(std::vector<Value>& array, bool explain) const {
     MutableDocument output(DOC(
         getSourceName() << DOC("from" << _fromNs.coll() << "as" << _as.fullPath() << "localField"
@@ -423,6 +614,14 @@ void DocumentSourceLookUp::serializeToArray(std::vector<Value>& array, bool expl
                           << (indexPath ? Value(indexPath->fullPath()) : Value())));
         }
 
+        // The join strategy is only chosen once there is input, so report the one which would be
+        // chosen if we have not run yet.
+        if (_joinStrategy || _mongod) {
+            const auto strategy = _joinStrategy ? *_joinStrategy : planJoinStrategy();
+            output[getSourceName()]["strategy"] =
+                Value(strategy == JoinStrategy::kHashJoin ? "hashJoin"_sd : "nestedLoop"_sd);
+        }
+
         if (_matchSrc) {
             // Our output does not have to be parseable, so include a "matching" field with the
             // descended match expression.
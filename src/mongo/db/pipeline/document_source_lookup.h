@@ -28,12 +28,14 @@
 
 #pragma once
 
+#include "mongo/db/matcher/expression.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -117,6 +119,14 @@ protected:
     void doInjectExpressionContext() final;
 
 private:
+    /**
+     * How documents from the foreign collection are found for each input document.
+     *  - kNestedLoop runs a query against the foreign collection for every input document.
+     *  - kHashJoin reads the foreign collection once, hashes each document on 'foreignField', and
+     *    probes the resulting table with the value of 'localField' of every input document.
+     */
+    enum class JoinStrategy { kNestedLoop, kHashJoin };
+
     DocumentSourceLookUp(NamespaceString fromNs,
                          std::string as,
                          std::string localField,
@@ -130,6 +140,30 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Picks a join strategy based on the size of the foreign collection and on whether it has an
+     * index which can answer the per-document queries of a nested loop join.
+     */
+    JoinStrategy planJoinStrategy() const;
+
+    /**
+     * Runs the foreign pipeline once and builds the hash table used by a hash join. Returns false,
+     * leaving the table empty, if the foreign documents do not fit in the memory budget.
+     */
+    bool buildHashTable();
+
+    /**
+     * Prepares to return the foreign documents matching 'input'. 'matchStage' is the $match stage
+     * built by makeMatchStageFromInput() for 'input'.
+     */
+    void findForeignMatches(const Document& input, const BSONObj& matchStage);
+
+    /**
+     * Returns the next foreign document matching the input passed to findForeignMatches(), or
+     * boost::none if there are no more.
+     */
+    boost::optional<Document> getNextForeignMatch();
+
     NamespaceString _fromNs;
     FieldPath _as;
     FieldPath _localField;
@@ -151,11 +185,30 @@ private:
     bool _handlingMatch = false;
 
     // The following members are used to hold onto state across getNext() calls when
-    // '_handlingUnwind' is true.
+    // '_handlingUnwind' is true. '_pipeline' is also used to find the matches for a single input
+    // document during a nested loop join.
     long long _cursorIndex = 0;
     boost::intrusive_ptr<Pipeline> _pipeline;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    // Chosen on the first call to getNext().
+    boost::optional<JoinStrategy> _joinStrategy;
+
+    // The following members are only used when '_joinStrategy' is kHashJoin. '_foreignDocs' holds
+    // the output of the foreign pipeline, and '_foreignDocsByHash' maps the hash of each value of
+    // '_foreignField' to the positions of the documents in '_foreignDocs' which hold that value.
+    // Documents whose values cannot be hashed consistently with the query semantics are instead
+    // tracked in '_unhashedForeignDocs', and are considered for every input document.
+    std::vector<BSONObj> _foreignDocs;
+    stdx::unordered_map<size_t, std::vector<size_t>> _foreignDocsByHash;
+    std::vector<size_t> _unhashedForeignDocs;
+
+    // The positions in '_foreignDocs' of the candidates for the current input document, and the
+    // filter they must pass to be joined with it.
+    std::vector<size_t> _candidates;
+    size_t _nextCandidate = 0;
+    std::unique_ptr<MatchExpression> _candidateFilter;
 };
 
 }  // namespace mongo
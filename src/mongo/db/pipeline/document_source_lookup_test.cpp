@@ -30,6 +30,8 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <deque>
+#include <list>
+#include <utility>
 #include <vector>
 
 #include "mongo/bson/bsonmisc.h"
@@ -135,17 +137,30 @@ TEST(MakeMatchStageFromInput, ArrayValueWithRegexUsesOrQuery) {
 //
 
 /**
- * A mock MongodInterface which allows mocking a foreign pipeline.
+ * A mock MongodInterface which allows mocking a foreign pipeline, along with the size and indexes
+ * of the foreign collection.
  */
 class MockMongodInterface final : public StubMongodInterface {
 public:
-    MockMongodInterface(deque<DocumentSource::GetNextResult> mockResults)
-        : _mockResults(std::move(mockResults)) {}
+    MockMongodInterface(deque<DocumentSource::GetNextResult> mockResults,
+                        long long dataSize = 0,
+                        std::list<BSONObj> indexSpecs = {})
+        : _mockResults(std::move(mockResults)),
+          _dataSize(dataSize),
+          _indexSpecs(std::move(indexSpecs)) {}
 
     bool isSharded(const NamespaceString& ns) final {
         return false;
     }
 
+    long long getCollectionDataSize(const NamespaceString& nss) final {
+        return _dataSize;
+    }
+
+    std::list<BSONObj> getIndexSpecs(const NamespaceString& nss) final {
+        return _indexSpecs;
+    }
+
     StatusWith<boost::intrusive_ptr<Pipeline>> makePipeline(
         const std::vector<BSONObj>& rawPipeline,
         const boost::intrusive_ptr<ExpressionContext>& expCtx) final {
@@ -163,6 +178,8 @@ public:
 
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
+    long long _dataSize;
+    std::list<BSONObj> _indexSpecs;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -270,6 +287,95 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     ASSERT_TRUE(lookup->getNext().isEOF());
 }
 
+/**
+ * Runs a $lookup of 'localDocs' against 'foreignDocs' on "local" and "foreign", and returns the
+ * join strategy reported by explain along with the results.
+ */
+std::pair<std::string, vector<Document>> runLookup(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    const std::shared_ptr<DocumentSourceNeedsMongod::MongodInterface>& mongod,
+    const vector<Document>& localDocs) {
+    NamespaceString fromNs("test", "foreign");
+    expCtx->resolvedNamespaces[fromNs.coll()] = {fromNs, std::vector<BSONObj>{}};
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "local"},
+                                         {"foreignField", "foreign"},
+                                         {"as", "joined"}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    deque<DocumentSource::GetNextResult> mockLocalContents;
+    for (auto&& doc : localDocs) {
+        mockLocalContents.emplace_back(Document(doc));
+    }
+    auto mockLocalSource = DocumentSourceMock::create(std::move(mockLocalContents));
+    lookup->setSource(mockLocalSource.get());
+    lookup->injectExpressionContext(expCtx);
+    lookup->injectMongodInterface(mongod);
+
+    vector<Value> explain;
+    lookup->serializeToArray(explain, true);
+    auto strategy = explain[0]["$lookup"]["strategy"].getString();
+
+    vector<Document> results;
+    for (auto next = lookup->getNext(); next.isAdvanced(); next = lookup->getNext()) {
+        results.push_back(next.releaseDocument());
+    }
+    return {strategy, results};
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinProducesSameResultsAsNestedLoopJoin) {
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{{"_id", 0}, {"foreign", 1}},
+        Document{{"_id", 1}, {"foreign", vector<Value>{Value(2), Value(3)}}},
+        Document{{"_id", 2}, {"foreign", 3LL}},
+        Document{{"_id", 3}},
+        Document{{"_id", 4}, {"foreign", BSONNULL}},
+        Document{{"_id", 5}, {"foreign", Document{{"a", 1}}}},
+        Document{{"_id", 6}, {"foreign", "abc"_sd}}};
+    vector<Document> localDocs{
+        Document{{"local", 1}},
+        Document{{"local", 3.0}},
+        Document{{"local", vector<Value>{Value(2), Value("abc"_sd)}}},
+        Document{{"local", vector<Value>{Value(vector<Value>{Value(2), Value(3)})}}},
+        Document{{"local", Document{{"a", 1}}}},
+        Document{{"local", BSONNULL}},
+        Document{},
+        Document{{"local", 7}}};
+
+    // The foreign collection is small, so it is hash joined even though it has an index.
+    const auto indexSpecs = std::list<BSONObj>{BSON("key" << BSON("foreign" << 1))};
+    auto hashJoin = runLookup(
+        getExpCtx(),
+        std::make_shared<MockMongodInterface>(mockForeignContents, 1024, indexSpecs),
+        localDocs);
+    ASSERT_EQ("hashJoin", hashJoin.first);
+
+    // A larger foreign collection is queried through its index once per input document instead.
+    auto nestedLoop = runLookup(
+        getExpCtx(),
+        std::make_shared<MockMongodInterface>(mockForeignContents, 10 * 1024 * 1024, indexSpecs),
+        localDocs);
+    ASSERT_EQ("nestedLoop", nestedLoop.first);
+
+    ASSERT_EQ(localDocs.size(), hashJoin.second.size());
+    ASSERT_EQ(localDocs.size(), nestedLoop.second.size());
+    for (size_t i = 0; i < localDocs.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(nestedLoop.second[i], hashJoin.second[i]);
+    }
+
+    // Numbers of different types are equal, and arrays are matched by each of their elements.
+    ASSERT_VALUE_EQ(hashJoin.second[1]["joined"],
+                    Value(vector<Value>{Value(mockForeignContents[1].getDocument()),
+                                        Value(mockForeignContents[2].getDocument())}));
+    // Null matches both null and missing values.
+    ASSERT_EQ(2U, hashJoin.second[5]["joined"].getArrayLength());
+    ASSERT_EQ(0U, hashJoin.second[7]["joined"].getArrayLength());
+}
+
 TEST_F(DocumentSourceLookUpTest, LookupReportsAsFieldIsModified) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
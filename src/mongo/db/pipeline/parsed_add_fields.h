@@ -115,7 +115,7 @@ public:
      */
     Document applyProjection(Document inputDoc) const final {
         _variables->setRoot(inputDoc);
-        return applyProjection(inputDoc, _variables.get());
+        return applyProjection(std::move(inputDoc), _variables.get());
     }
 
     Document applyProjection(Document inputDoc, Variables* vars) const;
@@ -152,10 +152,11 @@ public:
     }
 
     /**
-     * Apply the projection transformation.
+     * Apply the projection transformation. 'input' is moved along so that a projection which
+     * modifies a copy of it can do so in place when nothing else refers to it.
      */
     Document applyTransformation(Document input) {
-        return applyProjection(input);
+        return applyProjection(std::move(input));
     }
 
 protected:
@@ -66,12 +66,17 @@ void ExclusionNode::excludePath(FieldPath path) {
 }
 
 Document ExclusionNode::applyProjection(Document input) const {
-    MutableDocument output(input);
+    // Take over 'input' rather than copying it, so that if the caller moved in the only reference
+    // to its storage, fields are removed in place instead of from a clone of the storage.
+    MutableDocument output(std::move(input));
     for (auto&& field : _excludedFields) {
         output.remove(field);
     }
     for (auto&& childPair : _children) {
-        output[childPair.first] = childPair.second->applyProjectionToValue(input[childPair.first]);
+        // Read the child before writing it so that no other reference to the storage of
+        // 'output' is alive when it is written.
+        Value child = output.peek()[childPair.first];
+        output[childPair.first] = childPair.second->applyProjectionToValue(std::move(child));
     }
     return output.freeze();
 }
@@ -140,7 +145,7 @@ Document ParsedExclusionProjection::serialize(bool explain) const {
 }
 
 Document ParsedExclusionProjection::applyProjection(Document inputDoc) const {
-    return _root->applyProjection(inputDoc);
+    return _root->applyProjection(std::move(inputDoc));
 }
 
 void ParsedExclusionProjection::parse(const BSONObj& spec, ExclusionNode* node, size_t depth) {
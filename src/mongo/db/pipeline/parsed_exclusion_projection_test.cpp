@@ -298,6 +298,21 @@ TEST(ExclusionProjectionExecutionTest, ShouldAllowMixedNestedAndDottedFields) {
     ASSERT_DOCUMENT_EQ(result, expectedResult);
 }
 
+TEST(ExclusionProjectionExecutionTest, ShouldNotModifyInputDocumentWhichIsStillReferenced) {
+    ParsedExclusionProjection exclusion;
+    exclusion.parse(BSON("a" << false << "b.c" << false));
+
+    auto inputDoc = Document{{"a", 1}, {"b", Document{{"c", 2}, {"d", 3}}}, {"e", 4}};
+    auto result = exclusion.applyProjection(inputDoc);
+    ASSERT_DOCUMENT_EQ(result, (Document{{"b", Document{{"d", 3}}}, {"e", 4}}));
+    ASSERT_DOCUMENT_EQ(inputDoc,
+                       (Document{{"a", 1}, {"b", Document{{"c", 2}, {"d", 3}}}, {"e", 4}}));
+
+    // Moving in the only reference lets the fields be removed in place.
+    result = exclusion.applyProjection(std::move(inputDoc));
+    ASSERT_DOCUMENT_EQ(result, (Document{{"b", Document{{"d", 3}}}, {"e", 4}}));
+}
+
 TEST(ExclusionProjectionExecutionTest, ShouldAlwaysKeepMetadataFromOriginalDoc) {
     ParsedExclusionProjection exclusion;
     exclusion.parse(BSON("a" << false));
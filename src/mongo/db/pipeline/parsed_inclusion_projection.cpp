@@ -132,7 +132,7 @@ void InclusionNode::applyInclusions(Document inputDoc, MutableDocument* outputDo
 
 Value InclusionNode::applyInclusionsToValue(Value inputValue) const {
     if (inputValue.getType() == BSONType::Object) {
-        MutableDocument output;
+        MutableDocument output(maxOutputFields());
         applyInclusions(inputValue.getDocument(), &output);
         return output.freezeToValue();
     } else if (inputValue.getType() == BSONType::Array) {
@@ -333,7 +333,7 @@ Document ParsedInclusionProjection::applyProjection(Document inputDoc, Variables
     // transformations have been applied.
     vars->setRoot(inputDoc);
 
-    MutableDocument output;
+    MutableDocument output(_root->maxOutputFields());
     _root->applyInclusions(inputDoc, &output);
     _root->addComputedFields(&output, vars);
 
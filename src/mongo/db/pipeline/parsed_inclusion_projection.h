@@ -119,6 +119,14 @@ public:
         return _pathToNode;
     }
 
+    /**
+     * Returns the most fields applyInclusions() and addComputedFields() can add at this level, so
+     * that the output document can be allocated once at its final size.
+     */
+    size_t maxOutputFields() const {
+        return _inclusions.size() + _children.size() + _expressions.size();
+    }
+
     void injectExpressionContext(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     /**
@@ -236,7 +244,7 @@ public:
      */
     Document applyProjection(Document inputDoc) const final {
         _variables->setRoot(inputDoc);
-        return applyProjection(inputDoc, _variables.get());
+        return applyProjection(std::move(inputDoc), _variables.get());
     }
 
     Document applyProjection(Document inputDoc, Variables* vars) const;
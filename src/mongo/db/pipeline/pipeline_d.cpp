@@ -37,6 +37,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
@@ -47,9 +48,12 @@
 #include "mongo/db/exec/shard_filter.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_merge_cursors.h"
 #include "mongo/db/pipeline/document_source_sample.h"
@@ -58,6 +62,7 @@
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/parsed_distinct.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -135,6 +140,16 @@ public:
         return appendCollectionStorageStats(_ctx->opCtx, nss, param, builder);
     }
 
+    long long getCollectionDataSize(const NamespaceString& nss) final {
+        AutoGetCollectionForRead autoColl(_ctx->opCtx, nss);
+        Collection* collection = autoColl.getCollection();
+        return collection ? collection->dataSize(_ctx->opCtx) : 0;
+    }
+
+    std::list<BSONObj> getIndexSpecs(const NamespaceString& nss) final {
+        return _client.getIndexSpecs(nss.ns());
+    }
+
     BSONObj getCollectionOptions(const NamespaceString& nss) final {
         const auto infos =
             _client.getCollectionInfos(nss.db().toString(), BSON("name" << nss.coll()));
@@ -314,6 +329,91 @@ StatusWith<std::unique_ptr<PlanExecutor>> attemptToGetExecutor(
     return getExecutor(
         txn, collection, std::move(cq.getValue()), PlanExecutor::YIELD_AUTO, plannerOpts);
 }
+
+bool hasStageOfType(PlanStage* root, StageType type) {
+    if (root->stageType() == type) {
+        return true;
+    }
+    for (auto&& child : root->getChildren()) {
+        if (hasStageOfType(child.get(), type)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * If the pipeline starts with a $group that only collects the distinct values of a single field,
+ * such as {$group: {_id: "$a"}}, attempts to build a plan that uses a DISTINCT_SCAN to produce one
+ * result per distinct value of that field. The $group stays in the pipeline and groups the already
+ * distinct results. Returns nullptr if no such plan is possible.
+ */
+std::unique_ptr<PlanExecutor> attemptToGetDistinctExecutor(
+    OperationContext* txn,
+    Collection* collection,
+    const intrusive_ptr<ExpressionContext>& pExpCtx,
+    const Pipeline::SourceContainer& sources,
+    const BSONObj& queryObj,
+    const size_t plannerOpts) {
+    // The distinct path neither filters out orphans nor compares with the pipeline's collator.
+    if (!collection || sources.empty() || pExpCtx->getCollator() ||
+        (plannerOpts & QueryPlannerParams::INCLUDE_SHARD_FILTER) ||
+        DocumentSourceMatch::isTextQuery(queryObj)) {
+        return nullptr;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (!groupStage) {
+        return nullptr;
+    }
+
+    const auto distinctKey = groupStage->getDistinctGroupKey();
+    if (!distinctKey) {
+        return nullptr;
+    }
+
+    // A distinct scan returns each element of an array separately and cannot see documents
+    // missing from a sparse index, whereas $group needs whole arrays and groups missing values
+    // under null. Only use it when every index on the field rules out both.
+    bool hasIndexOnKey = false;
+    IndexCatalog::IndexIterator ii = collection->getIndexCatalog()->getIndexIterator(txn, false);
+    while (ii.more()) {
+        const IndexDescriptor* desc = ii.next();
+        if (!desc->keyPattern().hasField(*distinctKey)) {
+            continue;
+        }
+        if (desc->isMultikey(txn) || desc->isSparse() ||
+            !IndexNames::findPluginName(desc->keyPattern()).empty()) {
+            return nullptr;
+        }
+        hasIndexOnKey = true;
+    }
+    if (!hasIndexOnKey) {
+        return nullptr;
+    }
+
+    auto qr = stdx::make_unique<QueryRequest>(pExpCtx->ns);
+    qr->setFilter(queryObj);
+    qr->setCollation(pExpCtx->collation);
+
+    const ExtensionsCallbackReal extensionsCallback(txn, &pExpCtx->ns);
+    auto cq = CanonicalQuery::canonicalize(txn, std::move(qr), extensionsCallback);
+    if (!cq.isOK()) {
+        return nullptr;
+    }
+
+    ParsedDistinct parsedDistinct(std::move(cq.getValue()), *distinctKey);
+    auto exec = getExecutorDistinct(
+        txn, collection, pExpCtx->ns.ns(), &parsedDistinct, PlanExecutor::YIELD_AUTO);
+
+    // getExecutorDistinct() falls back to a regular plan when it cannot use a distinct scan. The
+    // caller can plan that better itself, e.g. with a covered projection.
+    if (!exec.isOK() || !hasStageOfType(exec.getValue()->getRootStage(), STAGE_DISTINCT_SCAN)) {
+        return nullptr;
+    }
+
+    return std::move(exec.getValue());
+}
 }  // namespace
 
 void PipelineD::prepareCursorSource(Collection* collection,
@@ -473,6 +573,13 @@ StatusWith<std::unique_ptr<PlanExecutor>> PipelineD::prepareExecutor(
         plannerOpts |= QueryPlannerParams::NO_UNCOVERED_PROJECTIONS;
     }
 
+    if (!sortStage) {
+        if (auto exec = attemptToGetDistinctExecutor(
+                txn, collection, expCtx, pipeline->_sources, queryObj, plannerOpts)) {
+            return std::move(exec);
+        }
+    }
+
     BSONObj emptyProjection;
     if (sortStage) {
         // See if the query system can provide a non-blocking sort.
@@ -75,6 +75,14 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    long long getCollectionDataSize(const NamespaceString& nss) override {
+        MONGO_UNREACHABLE;
+    }
+
+    std::list<BSONObj> getIndexSpecs(const NamespaceString& nss) override {
+        MONGO_UNREACHABLE;
+    }
+
     BSONObj getCollectionOptions(const NamespaceString& nss) override {
         MONGO_UNREACHABLE;
     }
@@ -0,0 +1,225 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/collection_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace dps = ::mongo::dotted_path_support;
+
+namespace {
+
+int compareValues(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.woCompare(rhs, false);
+}
+
+bool valueLessThan(const BSONObj& lhs, const BSONObj& rhs) {
+    return compareValues(lhs.firstElement(), rhs.firstElement()) < 0;
+}
+
+}  // namespace
+
+FieldHistogram FieldHistogram::build(const std::vector<BSONObj>& sortedValues,
+                                     double scale,
+                                     size_t maxBuckets) {
+    invariant(maxBuckets > 0);
+
+    FieldHistogram histogram;
+    const size_t numValues = sortedValues.size();
+    if (numValues == 0) {
+        return histogram;
+    }
+    dassert(std::is_sorted(sortedValues.begin(), sortedValues.end(), valueLessThan));
+
+    histogram._lowerBound = sortedValues.front();
+    histogram._totalCount = numValues * scale;
+
+    const double singletonDistinct = std::sqrt(std::max(scale, 1.0));
+    const size_t bucketDepth = std::max<size_t>(1, (numValues + maxBuckets - 1) / maxBuckets);
+
+    Bucket current;
+    size_t currentSampled = 0;
+    size_t runStart = 0;
+    while (runStart < numValues) {
+        const BSONElement value = sortedValues[runStart].firstElement();
+        size_t runEnd = runStart + 1;
+        while (runEnd < numValues &&
+               compareValues(sortedValues[runEnd].firstElement(), value) == 0) {
+            ++runEnd;
+        }
+        const size_t runLength = runEnd - runStart;
+        const double runDistinct = (runLength == 1) ? singletonDistinct : 1.0;
+        histogram._distinctCount += runDistinct;
+
+        if (currentSampled + runLength >= bucketDepth || runEnd == numValues) {
+            // This value closes the bucket and gets an exact count of its own.
+            current.upperBound = sortedValues[runStart];
+            current.equalCount = runLength * scale;
+            histogram._buckets.push_back(current);
+            current = Bucket();
+            currentSampled = 0;
+        } else {
+            current.rangeCount += runLength * scale;
+            current.rangeDistinct += runDistinct;
+            currentSampled += runLength;
+        }
+        runStart = runEnd;
+    }
+
+    histogram._distinctCount = std::min(histogram._distinctCount, histogram._totalCount);
+    return histogram;
+}
+
+double FieldHistogram::estimateCount(const Interval& interval) const {
+    if (_buckets.empty()) {
+        return 0;
+    }
+
+    BSONElement low = interval.start;
+    BSONElement high = interval.end;
+    bool lowInclusive = interval.startInclusive;
+    bool highInclusive = interval.endInclusive;
+    if (compareValues(low, high) > 0) {
+        std::swap(low, high);
+        std::swap(lowInclusive, highInclusive);
+    }
+
+    const bool isPoint = compareValues(low, high) == 0;
+    if (isPoint && !(lowInclusive && highInclusive)) {
+        return 0;
+    }
+
+    auto contains = [&](const BSONElement& value) {
+        const int cmpLow = compareValues(low, value);
+        const int cmpHigh = compareValues(value, high);
+        return (cmpLow < 0 || (cmpLow == 0 && lowInclusive)) &&
+            (cmpHigh < 0 || (cmpHigh == 0 && highInclusive));
+    };
+
+    double count = 0;
+    BSONElement previousBound = _lowerBound.firstElement();
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+        const Bucket& bucket = _buckets[i];
+        const BSONElement upperBound = bucket.upperBound.firstElement();
+
+        if (contains(upperBound)) {
+            count += bucket.equalCount;
+        }
+
+        if (bucket.rangeCount > 0) {
+            if (isPoint) {
+                // Assume the values in the range are spread evenly over its distinct values. The
+                // first bucket's range also covers its lower bound.
+                const int cmpPrevious = compareValues(low, previousBound);
+                if ((cmpPrevious > 0 || (cmpPrevious == 0 && i == 0)) &&
+                    compareValues(low, upperBound) < 0) {
+                    count += bucket.rangeCount / std::max(bucket.rangeDistinct, 1.0);
+                }
+            } else if (compareValues(low, upperBound) < 0 &&
+                       compareValues(high, previousBound) > 0) {
+                // Count half of a range which the interval only partially covers.
+                const bool covered = compareValues(low, previousBound) <= 0 &&
+                    compareValues(high, upperBound) >= 0;
+                count += covered ? bucket.rangeCount : bucket.rangeCount / 2;
+            }
+        }
+
+        previousBound = upperBound;
+    }
+
+    return count;
+}
+
+double FieldHistogram::estimateSelectivity(const OrderedIntervalList& oil) const {
+    if (_totalCount <= 0) {
+        return 1.0;
+    }
+
+    double count = 0;
+    for (const Interval& interval : oil.intervals) {
+        count += estimateCount(interval);
+    }
+    return std::min(count / _totalCount, 1.0);
+}
+
+CollectionStatistics::CollectionStatistics(long long numRecords, Date_t buildTime)
+    : _numRecords(numRecords), _buildTime(buildTime) {}
+
+const FieldHistogram* CollectionStatistics::getHistogram(StringData path) const {
+    auto it = _histograms.find(path.toString());
+    return (it == _histograms.end()) ? nullptr : &it->second;
+}
+
+CollectionStatistics::Builder::Builder(std::set<std::string> fields) {
+    for (auto&& field : fields) {
+        _values[field];
+    }
+}
+
+void CollectionStatistics::Builder::addDocument(const BSONObj& doc) {
+    ++_numSampled;
+    for (auto&& entry : _values) {
+        BSONElementSet elements;
+        dps::extractAllElementsAlongPath(doc, entry.first, elements);
+        if (elements.empty()) {
+            entry.second.push_back(BSON("" << BSONNULL));
+            continue;
+        }
+
+        for (auto&& elem : elements) {
+            BSONObjBuilder bob;
+            bob.appendAs(elem, "");
+            entry.second.push_back(bob.obj());
+        }
+    }
+}
+
+std::unique_ptr<CollectionStatistics> CollectionStatistics::Builder::done(long long numRecords,
+                                                                          Date_t buildTime,
+                                                                          size_t maxBuckets) {
+    std::unique_ptr<CollectionStatistics> stats(new CollectionStatistics(numRecords, buildTime));
+
+    const double scale =
+        (_numSampled > 0) ? static_cast<double>(numRecords) / _numSampled : 0.0;
+    for (auto&& entry : _values) {
+        std::sort(entry.second.begin(), entry.second.end(), valueLessThan);
+        stats->_histograms[entry.first] = FieldHistogram::build(entry.second, scale, maxBuckets);
+    }
+    return stats;
+}
+
+}  // namespace mongo
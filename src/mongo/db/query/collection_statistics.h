@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * An equi-depth histogram over the values of a single field, built from a sample of a
+ * collection and scaled up to the size of the whole collection.
+ *
+ * Each bucket covers the values between the previous bucket's upper bound (exclusive) and its
+ * own upper bound (inclusive), and separately counts the values equal to its upper bound, so
+ * that frequent values end up with exact counts of their own. The first bucket also covers the
+ * smallest sampled value.
+ *
+ * Distinct counts are estimated from the sample with the GEE estimator: a value seen once in the
+ * sample stands for sqrt(total / sampled) distinct values of the collection, and a value seen
+ * more than once stands for itself.
+ */
+class FieldHistogram {
+public:
+    struct Bucket {
+        // Single-element object with an empty field name.
+        BSONObj upperBound;
+
+        // Estimated number of values strictly between the previous bound and 'upperBound'.
+        double rangeCount = 0;
+
+        // Estimated number of distinct values among those counted by 'rangeCount'.
+        double rangeDistinct = 0;
+
+        // Estimated number of values equal to 'upperBound'.
+        double equalCount = 0;
+    };
+
+    /**
+     * Builds a histogram with at most 'maxBuckets' buckets. 'sortedValues' holds single-element
+     * objects with empty field names, in ascending order. Every sampled value is counted as
+     * 'scale' values of the collection.
+     */
+    static FieldHistogram build(const std::vector<BSONObj>& sortedValues,
+                                double scale,
+                                size_t maxBuckets);
+
+    /**
+     * Returns the estimated number of values in the collection that fall within 'interval'. The
+     * interval may be in either direction.
+     */
+    double estimateCount(const Interval& interval) const;
+
+    /**
+     * Returns the estimated fraction of the field's values that fall within 'oil'.
+     */
+    double estimateSelectivity(const OrderedIntervalList& oil) const;
+
+    double getTotalCount() const {
+        return _totalCount;
+    }
+
+    double getDistinctCount() const {
+        return _distinctCount;
+    }
+
+    const std::vector<Bucket>& getBuckets() const {
+        return _buckets;
+    }
+
+private:
+    // The smallest sampled value, which is the lower bound of the first bucket.
+    BSONObj _lowerBound;
+    std::vector<Bucket> _buckets;
+    double _totalCount = 0;
+    double _distinctCount = 0;
+};
+
+/**
+ * Sampled statistics about a collection, used by the planner to estimate the cost of candidate
+ * plans. Holds a FieldHistogram for each indexed field. Instances are immutable once built, so
+ * they can be shared between concurrent queries.
+ */
+class CollectionStatistics {
+public:
+    /**
+     * Accumulates sampled documents and builds CollectionStatistics for 'fields' from them.
+     */
+    class Builder {
+    public:
+        explicit Builder(std::set<std::string> fields);
+
+        /**
+         * Adds the values of each tracked field in 'doc' to the sample. Array values contribute
+         * each of their elements, like they do to index keys, and a missing field counts as null.
+         */
+        void addDocument(const BSONObj& doc);
+
+        /**
+         * Builds the statistics, scaling the sample up to 'numRecords' documents.
+         */
+        std::unique_ptr<CollectionStatistics> done(long long numRecords,
+                                                   Date_t buildTime,
+                                                   size_t maxBuckets);
+
+    private:
+        std::map<std::string, std::vector<BSONObj>> _values;
+        long long _numSampled = 0;
+    };
+
+    long long getNumRecords() const {
+        return _numRecords;
+    }
+
+    Date_t getBuildTime() const {
+        return _buildTime;
+    }
+
+    /**
+     * Returns the histogram for 'path', or nullptr if the field was not sampled.
+     */
+    const FieldHistogram* getHistogram(StringData path) const;
+
+private:
+    CollectionStatistics(long long numRecords, Date_t buildTime);
+
+    long long _numRecords;
+    Date_t _buildTime;
+    std::map<std::string, FieldHistogram> _histograms;
+};
+
+}  // namespace mongo
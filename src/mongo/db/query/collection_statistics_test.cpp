@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for mongo/db/query/collection_statistics.cpp
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/unittest/unittest.h"
+
+using namespace mongo;
+
+namespace {
+
+const size_t kMaxBuckets = 64;
+
+std::unique_ptr<CollectionStatistics> buildStatistics(const std::vector<BSONObj>& docs,
+                                                      long long numRecords) {
+    CollectionStatistics::Builder builder({"a"});
+    for (auto&& doc : docs) {
+        builder.addDocument(doc);
+    }
+    return builder.done(numRecords, Date_t(), kMaxBuckets);
+}
+
+double estimatePoint(const FieldHistogram& histogram, int value) {
+    return histogram.estimateCount(Interval(BSON("" << value << "" << value), true, true));
+}
+
+TEST(CollectionStatisticsTest, UniformValues) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 1000; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    auto stats = buildStatistics(docs, 1000);
+    ASSERT_EQUALS(1000, stats->getNumRecords());
+
+    const FieldHistogram* histogram = stats->getHistogram("a");
+    ASSERT(histogram);
+    ASSERT_LTE(histogram->getBuckets().size(), kMaxBuckets);
+    ASSERT_APPROX_EQUAL(1000, histogram->getTotalCount(), 0.001);
+    ASSERT_APPROX_EQUAL(1000, histogram->getDistinctCount(), 0.001);
+
+    ASSERT_APPROX_EQUAL(1, estimatePoint(*histogram, 500), 0.001);
+    ASSERT_APPROX_EQUAL(
+        100, histogram->estimateCount(Interval(BSON("" << 100 << "" << 199), true, true)), 16);
+
+    // Bounds over a descending index run from high to low.
+    ASSERT_EQUALS(histogram->estimateCount(Interval(BSON("" << 100 << "" << 199), true, true)),
+                  histogram->estimateCount(Interval(BSON("" << 199 << "" << 100), true, true)));
+
+    // Values outside of the sampled range.
+    ASSERT_EQUALS(0, estimatePoint(*histogram, 5000));
+    ASSERT_EQUALS(0, histogram->estimateCount(Interval(BSON("" << "a" << "" << "z"), true, true)));
+}
+
+TEST(CollectionStatisticsTest, FrequentValueGetsExactCount) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 900; ++i) {
+        docs.push_back(BSON("a" << 5));
+    }
+    for (int i = 100; i < 200; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    auto stats = buildStatistics(docs, 1000);
+    const FieldHistogram* histogram = stats->getHistogram("a");
+    ASSERT(histogram);
+
+    ASSERT_APPROX_EQUAL(900, estimatePoint(*histogram, 5), 0.001);
+    ASSERT_APPROX_EQUAL(1, estimatePoint(*histogram, 150), 0.001);
+
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(Interval(BSON("" << 0 << "" << 50), true, true));
+    ASSERT_APPROX_EQUAL(0.9, histogram->estimateSelectivity(oil), 0.01);
+}
+
+TEST(CollectionStatisticsTest, SampleIsScaledToCollection) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON("a" << i % 10));
+    }
+    auto stats = buildStatistics(docs, 10000);
+    const FieldHistogram* histogram = stats->getHistogram("a");
+    ASSERT(histogram);
+
+    ASSERT_APPROX_EQUAL(10000, histogram->getTotalCount(), 0.001);
+    ASSERT_APPROX_EQUAL(10, histogram->getDistinctCount(), 0.001);
+    ASSERT_APPROX_EQUAL(1000, estimatePoint(*histogram, 3), 0.001);
+}
+
+TEST(CollectionStatisticsTest, SingletonsStandForUnsampledDistinctValues) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON("a" << i));
+    }
+    auto stats = buildStatistics(docs, 10000);
+    const FieldHistogram* histogram = stats->getHistogram("a");
+    ASSERT(histogram);
+
+    // Each of the 100 values seen once stands for sqrt(10000 / 100) distinct values.
+    ASSERT_APPROX_EQUAL(1000, histogram->getDistinctCount(), 0.001);
+}
+
+TEST(CollectionStatisticsTest, ArraysAndMissingFieldsCountLikeIndexKeys) {
+    auto stats =
+        buildStatistics({BSON("a" << BSON_ARRAY(1 << 2)), BSON("b" << 1), BSON("a" << 1)}, 3);
+    const FieldHistogram* histogram = stats->getHistogram("a");
+    ASSERT(histogram);
+
+    ASSERT_APPROX_EQUAL(4, histogram->getTotalCount(), 0.001);
+    ASSERT_APPROX_EQUAL(2, estimatePoint(*histogram, 1), 0.001);
+    ASSERT_APPROX_EQUAL(1, estimatePoint(*histogram, 2), 0.001);
+    ASSERT_APPROX_EQUAL(
+        1, histogram->estimateCount(Interval(BSON("" << BSONNULL << "" << BSONNULL), true, true)),
+        0.001);
+
+    ASSERT_FALSE(stats->getHistogram("b"));
+}
+
+}  // namespace
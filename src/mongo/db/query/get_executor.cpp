@@ -64,6 +64,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cost_model.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
@@ -223,6 +224,34 @@ struct PrepareExecutionResult {
     unique_ptr<PlanStage> root;
 };
 
+/**
+ * Returns the position in 'solutions' of a plan which the collection's statistics show to be
+ * much cheaper than the others, or boost::none if the plans should be ranked by running them.
+ */
+boost::optional<size_t> chooseSolutionByCost(OperationContext* opCtx,
+                                             Collection* collection,
+                                             const CanonicalQuery& canonicalQuery,
+                                             const vector<QuerySolution*>& solutions) {
+    if (!internalQueryPlannerEnableCostBasedSelection.load()) {
+        return boost::none;
+    }
+
+    // A plan which can stop early, after producing enough results, may win the trial even though
+    // it would be expensive to run to completion. The cost model does not account for that.
+    const QueryRequest& qr = canonicalQuery.getQueryRequest();
+    if (qr.getLimit() || qr.getNToReturn() || qr.isTailable()) {
+        return boost::none;
+    }
+
+    auto stats = collection->infoCache()->getStatistics(opCtx);
+    if (!stats) {
+        return boost::none;
+    }
+
+    return PlanCostModel(*stats).chooseSolution(
+        solutions, internalQueryPlannerCostBasedConfidenceRatio.load());
+}
+
 /**
  * Build an execution tree for the query described in 'canonicalQuery'.
  *
@@ -430,6 +459,27 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         querySolution.reset(solutions[0]);
         return PrepareExecutionResult(
             std::move(canonicalQuery), std::move(querySolution), std::move(root));
+    } else if (auto chosen = chooseSolutionByCost(opCtx, collection, *canonicalQuery, solutions)) {
+        // The statistics single out one plan, so run it without a trial period. Since it was not
+        // ranked against the other plans, it is not cached.
+        for (size_t ix = 0; ix < solutions.size(); ++ix) {
+            if (ix != *chosen) {
+                delete solutions[ix];
+            }
+        }
+
+        PlanStage* rawRoot;
+        verify(StageBuilder::build(
+            opCtx, collection, *canonicalQuery, *solutions[*chosen], ws, &rawRoot));
+        root.reset(rawRoot);
+
+        LOG(2) << "Chose plan by estimated cost; it will be run but will not be cached. "
+               << redact(canonicalQuery->toStringShort())
+               << ", planSummary: " << redact(Explain::getPlanSummary(root.get()));
+
+        querySolution.reset(solutions[*chosen]);
+        return PrepareExecutionResult(
+            std::move(canonicalQuery), std::move(querySolution), std::move(root));
     } else {
         // Many solutions. Create a MultiPlanStage to pick the best, update the cache,
         // and so on. The working set will be shared by all candidate plans.
@@ -624,6 +674,9 @@ StatusWith<unique_ptr<PlanExecutor>> getExecutorFind(OperationContext* txn,
     if (ShardingState::get(txn)->needCollectionMetadata(txn, nss.ns())) {
         options |= QueryPlannerParams::INCLUDE_SHARD_FILTER;
     }
+    if (internalQueryExecBlockingSortAllowDiskUse) {
+        options |= QueryPlannerParams::ALLOW_EXTERNAL_SORT;
+    }
     return getExecutor(
         txn, collection, std::move(canonicalQuery), PlanExecutor::YIELD_AUTO, options);
 }
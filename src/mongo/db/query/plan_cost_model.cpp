@@ -0,0 +1,230 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+
+namespace {
+
+// Every plan pays for setting up its stages, which keeps costs positive on empty collections.
+const double kPlanStartupCost = 1.0;
+
+// Reading the next document of a collection scan and matching it against the query.
+const double kCollScanDocCost = 1.0;
+
+// Examining one index key.
+const double kIndexKeyCost = 0.5;
+
+// Positioning an index cursor at the start of an interval.
+const double kIndexSeekCost = 2.0;
+
+// Fetching one document by RecordId, which is a random rather than a sequential read.
+const double kFetchDocCost = 2.0;
+
+// Per comparison of a blocking sort.
+const double kSortCompareCost = 0.1;
+
+bool isAllValues(const OrderedIntervalList& oil) {
+    if (oil.intervals.size() != 1) {
+        return false;
+    }
+    const Interval& interval = oil.intervals[0];
+    return (interval.start.type() == MinKey && interval.end.type() == MaxKey) ||
+        (interval.start.type() == MaxKey && interval.end.type() == MinKey);
+}
+
+}  // namespace
+
+PlanCostModel::PlanCostModel(const CollectionStatistics& stats) : _stats(stats) {}
+
+boost::optional<double> PlanCostModel::estimateCost(const QuerySolution& soln) const {
+    if (!soln.root) {
+        return boost::none;
+    }
+
+    auto estimate = _estimate(soln.root.get());
+    if (!estimate) {
+        return boost::none;
+    }
+    return kPlanStartupCost + estimate->cost;
+}
+
+boost::optional<size_t> PlanCostModel::chooseSolution(const std::vector<QuerySolution*>& solutions,
+                                                      double confidenceRatio) const {
+    if (solutions.empty()) {
+        return boost::none;
+    }
+
+    std::vector<double> costs;
+    for (auto&& soln : solutions) {
+        auto cost = estimateCost(*soln);
+        if (!cost) {
+            return boost::none;
+        }
+        costs.push_back(*cost);
+    }
+
+    const size_t best = std::min_element(costs.begin(), costs.end()) - costs.begin();
+    for (size_t i = 0; i < costs.size(); ++i) {
+        if (i != best && costs[i] < costs[best] * confidenceRatio) {
+            return boost::none;
+        }
+    }
+    return best;
+}
+
+boost::optional<PlanCostModel::Estimate> PlanCostModel::_estimate(
+    const QuerySolutionNode* node) const {
+    const double numRecords = _stats.getNumRecords();
+
+    std::vector<Estimate> children;
+    for (auto&& child : node->children) {
+        auto childEstimate = _estimate(child);
+        if (!childEstimate) {
+            return boost::none;
+        }
+        children.push_back(*childEstimate);
+    }
+
+    switch (node->getType()) {
+        case STAGE_COLLSCAN:
+            return Estimate{numRecords * kCollScanDocCost, numRecords};
+
+        case STAGE_IXSCAN: {
+            auto ixscan = static_cast<const IndexScanNode*>(node);
+            auto selectivity = _estimateIndexScanSelectivity(ixscan);
+            if (!selectivity) {
+                return boost::none;
+            }
+            const double numKeys = *selectivity * numRecords;
+            double numSeeks = 1;
+            for (auto&& oil : ixscan->bounds.fields) {
+                numSeeks *= oil.intervals.size();
+            }
+            return Estimate{std::min(numSeeks, numKeys + 1) * kIndexSeekCost +
+                                numKeys * kIndexKeyCost,
+                            numKeys};
+        }
+
+        case STAGE_FETCH:
+            invariant(children.size() == 1);
+            return Estimate{children[0].cost + children[0].numResults * kFetchDocCost,
+                            children[0].numResults};
+
+        case STAGE_SORT: {
+            invariant(children.size() == 1);
+            double numResults = children[0].numResults;
+            auto sort = static_cast<const SortNode*>(node);
+            if (sort->limit > 0) {
+                numResults = std::min(numResults, static_cast<double>(sort->limit));
+            }
+            return Estimate{children[0].cost +
+                                children[0].numResults * std::log2(children[0].numResults + 1) *
+                                    kSortCompareCost,
+                            numResults};
+        }
+
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED: {
+            Estimate estimate{0, numRecords};
+            for (auto&& child : children) {
+                estimate.cost += child.cost;
+                estimate.numResults = std::min(estimate.numResults, child.numResults);
+            }
+            return estimate;
+        }
+
+        case STAGE_OR:
+        case STAGE_SORT_MERGE: {
+            Estimate estimate{0, 0};
+            for (auto&& child : children) {
+                estimate.cost += child.cost;
+                estimate.numResults += child.numResults;
+            }
+            estimate.numResults = std::min(estimate.numResults, numRecords);
+            return estimate;
+        }
+
+        case STAGE_KEEP_MUTATIONS:
+        case STAGE_PROJECTION:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_SKIP:
+        case STAGE_SORT_KEY_GENERATOR:
+            // These stages do a small, similar amount of work in every candidate plan.
+            invariant(children.size() == 1);
+            return children[0];
+
+        default:
+            return boost::none;
+    }
+}
+
+boost::optional<double> PlanCostModel::_estimateIndexScanSelectivity(
+    const IndexScanNode* node) const {
+    const IndexEntry& index = node->index;
+    if (index.type != INDEX_BTREE || index.sparse || index.filterExpr || index.collator ||
+        node->bounds.isSimpleRange) {
+        return boost::none;
+    }
+
+    // The histograms count every element of an array value, so they describe index keys rather
+    // than documents once a field holds arrays. A scan of a multikey index would then be costed
+    // as if each of its documents had a single key.
+    if (index.multikey) {
+        return boost::none;
+    }
+
+    // Treat the fields of a compound index as independent of each other.
+    double selectivity = 1.0;
+    BSONObjIterator keyPatternIt(index.keyPattern);
+    for (auto&& oil : node->bounds.fields) {
+        invariant(keyPatternIt.more());
+        const BSONElement keyPatternElt = keyPatternIt.next();
+        if (isAllValues(oil)) {
+            continue;
+        }
+
+        const FieldHistogram* histogram = _stats.getHistogram(keyPatternElt.fieldNameStringData());
+        if (!histogram) {
+            return boost::none;
+        }
+        selectivity *= histogram->estimateSelectivity(oil);
+    }
+    return selectivity;
+}
+
+}  // namespace mongo
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+namespace mongo {
+
+class CollectionStatistics;
+struct IndexScanNode;
+struct QuerySolution;
+struct QuerySolutionNode;
+
+/**
+ * Estimates the cost of executing a QuerySolution from sampled CollectionStatistics, so that the
+ * planner can pick between candidate plans without trying them out in a MultiPlanStage.
+ *
+ * Costs are in units of one document read by a collection scan. Only the stages which appear in
+ * plans for ordinary find queries can be costed, and index scans can only be costed over
+ * non-sparse, non-partial, non-multikey btree indexes without a collation, which have one key per
+ * document matching its sampled value.
+ */
+class PlanCostModel {
+public:
+    explicit PlanCostModel(const CollectionStatistics& stats);
+
+    /**
+     * Returns the estimated cost of 'soln', or boost::none if some part of it cannot be costed.
+     */
+    boost::optional<double> estimateCost(const QuerySolution& soln) const;
+
+    /**
+     * Returns the position in 'solutions' of the cheapest plan, as long as every plan can be
+     * costed and every other plan is estimated to be at least 'confidenceRatio' times as
+     * expensive. Otherwise returns boost::none, and the plans should be compared by running them.
+     */
+    boost::optional<size_t> chooseSolution(const std::vector<QuerySolution*>& solutions,
+                                           double confidenceRatio) const;
+
+private:
+    struct Estimate {
+        double cost;
+        double numResults;
+    };
+
+    boost::optional<Estimate> _estimate(const QuerySolutionNode* node) const;
+
+    boost::optional<double> _estimateIndexScanSelectivity(const IndexScanNode* node) const;
+
+    const CollectionStatistics& _stats;
+};
+
+}  // namespace mongo
@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for mongo/db/query/plan_cost_model.cpp
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/collection_statistics.h"
+#include "mongo/db/query/plan_cost_model.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/unittest/unittest.h"
+
+using namespace mongo;
+
+namespace {
+
+/**
+ * Statistics for a collection of 1000 documents, where 'a' is unique and 'b' takes two values.
+ */
+std::unique_ptr<CollectionStatistics> buildStatistics() {
+    CollectionStatistics::Builder builder({"a", "b"});
+    for (int i = 0; i < 1000; ++i) {
+        builder.addDocument(BSON("a" << i << "b" << i % 2));
+    }
+    return builder.done(1000, Date_t(), 64);
+}
+
+std::unique_ptr<QuerySolution> makeSolution(QuerySolutionNode* root) {
+    auto soln = stdx::make_unique<QuerySolution>();
+    soln->root.reset(root);
+    return soln;
+}
+
+/**
+ * Returns a solution which fetches the documents whose value for the first field of 'index' is
+ * 'value', scanning all values of the other fields of 'index'.
+ */
+std::unique_ptr<QuerySolution> makeIndexedSolution(IndexEntry index, int value) {
+    auto ixscan = new IndexScanNode(index);
+    BSONObjIterator keyPatternIt(index.keyPattern);
+    while (keyPatternIt.more()) {
+        OrderedIntervalList oil(keyPatternIt.next().fieldName());
+        if (ixscan->bounds.fields.empty()) {
+            oil.intervals.push_back(Interval(BSON("" << value << "" << value), true, true));
+        } else {
+            oil.intervals.push_back(Interval(BSON("" << MINKEY << "" << MAXKEY), true, true));
+        }
+        ixscan->bounds.fields.push_back(oil);
+    }
+
+    auto fetch = new FetchNode();
+    fetch->children.push_back(ixscan);
+    return makeSolution(fetch);
+}
+
+TEST(PlanCostModelTest, SelectiveIndexIsChosenConfidently) {
+    auto stats = buildStatistics();
+    PlanCostModel costModel(*stats);
+
+    auto byA = makeIndexedSolution(IndexEntry(BSON("a" << 1), "a_1"), 5);
+    auto byB = makeIndexedSolution(IndexEntry(BSON("b" << 1), "b_1"), 0);
+    auto collScan = makeSolution(new CollectionScanNode());
+
+    auto costA = costModel.estimateCost(*byA);
+    auto costB = costModel.estimateCost(*byB);
+    auto costCollScan = costModel.estimateCost(*collScan);
+    ASSERT(costA && costB && costCollScan);
+    ASSERT_LT(*costA, *costB);
+    ASSERT_LT(*costA, *costCollScan);
+
+    // Fetching half of the collection by RecordId costs more than scanning all of it.
+    ASSERT_LT(*costCollScan, *costB);
+
+    std::vector<QuerySolution*> solutions{byB.get(), byA.get(), collScan.get()};
+    auto chosen = costModel.chooseSolution(solutions, 10.0);
+    ASSERT(chosen);
+    ASSERT_EQUALS(1U, *chosen);
+}
+
+TEST(PlanCostModelTest, CloseEstimatesAreNotChosen) {
+    auto stats = buildStatistics();
+    PlanCostModel costModel(*stats);
+
+    auto byA = makeIndexedSolution(IndexEntry(BSON("a" << 1), "a_1"), 5);
+    auto byAB = makeIndexedSolution(IndexEntry(BSON("a" << 1 << "b" << 1), "a_1_b_1"), 5);
+
+    std::vector<QuerySolution*> solutions{byA.get(), byAB.get()};
+    ASSERT_FALSE(costModel.chooseSolution(solutions, 10.0));
+}
+
+TEST(PlanCostModelTest, IndexesWhoseKeysDifferFromSampledValuesAreNotCosted) {
+    auto stats = buildStatistics();
+    PlanCostModel costModel(*stats);
+
+    IndexEntry sparse(BSON("a" << 1), false, true, false, "a_1", nullptr, BSONObj());
+    ASSERT_FALSE(costModel.estimateCost(*makeIndexedSolution(sparse, 5)));
+
+    IndexEntry hashed(BSON("a"
+                           << "hashed"),
+                      "a_hashed");
+    ASSERT_FALSE(costModel.estimateCost(*makeIndexedSolution(hashed, 5)));
+
+    // There are no statistics for unindexed fields.
+    auto byC = makeIndexedSolution(IndexEntry(BSON("c" << 1), "c_1"), 5);
+    ASSERT_FALSE(costModel.estimateCost(*byC));
+
+    // A solution with a stage the model does not know about cannot be chosen.
+    auto byA = makeIndexedSolution(IndexEntry(BSON("a" << 1), "a_1"), 5);
+    auto text = makeSolution(new TextNode(IndexEntry(BSON("_fts"
+                                                           << "text"
+                                                           << "_ftsx"
+                                                           << 1),
+                                                      "text")));
+    std::vector<QuerySolution*> solutions{byA.get(), text.get()};
+    ASSERT_FALSE(costModel.chooseSolution(solutions, 10.0));
+}
+
+TEST(PlanCostModelTest, MultikeyIndexesAreNotCosted) {
+    // Every document holds ten tags, so the histogram for 'tags' counts ten keys per document.
+    CollectionStatistics::Builder builder({"a", "tags"});
+    for (int i = 0; i < 1000; ++i) {
+        BSONArrayBuilder tags;
+        for (int j = 0; j < 10; ++j) {
+            tags.append((i + j) % 100);
+        }
+        builder.addDocument(BSON("a" << i % 100 << "tags" << tags.arr()));
+    }
+    auto stats = builder.done(1000, Date_t(), 64);
+    ASSERT_EQUALS(10000, stats->getHistogram("tags")->getTotalCount());
+    PlanCostModel costModel(*stats);
+
+    // Tag 5 is held by a tenth of the documents but makes up a hundredth of the keys, the same
+    // fraction as a == 5 makes up of the documents. Costing both scans by selectivity times the
+    // number of documents would make them look equally cheap, although the scan of 'tags' examines
+    // and fetches ten times as much.
+    IndexEntry byTagsIndex(BSON("tags" << 1), true, false, false, "tags_1", nullptr, BSONObj());
+    auto byTags = makeIndexedSolution(byTagsIndex, 5);
+    ASSERT_FALSE(costModel.estimateCost(*byTags));
+
+    auto byA = makeIndexedSolution(IndexEntry(BSON("a" << 1), "a_1"), 5);
+    ASSERT(costModel.estimateCost(*byA));
+
+    std::vector<QuerySolution*> solutions{byA.get(), byTags.get()};
+    ASSERT_FALSE(costModel.chooseSolution(solutions, 10.0));
+}
+
+}  // namespace
@@ -43,6 +43,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/record_fetcher.h"
 #include "mongo/stdx/memory.h"
@@ -82,6 +83,38 @@ PlanStage* getStageByType(PlanStage* root, StageType type) {
 
     return NULL;
 }
+
+/**
+ * Asks 'root' for a batch of up to 'maxWorks' units of work, which ends early if 'yieldPolicy'
+ * says to yield, and appends owned copies of the results to 'results', freeing their working set
+ * members. Returns the state that ended the batch, with '*stateId' set accordingly.
+ */
+PlanStage::StageState workBatch(PlanStage* root,
+                                WorkingSet* workingSet,
+                                size_t maxWorks,
+                                PlanYieldPolicy* yieldPolicy,
+                                std::queue<Snapshotted<BSONObj>>* results,
+                                WorkingSetID* stateId) {
+    vector<WorkingSetID> ids;
+    ids.reserve(maxWorks);
+    PlanStage::StageState code = root->workBatch(maxWorks, &ids, stateId, yieldPolicy);
+
+    for (auto&& id : ids) {
+        WorkingSetMember* member = workingSet->get(id);
+        if (WorkingSetMember::RID_AND_IDX == member->getState()) {
+            // TODO: currently snapshot ids are only associated with documents, and not with
+            // index keys.
+            if (1 == member->keyData.size()) {
+                results->emplace(SnapshotId(), member->keyData[0].keyData.getOwned());
+            }
+        } else if (member->hasObj()) {
+            results->emplace(member->obj.snapshotId(), member->obj.value().getOwned());
+        }
+        workingSet->free(id);
+    }
+
+    return code;
+}
 }
 
 // static
@@ -386,6 +419,22 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
         return PlanExecutor::ADVANCED;
     }
 
+    if (!_batchedResults.empty()) {
+        invariant(objOut && !dlOut);
+        *objOut = std::move(_batchedResults.front());
+        _batchedResults.pop();
+        return PlanExecutor::ADVANCED;
+    }
+
+    if (!_workBatchSize) {
+        const int batchSize = internalQueryExecBatchedWorkSize.load();
+        _workBatchSize = (batchSize > 1 && _root->treeSupportsBatchedWork()) ? batchSize : 0;
+    }
+
+    // Batched results are buffered as owned objects, which is only possible when the caller
+    // doesn't need their RecordIds.
+    const bool useBatches = *_workBatchSize && objOut && !dlOut;
+
     // When a stage requests a yield for document fetch, it gives us back a RecordFetcher*
     // to use to pull the record into memory. We take ownership of the RecordFetcher here,
     // deleting it after we've had a chance to do the fetch. For timing-based yields, we
@@ -422,7 +471,34 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
         fetcher.reset();
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState code = _root->work(&id);
+        PlanStage::StageState code;
+        if (useBatches) {
+            // The stages consult the yield policy between the units of work within the batch, and
+            // leave it forced to yield if the batch ended early for that reason.
+            code = workBatch(_root.get(),
+                             _workingSet.get(),
+                             *_workBatchSize,
+                             _yieldPolicy.get(),
+                             &_batchedResults,
+                             &id);
+
+            if (PlanStage::DEAD == code || PlanStage::FAILURE == code) {
+                // The error takes precedence over any results the batch produced before it.
+                _batchedResults = std::queue<Snapshotted<BSONObj>>();
+            } else if (PlanStage::NEED_YIELD != code && !_batchedResults.empty()) {
+                // Return what we have. If the batch ended at EOF, the plan will report that
+                // again once the results are used up.
+                writeConflictsInARow = 0;
+                *objOut = std::move(_batchedResults.front());
+                _batchedResults.pop();
+                return PlanExecutor::ADVANCED;
+            } else if (PlanStage::ADVANCED == code) {
+                // None of the results had the data the caller wanted, try again.
+                code = PlanStage::NEED_TIME;
+            }
+        } else {
+            code = _root->work(&id);
+        }
 
         if (code != PlanStage::NEED_YIELD)
             writeConflictsInARow = 0;
@@ -502,7 +578,7 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
 
 bool PlanExecutor::isEOF() {
     invariant(_currentState == kUsable);
-    return killed() || (_stash.empty() && _root->isEOF());
+    return killed() || (_stash.empty() && _batchedResults.empty() && _root->isEOF());
 }
 
 void PlanExecutor::registerExec(const Collection* collection) {
@@ -474,6 +474,14 @@ private:
     // stages.
     std::queue<BSONObj> _stash;
 
+    // Owned copies of the results of the plan's last batch of work that have yet to be returned.
+    // Emptied after '_stash' and before retrieving further results from the plan stages.
+    std::queue<Snapshotted<BSONObj>> _batchedResults;
+
+    // How many units of work to ask of the plan at once, or 0 if the plan is worked one unit at
+    // a time. Decided on the first call to getNext() and fixed from then on.
+    boost::optional<size_t> _workBatchSize;
+
     enum { kUsable, kSaved, kDetached } _currentState = kUsable;
 
     bool _everDetachedFromOperationContext = false;
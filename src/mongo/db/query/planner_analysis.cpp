@@ -532,6 +532,7 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
 
     SortNode* sort = new SortNode();
     sort->pattern = sortObj;
+    sort->allowDiskUse = params.options & QueryPlannerParams::ALLOW_EXTERNAL_SORT;
     sort->children.push_back(solnRoot);
     solnRoot = sort;
     // When setting the limit on the sort, we need to consider both
@@ -56,16 +56,32 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableIndexIntersection, bool,
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableHashIntersection, bool, false);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerEnableCostBasedSelection, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerCostBasedConfidenceRatio, double, 10.0);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryStatisticsSampleSize, int, 1000);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryStatisticsHistogramBuckets, int, 64);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryStatisticsRefreshFraction, double, 0.2);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryStatisticsMaxAgeSecs, int, 600);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanOrChildrenIndependently, bool, true);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryMaxScansToExplode, int, 200);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecMaxBlockingSortBytes, int, 32 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecBlockingSortAllowDiskUse, bool, false);
+
 // Yield every 128 cycles or 10ms.
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldIterations, int, 128);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecYieldPeriodMS, int, 10);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryExecBatchedWorkSize, int, 0);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryFacetBufferSizeBytes, int, 100 * 1024 * 1024);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalInsertMaxBatchSize,
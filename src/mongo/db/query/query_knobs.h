@@ -58,6 +58,30 @@ extern std::atomic<bool> internalQueryPlannerEnableIndexIntersection;  // NOLINT
 // Do we use hash-based intersection for rooted $and queries?
 extern std::atomic<bool> internalQueryPlannerEnableHashIntersection;  // NOLINT
 
+//
+// cost-based plan selection
+//
+
+// Do we try to pick a plan from collection statistics before ranking plans by running them?
+extern std::atomic<bool> internalQueryPlannerEnableCostBasedSelection;  // NOLINT
+
+// How many times cheaper than every other candidate must a plan be estimated to be in order to
+// pick it without running the candidates?
+extern AtomicDouble internalQueryPlannerCostBasedConfidenceRatio;  // NOLINT
+
+// How many documents do we sample when building collection statistics?
+extern std::atomic<int> internalQueryStatisticsSampleSize;  // NOLINT
+
+// How many buckets may each field histogram have?
+extern std::atomic<int> internalQueryStatisticsHistogramBuckets;  // NOLINT
+
+// Collection statistics are rebuilt once the number of documents has changed by this fraction
+// since they were built...
+extern AtomicDouble internalQueryStatisticsRefreshFraction;  // NOLINT
+
+// ...or once they are this many seconds old.
+extern std::atomic<int> internalQueryStatisticsMaxAgeSecs;  // NOLINT
+
 //
 // plan cache
 //
@@ -99,12 +123,20 @@ extern std::atomic<int> internalQueryMaxScansToExplode;  // NOLINT
 
 extern std::atomic<int> internalQueryExecMaxBlockingSortBytes;  // NOLINT
 
+// Whether a blocking sort in a find may spill to disk once it uses more than
+// internalQueryExecMaxBlockingSortBytes, rather than fail.
+extern std::atomic<bool> internalQueryExecBlockingSortAllowDiskUse;  // NOLINT
+
 // Yield after this many "should yield?" checks.
 extern std::atomic<int> internalQueryExecYieldIterations;  // NOLINT
 
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern std::atomic<int> internalQueryExecYieldPeriodMS;  // NOLINT
 
+// How many units of work a PlanExecutor asks of its plan at once, when every stage of the plan
+// supports batched work. Values of 1 or less disable batching.
+extern std::atomic<int> internalQueryExecBatchedWorkSize;  // NOLINT
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
@@ -95,6 +95,11 @@ struct QueryPlannerParams {
         // Set this if you don't want any plans with a non-covered projection stage. All projections
         // must be provided/covered by an index.
         NO_UNCOVERED_PROJECTIONS = 1 << 10,
+
+        // Set this if blocking sort stages may spill to disk once they use more memory than
+        // internalQueryExecMaxBlockingSortBytes. Documents read back from disk are copies which no
+        // longer receive invalidations, so this is only suitable for read-only plans.
+        ALLOW_EXTERNAL_SORT = 1 << 11,
     };
 
     // See Options enum above.
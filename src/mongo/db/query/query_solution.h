@@ -606,7 +606,10 @@ struct SortKeyGeneratorNode : public QuerySolutionNode {
 };
 
 struct SortNode : public QuerySolutionNode {
-    SortNode() : _sorts(SimpleBSONObjComparator::kInstance.makeBSONObjSet()), limit(0) {}
+    SortNode()
+        : _sorts(SimpleBSONObjComparator::kInstance.makeBSONObjSet()),
+          limit(0),
+          allowDiskUse(false) {}
 
     virtual ~SortNode() {}
 
@@ -646,6 +649,9 @@ struct SortNode : public QuerySolutionNode {
 
     // Sum of both limit and skip count in the parsed query.
     size_t limit;
+
+    // Whether the sort may spill to disk rather than fail when it runs out of memory.
+    bool allowDiskUse;
 };
 
 struct LimitNode : public QuerySolutionNode {
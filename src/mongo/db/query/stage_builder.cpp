@@ -115,6 +115,7 @@ PlanStage* buildStages(OperationContext* txn,
         params.collection = collection;
         params.pattern = sn->pattern;
         params.limit = sn->limit;
+        params.allowDiskUse = sn->allowDiskUse;
         return new SortStage(txn, params, ws, childStage);
     } else if (STAGE_SORT_KEY_GENERATOR == root->getType()) {
         const SortKeyGeneratorNode* keyGenNode = static_cast<const SortKeyGeneratorNode*>(root);
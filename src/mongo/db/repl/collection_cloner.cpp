@@ -484,6 +484,9 @@ void CollectionCloner::_insertDocumentsCallback(const executor::TaskExecutor::Ca
 
     _documents.swap(docs);
     _stats.documentsCopied += docs.size();
+    for (auto&& doc : docs) {
+        _stats.bytesCopied += doc.objsize();
+    }
     ++_stats.fetchBatches;
     _progressMeter.hit(int(docs.size()));
     invariant(_collLoader);
@@ -562,6 +565,7 @@ BSONObj CollectionCloner::Stats::toBSON() const {
 void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
     builder->appendNumber(kDocumentsToCopyFieldName, documentToCopy);
     builder->appendNumber(kDocumentsCopiedFieldName, documentsCopied);
+    builder->appendNumber("bytesCopied", bytesCopied);
     builder->appendNumber("indexes", indexes);
     builder->appendNumber("fetchedBatches", fetchBatches);
     if (start != Date_t()) {
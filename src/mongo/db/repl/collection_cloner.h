@@ -72,6 +72,7 @@ public:
         Date_t end;
         size_t documentToCopy{0};
         size_t documentsCopied{0};
+        size_t bytesCopied{0};
         size_t indexes{0};
         size_t fetchBatches{0};
 
@@ -1327,7 +1327,11 @@ TEST_F(InitialSyncTest, GetInitialSyncProgressReturnsCorrectProgress) {
     ASSERT_BSONOBJ_EQ(progress.getObjectField("initialSyncAttempts"), BSONObj());
     ASSERT_EQUALS(progress.getIntField("fetchedMissingDocs"), 0) << progress;
     ASSERT_EQUALS(progress.getIntField("appliedOps"), 0) << progress;
-    ASSERT_BSONOBJ_EQ(progress.getObjectField("databases"), BSON("databasesCloned" << 0));
+    auto databasesProgress = progress.getObjectField("databases");
+    ASSERT_EQUALS(0, databasesProgress.getIntField("databasesCloned")) << databasesProgress;
+    ASSERT_EQUALS(
+        0, databasesProgress.getIntField(CollectionCloner::Stats::kDocumentsCopiedFieldName))
+        << databasesProgress;
 
     // Play rest of the failed round of responses.
     setResponses({failedResponses.begin() + 3, failedResponses.end()});
@@ -1350,7 +1354,11 @@ TEST_F(InitialSyncTest, GetInitialSyncProgressReturnsCorrectProgress) {
     ASSERT_EQUALS(progress["initialSyncOplogStart"].timestamp(), Timestamp(1, 1)) << progress;
     ASSERT_EQUALS(progress.getIntField("fetchedMissingDocs"), 0) << progress;
     ASSERT_EQUALS(progress.getIntField("appliedOps"), 0) << progress;
-    ASSERT_BSONOBJ_EQ(progress.getObjectField("databases"), BSON("databasesCloned" << 0));
+    databasesProgress = progress.getObjectField("databases");
+    ASSERT_EQUALS(0, databasesProgress.getIntField("databasesCloned")) << databasesProgress;
+    ASSERT_EQUALS(
+        0, databasesProgress.getIntField(CollectionCloner::Stats::kDocumentsCopiedFieldName))
+        << databasesProgress;
 
     BSONObj attempts = progress["initialSyncAttempts"].Obj();
     ASSERT_EQUALS(attempts.nFields(), 1) << attempts;
@@ -1381,8 +1389,15 @@ TEST_F(InitialSyncTest, GetInitialSyncProgressReturnsCorrectProgress) {
     ASSERT_EQUALS(progress.getIntField("fetchedMissingDocs"), 0) << progress;
     // Expected applied ops to be a superset of this range: Timestamp(2,1) ... Timestamp(7,1).
     ASSERT_GREATER_THAN_OR_EQUALS(progress.getIntField("appliedOps"), 6) << progress;
-    auto databasesProgress = progress.getObjectField("databases");
+    databasesProgress = progress.getObjectField("databases");
     ASSERT_EQUALS(1, databasesProgress.getIntField("databasesCloned")) << databasesProgress;
+    ASSERT_EQUALS(
+        5, databasesProgress.getIntField(CollectionCloner::Stats::kDocumentsToCopyFieldName))
+        << databasesProgress;
+    ASSERT_EQUALS(
+        5, databasesProgress.getIntField(CollectionCloner::Stats::kDocumentsCopiedFieldName))
+        << databasesProgress;
+    ASSERT_GREATER_THAN(databasesProgress["bytesCopied"].numberLong(), 0) << databasesProgress;
     auto dbProgress = databasesProgress.getObjectField("a");
     ASSERT_EQUALS(1, dbProgress.getIntField("collections")) << dbProgress;
     ASSERT_EQUALS(1, dbProgress.getIntField("clonedCollections")) << dbProgress;
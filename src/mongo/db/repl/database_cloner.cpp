@@ -51,6 +51,9 @@
 namespace mongo {
 namespace repl {
 
+// The maximum number of collections in a database that are cloned at the same time.
+MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncConcurrentCollectionCloners, int, 1);
+
 namespace {
 
 using LockGuard = stdx::lock_guard<stdx::mutex>;
@@ -185,15 +188,26 @@ Status DatabaseCloner::startup() {
 }
 
 void DatabaseCloner::shutdown() {
+    std::vector<CollectionCloner*> startedCollectionCloners;
     {
         LockGuard lk(_mutex);
 
         if (!_active) {
             return;
         }
+
+        // The cloners are not added to or removed from the list once the first one has started.
+        if (_activeCollectionCloners > 0) {
+            for (auto it = _collectionCloners.begin(); it != _nextCollectionClonerIter; ++it) {
+                startedCollectionCloners.push_back(&*it);
+            }
+        }
     }
 
     _listCollectionsFetcher.shutdown();
+    for (auto collectionCloner : startedCollectionCloners) {
+        collectionCloner->shutdown();
+    }
 }
 
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
@@ -346,17 +360,33 @@ void DatabaseCloner::_listCollectionsCallback(const StatusWith<Fetcher::QueryRes
         }
     }
 
-    // Start first collection cloner.
-    _currentCollectionClonerIter = _collectionCloners.begin();
+    // Start the first batch of collection cloners.
+    _nextCollectionClonerIter = _collectionCloners.begin();
+    _startCollectionCloners_inlock();
+    if (_activeCollectionCloners == 0) {
+        invariant(!_startCollectionClonerStatus.isOK());
+        _finishCallback_inlock(lk, _startCollectionClonerStatus);
+        return;
+    }
+}
+
+void DatabaseCloner::_startCollectionCloners_inlock() {
+    const size_t maxActive =
+        static_cast<size_t>(std::max(1, numInitialSyncConcurrentCollectionCloners.load()));
+    while (_startCollectionClonerStatus.isOK() && _activeCollectionCloners < maxActive &&
+           _nextCollectionClonerIter != _collectionCloners.end()) {
+        auto&& collectionCloner = *_nextCollectionClonerIter++;
 
-    LOG(1) << "    cloning collection " << _currentCollectionClonerIter->getSourceNamespace();
+        LOG(1) << "    cloning collection " << collectionCloner.getSourceNamespace();
 
-    Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-    if (!startStatus.isOK()) {
-        LOG(1) << "    failed to start collection cloning on "
-               << _currentCollectionClonerIter->getSourceNamespace() << ": " << redact(startStatus);
-        _finishCallback_inlock(lk, startStatus);
-        return;
+        Status startStatus = _startCollectionCloner(collectionCloner);
+        if (!startStatus.isOK()) {
+            LOG(1) << "    failed to start collection cloning on "
+                   << collectionCloner.getSourceNamespace() << ": " << redact(startStatus);
+            _startCollectionClonerStatus = startStatus;
+            return;
+        }
+        ++_activeCollectionCloners;
     }
 }
 
@@ -380,17 +410,17 @@ void DatabaseCloner::_collectionClonerCallback(const Status& status, const Names
     lk.unlock();
     _collectionWork(newStatus, nss);
     lk.lock();
-    _currentCollectionClonerIter++;
+    invariant(_activeCollectionCloners > 0);
+    --_activeCollectionCloners;
 
-    if (_currentCollectionClonerIter != _collectionCloners.end()) {
-        Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-        if (!startStatus.isOK()) {
-            LOG(1) << "    failed to start collection cloning on "
-                   << _currentCollectionClonerIter->getSourceNamespace() << ": "
-                   << redact(startStatus);
-            _finishCallback_inlock(lk, startStatus);
-            return;
-        }
+    _startCollectionCloners_inlock();
+    if (_activeCollectionCloners > 0) {
+        return;
+    }
+
+    // Only report a failure to start a cloner once every cloner that did start has finished.
+    if (!_startCollectionClonerStatus.isOK()) {
+        _finishCallback_inlock(lk, _startCollectionClonerStatus);
         return;
     }
 
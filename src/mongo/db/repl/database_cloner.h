@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <string>
 #include <vector>
@@ -55,6 +56,9 @@ using UniqueLock = stdx::unique_lock<stdx::mutex>;
 
 }  // namespace
 
+// The maximum number of collections in a database that are cloned at the same time.
+extern std::atomic<int> numInitialSyncConcurrentCollectionCloners;  // NOLINT
+
 class StorageInterface;
 
 class DatabaseCloner : public BaseCloner {
@@ -169,6 +173,13 @@ private:
                                   Fetcher::NextAction* nextAction,
                                   BSONObjBuilder* getMoreBob);
 
+    /**
+     * Starts collection cloners in listCollections order until
+     * 'numInitialSyncConcurrentCollectionCloners' of them are active or there are none left.
+     * If a cloner fails to start, records the failure and stops starting new cloners.
+     */
+    void _startCollectionCloners_inlock();
+
     /**
      * Forwards collection cloner result to client.
      * Starts a new cloner on a different collection.
@@ -221,7 +232,9 @@ private:
     std::vector<BSONObj> _collectionInfos;                               // (M)
     std::vector<NamespaceString> _collectionNamespaces;                  // (M)
     std::list<CollectionCloner> _collectionCloners;                      // (M)
-    std::list<CollectionCloner>::iterator _currentCollectionClonerIter;  // (M)
+    std::list<CollectionCloner>::iterator _nextCollectionClonerIter;     // (M)
+    size_t _activeCollectionCloners = 0;                                 // (M)
+    Status _startCollectionClonerStatus = Status::OK();                  // (M)
     std::vector<std::pair<Status, NamespaceString>> _failedNamespaces;   // (M)
     CollectionCloner::ScheduleDbWorkFn
         _scheduleDbWorkFn;  // (RT) Function for scheduling database work using the executor.
@@ -54,12 +54,43 @@ struct CollectionCloneInfo {
     Status status{ErrorCodes::NotYetInitialized, ""};
 };
 
+/**
+ * Sets numInitialSyncConcurrentCollectionCloners for the lifetime of the object.
+ */
+class ScopedConcurrentCollectionCloners {
+public:
+    explicit ScopedConcurrentCollectionCloners(int numCloners)
+        : _oldNumCloners(numInitialSyncConcurrentCollectionCloners.load()) {
+        numInitialSyncConcurrentCollectionCloners.store(numCloners);
+    }
+
+    ~ScopedConcurrentCollectionCloners() {
+        numInitialSyncConcurrentCollectionCloners.store(_oldNumCloners);
+    }
+
+private:
+    const int _oldNumCloners;
+};
+
 class DatabaseClonerTest : public BaseClonerTest {
 public:
     void collectionWork(const Status& status, const NamespaceString& sourceNss);
     void clear() override;
     BaseCloner* getCloner() const override;
 
+    /**
+     * Takes the next ready request, which must be 'cmdName' on collection 'collName'.
+     */
+    executor::NetworkInterfaceMock::NetworkOperationIterator takeNextRequest(
+        StringData cmdName, StringData collName);
+
+    /**
+     * Responds to the count request 'countRequest' for collection 'collName', and then to the
+     * listIndexes and find requests that follow it, as for an empty collection.
+     */
+    void cloneEmptyCollection(executor::NetworkInterfaceMock::NetworkOperationIterator countRequest,
+                              StringData collName);
+
 protected:
     void setUp() override;
     void tearDown() override;
@@ -117,6 +148,28 @@ BaseCloner* DatabaseClonerTest::getCloner() const {
     return _databaseCloner.get();
 }
 
+executor::NetworkInterfaceMock::NetworkOperationIterator DatabaseClonerTest::takeNextRequest(
+    StringData cmdName, StringData collName) {
+    ASSERT_TRUE(getNet()->hasReadyRequests());
+    auto noi = getNet()->getNextReadyRequest();
+    const BSONElement cmdElem = noi->getRequest().cmdObj.firstElement();
+    ASSERT_EQUALS(cmdName, cmdElem.fieldNameStringData());
+    ASSERT_EQUALS(collName, cmdElem.str());
+    return noi;
+}
+
+void DatabaseClonerTest::cloneEmptyCollection(
+    executor::NetworkInterfaceMock::NetworkOperationIterator countRequest, StringData collName) {
+    scheduleNetworkResponse(countRequest, createCountResponse(0));
+    finishProcessingNetworkResponse();
+    scheduleNetworkResponse(takeNextRequest("listIndexes", collName),
+                            createListIndexesResponse(0, BSON_ARRAY(idIndexSpec)));
+    finishProcessingNetworkResponse();
+    scheduleNetworkResponse(takeNextRequest("find", collName),
+                            createCursorResponse(0, BSONArray()));
+    finishProcessingNetworkResponse();
+}
+
 TEST_F(DatabaseClonerTest, InvalidConstruction) {
     executor::TaskExecutor& executor = getExecutor();
 
@@ -601,6 +654,150 @@ TEST_F(DatabaseClonerTest, FirstCollectionListIndexesFailed) {
     stats.commitCalled = true;
 }
 
+TEST_F(DatabaseClonerTest, ConcurrentCollectionClonersStartInListCollectionsOrder) {
+    ScopedConcurrentCollectionCloners concurrentCloners(2);
+    ASSERT_OK(_databaseCloner->startup());
+
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
+        processNetworkResponse(createListCollectionsResponse(
+            0,
+            BSON_ARRAY(BSON("name"
+                            << "a"
+                            << "options"
+                            << BSONObj())
+                       << BSON("name"
+                               << "b"
+                               << "options"
+                               << BSONObj())
+                       << BSON("name"
+                               << "c"
+                               << "options"
+                               << BSONObj()))));
+
+        // Only the first two collections are cloned at once.
+        auto countA = takeNextRequest("count", "a");
+        auto countB = takeNextRequest("count", "b");
+        ASSERT_FALSE(getNet()->hasReadyRequests());
+
+        // Collection 'c' is started as soon as 'b' finishes, while 'a' is still running.
+        cloneEmptyCollection(countB, "b");
+        auto countC = takeNextRequest("count", "c");
+        ASSERT_TRUE(_databaseCloner->isActive());
+
+        cloneEmptyCollection(countC, "c");
+        ASSERT_TRUE(_databaseCloner->isActive());
+        cloneEmptyCollection(countA, "a");
+    }
+    _databaseCloner->join();
+    ASSERT_FALSE(_databaseCloner->isActive());
+    ASSERT_OK(getStatus());
+
+    ASSERT_EQUALS(3U, _collections.size());
+    ASSERT_OK(_collections[NamespaceString{"db.a"}].status);
+    ASSERT_OK(_collections[NamespaceString{"db.b"}].status);
+    ASSERT_OK(_collections[NamespaceString{"db.c"}].status);
+}
+
+TEST_F(DatabaseClonerTest, FailingToStartCollectionClonerWaitsForRunningCloners) {
+    ScopedConcurrentCollectionCloners concurrentCloners(2);
+    ASSERT_OK(_databaseCloner->startup());
+    const Status errStatus{ErrorCodes::OperationFailed,
+                           "injected failure to start collection cloner"};
+
+    _databaseCloner->setStartCollectionClonerFn([errStatus](CollectionCloner& cloner) -> Status {
+        if (cloner.getSourceNamespace().coll() == "c") {
+            return errStatus;
+        }
+        return cloner.startup();
+    });
+
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
+        processNetworkResponse(createListCollectionsResponse(
+            0,
+            BSON_ARRAY(BSON("name"
+                            << "a"
+                            << "options"
+                            << BSONObj())
+                       << BSON("name"
+                               << "b"
+                               << "options"
+                               << BSONObj())
+                       << BSON("name"
+                               << "c"
+                               << "options"
+                               << BSONObj()))));
+
+        auto countA = takeNextRequest("count", "a");
+        auto countB = takeNextRequest("count", "b");
+
+        // Finishing 'b' fails to start 'c', but the failure is only reported once 'a' finishes.
+        cloneEmptyCollection(countB, "b");
+        ASSERT_FALSE(getNet()->hasReadyRequests());
+        ASSERT_TRUE(_databaseCloner->isActive());
+        ASSERT_EQUALS(getDetectableErrorStatus(), getStatus());
+
+        cloneEmptyCollection(countA, "a");
+    }
+    _databaseCloner->join();
+    ASSERT_FALSE(_databaseCloner->isActive());
+    ASSERT_EQUALS(errStatus, getStatus());
+
+    ASSERT_OK(_collections[NamespaceString{"db.a"}].status);
+    ASSERT_OK(_collections[NamespaceString{"db.b"}].status);
+}
+
+TEST_F(DatabaseClonerTest, FailedCollectionCloneDoesNotStopRunningCloners) {
+    ScopedConcurrentCollectionCloners concurrentCloners(2);
+    ASSERT_OK(_databaseCloner->startup());
+
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
+        processNetworkResponse(createListCollectionsResponse(
+            0,
+            BSON_ARRAY(BSON("name"
+                            << "a"
+                            << "options"
+                            << BSONObj())
+                       << BSON("name"
+                               << "b"
+                               << "options"
+                               << BSONObj())
+                       << BSON("name"
+                               << "c"
+                               << "options"
+                               << BSONObj()))));
+
+        auto countA = takeNextRequest("count", "a");
+        auto countB = takeNextRequest("count", "b");
+
+        // Cloning 'a' fails while 'b' is running, and 'c' is started in its place.
+        scheduleNetworkResponse(countA, createCountResponse(0));
+        finishProcessingNetworkResponse();
+        scheduleNetworkResponse(takeNextRequest("listIndexes", "a"),
+                                BSON("ok" << 0 << "errmsg"
+                                          << "fake message"
+                                          << "code"
+                                          << ErrorCodes::CursorNotFound));
+        finishProcessingNetworkResponse();
+        auto countC = takeNextRequest("count", "c");
+        ASSERT_TRUE(_databaseCloner->isActive());
+        ASSERT_EQUALS(getDetectableErrorStatus(), getStatus());
+
+        cloneEmptyCollection(countB, "b");
+        cloneEmptyCollection(countC, "c");
+    }
+    _databaseCloner->join();
+    ASSERT_FALSE(_databaseCloner->isActive());
+    ASSERT_EQUALS(ErrorCodes::InitialSyncFailure, getStatus().code());
+
+    ASSERT_EQUALS(3U, _collections.size());
+    ASSERT_EQUALS(ErrorCodes::CursorNotFound, _collections[NamespaceString{"db.a"}].status.code());
+    ASSERT_OK(_collections[NamespaceString{"db.b"}].status);
+    ASSERT_OK(_collections[NamespaceString{"db.c"}].status);
+}
+
 TEST_F(DatabaseClonerTest, CreateCollections) {
     ASSERT_OK(_databaseCloner->startup());
 
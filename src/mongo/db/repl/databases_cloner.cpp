@@ -52,6 +52,9 @@
 namespace mongo {
 namespace repl {
 
+// The maximum number of databases that are cloned at the same time.
+MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncConcurrentDatabaseCloners, int, 1);
+
 namespace {
 
 using Request = executor::RemoteCommandRequest;
@@ -142,6 +145,7 @@ Status DatabasesCloner::getStatus() {
 DatabasesCloner::Stats DatabasesCloner::getStats() const {
     LockGuard lk(_mutex);
     DatabasesCloner::Stats stats = _stats;
+    stats.now = _exec->now();
     for (auto&& databaseCloner : _databaseCloners) {
         stats.databaseStats.emplace_back(databaseCloner->getStats());
     }
@@ -160,6 +164,30 @@ BSONObj DatabasesCloner::Stats::toBSON() const {
 
 void DatabasesCloner::Stats::append(BSONObjBuilder* builder) const {
     builder->appendNumber("databasesCloned", databasesCloned);
+
+    long long documentsToCopy = 0;
+    long long documentsCopied = 0;
+    long long bytesCopied = 0;
+    for (auto&& db : databaseStats) {
+        for (auto&& collection : db.collectionStats) {
+            documentsToCopy += collection.documentToCopy;
+            documentsCopied += collection.documentsCopied;
+            bytesCopied += collection.bytesCopied;
+        }
+    }
+    builder->appendNumber(CollectionCloner::Stats::kDocumentsToCopyFieldName, documentsToCopy);
+    builder->appendNumber(CollectionCloner::Stats::kDocumentsCopiedFieldName, documentsCopied);
+    builder->appendNumber("bytesCopied", bytesCopied);
+    if (start != Date_t()) {
+        const auto elapsedMillis =
+            durationCount<Milliseconds>((end != Date_t() ? end : now) - start);
+        builder->appendNumber("elapsedMillis", elapsedMillis);
+        if (elapsedMillis > 0) {
+            builder->appendNumber("documentsCopiedPerSec", documentsCopied * 1000 / elapsedMillis);
+            builder->appendNumber("bytesCopiedPerSec", bytesCopied * 1000 / elapsedMillis);
+        }
+    }
+
     for (auto&& db : databaseStats) {
         BSONObjBuilder dbBuilder(builder->subobjStart(db.dbname));
         db.append(&dbBuilder);
@@ -177,6 +205,7 @@ Status DatabasesCloner::startup() {
     }
 
     _status = Status::OK();
+    _stats.start = _exec->now();
 
     // Schedule listDatabase command which will kick off the database cloner per result db.
     Request listDBsReq(_source,
@@ -276,10 +305,6 @@ void DatabasesCloner::_onListDatabaseFinish(const CommandCallbackArgs& cbd) {
             if (_scheduleDbWorkFn) {
                 dbCloner->setScheduleDbWorkFn_forTest(_scheduleDbWorkFn);
             }
-            // Start first database cloner.
-            if (_databaseCloners.empty()) {
-                startStatus = dbCloner->startup();
-            }
         } catch (...) {
             startStatus = exceptionToStatus();
         }
@@ -296,7 +321,21 @@ void DatabasesCloner::_onListDatabaseFinish(const CommandCallbackArgs& cbd) {
         _databaseCloners.push_back(dbCloner);
     }
 
-    if (_databaseCloners.size() == 0) {
+    // Start the first batch of database cloners.
+    if (_status.isOK() && !_databaseCloners.empty()) {
+        auto startStatus = _startDatabaseCloners_inlock();
+        if (!startStatus.isOK()) {
+            std::string err = str::stream() << "could not start cloner for database: "
+                                            << _databaseCloners[_nextDatabaseClonerIndex - 1]
+                                                   ->getDBName()
+                                            << " due to: " << startStatus.toString();
+            error() << err;
+            _failAfterActiveCloners_inlock(&lk, {ErrorCodes::InitialSyncFailure, err});
+            return;
+        }
+    }
+
+    if (_activeDatabaseCloners == 0) {
         if (_status.isOK()) {
             _succeed_inlock(&lk);
         } else {
@@ -315,12 +354,38 @@ RemoteCommandRetryScheduler* DatabasesCloner::_getListDatabasesScheduler() const
     return _listDBsScheduler.get();
 }
 
+Status DatabasesCloner::_startDatabaseCloners_inlock() {
+    const size_t maxActive =
+        static_cast<size_t>(std::max(1, numInitialSyncConcurrentDatabaseCloners.load()));
+    while (_activeDatabaseCloners < maxActive &&
+           _nextDatabaseClonerIndex < _databaseCloners.size()) {
+        auto&& dbCloner = _databaseCloners[_nextDatabaseClonerIndex++];
+        auto startStatus = dbCloner->startup();
+        if (!startStatus.isOK()) {
+            return startStatus;
+        }
+        ++_activeDatabaseCloners;
+    }
+    return Status::OK();
+}
+
 void DatabasesCloner::_onEachDBCloneFinish(const Status& status, const std::string& name) {
     UniqueLock lk(_mutex);
+    invariant(_activeDatabaseCloners > 0);
+    --_activeDatabaseCloners;
+
     if (!status.isOK()) {
         warning() << "database '" << name << "' (" << (_stats.databasesCloned + 1) << " of "
                   << _databaseCloners.size() << ") clone failed due to " << status.toString();
-        _fail_inlock(&lk, status);
+        _failAfterActiveCloners_inlock(&lk, status);
+        return;
+    }
+
+    // Another database cloner failed while this one was still running.
+    if (!_status.isOK()) {
+        if (_activeDatabaseCloners == 0) {
+            _fail_inlock(&lk, _status);
+        }
         return;
     }
 
@@ -340,7 +405,7 @@ void DatabasesCloner::_onEachDBCloneFinish(const Status& status, const std::stri
         }
         if (!adminStatus.isOK()) {
             LOG(1) << "Validation failed on 'admin' db due to " << adminStatus;
-            _fail_inlock(&lk, adminStatus);
+            _failAfterActiveCloners_inlock(&lk, adminStatus);
             return;
         }
     }
@@ -352,14 +417,14 @@ void DatabasesCloner::_onEachDBCloneFinish(const Status& status, const std::stri
         return;
     }
 
-    // Start next database cloner.
-    auto&& dbCloner = _databaseCloners[_stats.databasesCloned];
-    auto startStatus = dbCloner->startup();
+    // Start next database cloner(s).
+    auto startStatus = _startDatabaseCloners_inlock();
     if (!startStatus.isOK()) {
-        warning() << "failed to schedule database '" << name << "' ("
-                  << (_stats.databasesCloned + 1) << " of " << _databaseCloners.size()
+        warning() << "failed to schedule database '"
+                  << _databaseCloners[_nextDatabaseClonerIndex - 1]->getDBName() << "' ("
+                  << _nextDatabaseClonerIndex << " of " << _databaseCloners.size()
                   << ") due to " << startStatus.toString();
-        _fail_inlock(&lk, startStatus);
+        _failAfterActiveCloners_inlock(&lk, startStatus);
         return;
     }
 }
@@ -371,6 +436,7 @@ void DatabasesCloner::_fail_inlock(UniqueLock* lk, Status status) {
     }
 
     _setStatus_inlock(status);
+    _stats.end = _exec->now();
     // TODO: shutdown outstanding work, like any cloners active
     auto finish = _finishFn;
     lk->unlock();
@@ -382,10 +448,31 @@ void DatabasesCloner::_fail_inlock(UniqueLock* lk, Status status) {
     _active = false;
 }
 
+void DatabasesCloner::_failAfterActiveCloners_inlock(UniqueLock* lk, Status status) {
+    _setStatus_inlock(status);
+    if (_activeDatabaseCloners == 0) {
+        _fail_inlock(lk, _status);
+        return;
+    }
+
+    // The cloners still running report their completion through _onEachDBCloneFinish(), which
+    // fails the cloner with the recorded status once the last of them has finished.
+    LOG(1) << "shutting down " << _activeDatabaseCloners
+           << " database cloner(s) still running after failure: " << status;
+    std::vector<std::shared_ptr<DatabaseCloner>> startedCloners(
+        _databaseCloners.begin(), _databaseCloners.begin() + _nextDatabaseClonerIndex);
+    lk->unlock();
+    for (auto&& cloner : startedCloners) {
+        cloner->shutdown();
+    }
+    lk->lock();
+}
+
 void DatabasesCloner::_succeed_inlock(UniqueLock* lk) {
     LOG(3) << "DatabasesCloner::_succeed_inlock called";
     const auto status = Status::OK();
     _setStatus_inlock(status);
+    _stats.end = _exec->now();
     auto finish = _finishFn;
     lk->unlock();
 
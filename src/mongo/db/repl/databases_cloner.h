@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <string>
 #include <vector>
@@ -58,6 +59,9 @@ using UniqueLock = stdx::unique_lock<stdx::mutex>;
 
 }  // namespace.
 
+// The maximum number of databases that are cloned at the same time.
+extern std::atomic<int> numInitialSyncConcurrentDatabaseCloners;  // NOLINT
+
 /**
  * Clones all databases.
  */
@@ -65,6 +69,10 @@ class DatabasesCloner {
 public:
     struct Stats {
         size_t databasesCloned{0};
+        Date_t start;
+        Date_t end;
+        // When the stats were taken. Used to report throughput while cloning is in progress.
+        Date_t now;
         std::vector<DatabaseCloner::Stats> databaseStats;
 
         std::string toString() const;
@@ -126,6 +134,18 @@ private:
     /** Will call the completion function, and become inactive. */
     void _succeed_inlock(UniqueLock* lk);
 
+    /**
+     * Records the failure 'status' and shuts down the database cloners still running. Fails the
+     * cloner, with the first failure recorded, once none of them are running.
+     */
+    void _failAfterActiveCloners_inlock(UniqueLock* lk, Status status);
+
+    /**
+     * Starts database cloners in listDatabases order until
+     * 'numInitialSyncConcurrentDatabaseCloners' of them are active or there are none left.
+     */
+    Status _startDatabaseCloners_inlock();
+
     /** Called each time a database clone is finished */
     void _onEachDBCloneFinish(const Status& status, const std::string& name);
 
@@ -155,6 +175,8 @@ private:
 
     std::unique_ptr<RemoteCommandRetryScheduler> _listDBsScheduler;  // (M) scheduler for listDBs.
     std::vector<std::shared_ptr<DatabaseCloner>> _databaseCloners;   // (M) database cloners by name
+    size_t _nextDatabaseClonerIndex = 0;                             // (M) next cloner to start
+    size_t _activeDatabaseCloners = 0;                               // (M)
     Stats _stats;                                                    // (M)
 };
 
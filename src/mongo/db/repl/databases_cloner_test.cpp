@@ -696,4 +696,170 @@ TEST_F(DBsClonerTest, TwoDatabasesCopiesCompletely) {
     runCompleteClone(resps);
 }
 
+/**
+ * Sets numInitialSyncConcurrentDatabaseCloners for the lifetime of the object.
+ */
+class ScopedConcurrentDatabaseCloners {
+public:
+    explicit ScopedConcurrentDatabaseCloners(int numCloners)
+        : _oldNumCloners(numInitialSyncConcurrentDatabaseCloners.load()) {
+        numInitialSyncConcurrentDatabaseCloners.store(numCloners);
+    }
+
+    ~ScopedConcurrentDatabaseCloners() {
+        numInitialSyncConcurrentDatabaseCloners.store(_oldNumCloners);
+    }
+
+private:
+    const int _oldNumCloners;
+};
+
+/**
+ * Takes the next ready request, which must be a listCollections on database 'dbname'.
+ */
+NetworkInterfaceMock::NetworkOperationIterator takeListCollectionsRequest(
+    NetworkInterfaceMock* net, const std::string& dbname) {
+    ASSERT_TRUE(net->hasReadyRequests());
+    auto noi = net->getNextReadyRequest();
+    ASSERT_EQUALS("listCollections"_sd, noi->getRequest().cmdObj.firstElementFieldName());
+    ASSERT_EQUALS(dbname, noi->getRequest().dbname);
+    return noi;
+}
+
+BSONObj emptyListCollectionsResponse(const std::string& dbname) {
+    return BSON("ok" << 1 << "cursor" << BSON("id" << 0LL << "ns"
+                                                   << (dbname + ".$cmd.listCollections")
+                                                   << "firstBatch"
+                                                   << BSONArray()));
+}
+
+TEST_F(DBsClonerTest, ConcurrentDatabaseClonersStartInListDatabasesOrder) {
+    ScopedConcurrentDatabaseCloners concurrentCloners(2);
+    Status result = getDetectableErrorStatus();
+    DatabasesCloner cloner{&getStorage(),
+                           &getExecutor(),
+                           &getDbWorkThreadPool(),
+                           HostAndPort{"local:1234"},
+                           [](const BSONObj&) { return true; },
+                           [&result](const Status& status) {
+                               log() << "setting result to " << status;
+                               result = status;
+                           }};
+
+    ASSERT_OK(cloner.startup());
+    ASSERT_TRUE(cloner.isActive());
+
+    auto net = getNet();
+    executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+    scheduleNetworkResponse("listDatabases",
+                            fromjson("{ok:1, databases:[{name:'a'}, {name:'b'}, {name:'c'}]}"));
+    net->runReadyNetworkOperations();
+
+    // Only the first two databases are cloned at once.
+    auto requestA = takeListCollectionsRequest(net, "a");
+    auto requestB = takeListCollectionsRequest(net, "b");
+    ASSERT_FALSE(net->hasReadyRequests());
+
+    // Database 'c' is started as soon as 'b' finishes, while 'a' is still running.
+    scheduleNetworkResponse(requestB, emptyListCollectionsResponse("b"));
+    net->runReadyNetworkOperations();
+    auto requestC = takeListCollectionsRequest(net, "c");
+    ASSERT_TRUE(cloner.isActive());
+
+    scheduleNetworkResponse(requestC, emptyListCollectionsResponse("c"));
+    net->runReadyNetworkOperations();
+    ASSERT_TRUE(cloner.isActive());
+
+    scheduleNetworkResponse(requestA, emptyListCollectionsResponse("a"));
+    net->runReadyNetworkOperations();
+
+    cloner.join();
+    ASSERT_FALSE(cloner.isActive());
+    ASSERT_OK(result);
+}
+
+TEST_F(DBsClonerTest, FailingToStartDatabaseClonerShutsDownRunningClonersBeforeFailing) {
+    ScopedConcurrentDatabaseCloners concurrentCloners(2);
+    Status result = getDetectableErrorStatus();
+
+    TaskExecutorWithFailureInScheduleRemoteCommand executorProxy(
+        &getExecutor(), [](const executor::RemoteCommandRequest& request) {
+            return str::equals("listCollections", request.cmdObj.firstElementFieldName()) &&
+                request.dbname == "c";
+        });
+
+    DatabasesCloner cloner{&getStorage(),
+                           &executorProxy,
+                           &getDbWorkThreadPool(),
+                           HostAndPort{"local:1234"},
+                           [](const BSONObj&) { return true; },
+                           [&result](const Status& status) {
+                               log() << "setting result to " << status;
+                               result = status;
+                           }};
+
+    ASSERT_OK(cloner.startup());
+    ASSERT_TRUE(cloner.isActive());
+
+    auto net = getNet();
+    executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+    scheduleNetworkResponse("listDatabases",
+                            fromjson("{ok:1, databases:[{name:'a'}, {name:'b'}, {name:'c'}]}"));
+    net->runReadyNetworkOperations();
+
+    auto requestA = takeListCollectionsRequest(net, "a");
+    takeListCollectionsRequest(net, "b");
+
+    // Finishing 'a' fails to start 'c', which shuts down 'b' rather than waiting for it.
+    scheduleNetworkResponse(requestA, emptyListCollectionsResponse("a"));
+    net->runReadyNetworkOperations();
+    net->runReadyNetworkOperations();
+
+    cloner.join();
+    ASSERT_FALSE(cloner.isActive());
+    ASSERT_FALSE(net->hasReadyRequests());
+
+    // The failure to start 'c' is reported, not the cancellation of 'b'.
+    ASSERT_EQUALS(ErrorCodes::OperationFailed, result);
+}
+
+TEST_F(DBsClonerTest, FailedDatabaseCloneShutsDownRunningClonersBeforeFailing) {
+    ScopedConcurrentDatabaseCloners concurrentCloners(2);
+    Status result = getDetectableErrorStatus();
+    Status expectedStatus{ErrorCodes::NoSuchKey, "fake"};
+    DatabasesCloner cloner{&getStorage(),
+                           &getExecutor(),
+                           &getDbWorkThreadPool(),
+                           HostAndPort{"local:1234"},
+                           [](const BSONObj&) { return true; },
+                           [&result](const Status& status) {
+                               log() << "setting result to " << status;
+                               result = status;
+                           }};
+
+    ASSERT_OK(cloner.startup());
+    ASSERT_TRUE(cloner.isActive());
+
+    auto net = getNet();
+    executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+    scheduleNetworkResponse("listDatabases",
+                            fromjson("{ok:1, databases:[{name:'a'}, {name:'b'}, {name:'c'}]}"));
+    net->runReadyNetworkOperations();
+
+    auto requestA = takeListCollectionsRequest(net, "a");
+    takeListCollectionsRequest(net, "b");
+
+    // Cloning 'a' fails, which shuts down 'b' and does not start 'c'.
+    net->scheduleResponse(requestA, net->now(), expectedStatus);
+    net->runReadyNetworkOperations();
+    net->runReadyNetworkOperations();
+
+    cloner.join();
+    ASSERT_FALSE(cloner.isActive());
+    ASSERT_FALSE(net->hasReadyRequests());
+
+    // The failure of 'a' is reported, not the cancellation of 'b'.
+    ASSERT_EQUALS(expectedStatus, result);
+}
+
 }  // namespace
@@ -101,6 +101,12 @@ IsMasterResponse::IsMasterResponse()
       _shutdownInProgress(false) {}
 
 void IsMasterResponse::addToBSON(BSONObjBuilder* builder) const {
+    if (addTopologyToBSON(builder)) {
+        addLastWriteToBSON(builder);
+    }
+}
+
+bool IsMasterResponse::addTopologyToBSON(BSONObjBuilder* builder) const {
     if (_hostsSet) {
         std::vector<std::string> hosts;
         for (size_t i = 0; i < _hosts.size(); ++i) {
@@ -130,7 +136,7 @@ void IsMasterResponse::addToBSON(BSONObjBuilder* builder) const {
     if (_shutdownInProgress) {
         builder->append(kCodeFieldName, ErrorCodes::ShutdownInProgress);
         builder->append(kErrmsgFieldName, "replication shutdown in progress");
-        return;
+        return false;
     }
 
     if (!_configSet) {
@@ -138,7 +144,7 @@ void IsMasterResponse::addToBSON(BSONObjBuilder* builder) const {
         builder->append(kSecondaryFieldName, false);
         builder->append(kInfoFieldName, "Does not have a valid replica set config");
         builder->append(kIsReplicaSetFieldName, true);
-        return;
+        return false;
     }
 
     invariant(_setVersionSet);
@@ -172,6 +178,10 @@ void IsMasterResponse::addToBSON(BSONObjBuilder* builder) const {
     builder->append(kMeFieldName, _me.toString());
     if (_electionId.isSet())
         builder->append(kElectionIdFieldName, _electionId);
+    return true;
+}
+
+void IsMasterResponse::addLastWriteToBSON(BSONObjBuilder* builder) const {
     if (_lastWrite || _lastMajorityWrite) {
         BSONObjBuilder lastWrite(builder->subobjStart(kLastWriteFieldName));
         if (_lastWrite) {
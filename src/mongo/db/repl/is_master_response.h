@@ -68,6 +68,18 @@ public:
      */
     void addToBSON(BSONObjBuilder* builder) const;
 
+    /**
+     * Appends everything addToBSON would except for the lastWrite field, which is the last field
+     * and the only one that changes with every write. Returns false if the standard shutdown or
+     * no config response was added, in which case no lastWrite field should follow.
+     */
+    bool addTopologyToBSON(BSONObjBuilder* builder) const;
+
+    /**
+     * Appends the lastWrite field if either last write optime has been set.
+     */
+    void addLastWriteToBSON(BSONObjBuilder* builder) const;
+
     /**
      * Returns a BSONObj consisting the results of calling addToBSON on an otherwise empty
      * BSONObjBuilder.
@@ -462,6 +462,12 @@ public:
      */
     virtual void fillIsMasterForReplSet(IsMasterResponse* result) = 0;
 
+    /**
+     * Appends the response of fillIsMasterForReplSet() to "result", reusing the serialized
+     * topology fields of previous calls while the replica set topology is unchanged.
+     */
+    virtual void appendIsMasterForReplSet(BSONObjBuilder* result) = 0;
+
     /**
      * Adds to "result" a description of the slaveInfo data structure used to map RIDs to their
      * last known optimes.
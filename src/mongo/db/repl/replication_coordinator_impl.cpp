@@ -2023,6 +2023,43 @@ void ReplicationCoordinatorImpl::fillIsMasterForReplSet(IsMasterResponse* respon
     }
 }
 
+void ReplicationCoordinatorImpl::appendIsMasterForReplSet(BSONObjBuilder* result) {
+    invariant(getSettings().usingReplSets());
+
+    BSONObj topology;
+    bool hasConfig;
+    {
+        LockGuard topoLock(_topoMutex);
+        topology = _topCoord->getIsMasterTopology(&hasConfig);
+    }
+
+    // fillIsMasterForReplSet() overrides the topology coordinator's state while draining or
+    // catching up, which is brief enough not to be worth caching. This is checked only once the
+    // topology has been read: winning an election enters catch-up in the same critical section,
+    // so a topology which already reports this node as primary is never served as is while the
+    // node is still catching up or draining.
+    if (isWaitingForApplierToDrain() || isCatchingUp()) {
+        IsMasterResponse response;
+        fillIsMasterForReplSet(&response);
+        response.addToBSON(result);
+        return;
+    }
+
+    result->appendElements(topology);
+    if (!hasConfig) {
+        return;
+    }
+
+    IsMasterResponse lastWrite;
+    OpTime lastOpTime = getMyLastAppliedOpTime();
+    lastWrite.setLastWrite(lastOpTime, lastOpTime.getTimestamp().getSecs());
+    if (_currentCommittedSnapshot) {
+        OpTime majorityOpTime = _currentCommittedSnapshot->opTime;
+        lastWrite.setLastMajorityWrite(majorityOpTime, majorityOpTime.getTimestamp().getSecs());
+    }
+    lastWrite.addLastWriteToBSON(result);
+}
+
 void ReplicationCoordinatorImpl::appendSlaveInfoData(BSONObjBuilder* result) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _appendSlaveInfoData_inlock(result);
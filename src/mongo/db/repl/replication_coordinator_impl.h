@@ -200,6 +200,8 @@ public:
 
     virtual void fillIsMasterForReplSet(IsMasterResponse* result) override;
 
+    virtual void appendIsMasterForReplSet(BSONObjBuilder* result) override;
+
     virtual void appendSlaveInfoData(BSONObjBuilder* result) override;
 
     virtual ReplicaSetConfig getConfig() const override;
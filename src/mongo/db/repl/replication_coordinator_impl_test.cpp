@@ -2654,6 +2654,83 @@ TEST_F(ReplCoordTest, IsMaster) {
     ASSERT_OK(roundTripped.initialize(response.toBSON()));
 }
 
+TEST_F(ReplCoordTest, AppendIsMasterMatchesFillIsMasterAfterWritesAndStateChanges) {
+    HostAndPort h1("h1");
+    HostAndPort h2("h2");
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 2
+                            << "members"
+                            << BSON_ARRAY(BSON("_id" << 0 << "host" << h1.toString())
+                                          << BSON("_id" << 1 << "host" << h2.toString() << "tags"
+                                                        << BSON("key1"
+                                                                << "value1")))),
+                       h2);
+    getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY);
+
+    auto assertAppendMatchesFill = [this]() -> IsMasterResponse {
+        IsMasterResponse response;
+        getReplCoord()->fillIsMasterForReplSet(&response);
+
+        BSONObjBuilder builder;
+        getReplCoord()->appendIsMasterForReplSet(&builder);
+        ASSERT_BSONOBJ_EQ(response.toBSON(), builder.obj());
+        return response;
+    };
+
+    getReplCoord()->setMyLastAppliedOpTime(OpTime(Timestamp(100, 1), 1));
+    ASSERT_TRUE(assertAppendMatchesFill().isSecondary());
+
+    // Only the lastWrite field changes, and it is not part of the cached topology
+    getReplCoord()->setMyLastAppliedOpTime(OpTime(Timestamp(100, 2), 1));
+    auto response = assertAppendMatchesFill();
+    ASSERT_EQUALS(OpTime(Timestamp(100, 2), 1), response.getLastWriteOpTime());
+
+    ASSERT_TRUE(getReplCoord()->setFollowerMode(MemberState::RS_RECOVERING));
+    response = assertAppendMatchesFill();
+    ASSERT_FALSE(response.isSecondary());
+}
+
+TEST_F(ReplCoordTest, AppendIsMasterReportsSecondaryWhileDrainingAfterTopologyIsCached) {
+    init("mySet");
+
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version"
+                            << 1
+                            << "members"
+                            << BSON_ARRAY(BSON("_id" << 0 << "host"
+                                                     << "test1:1234"))),
+                       HostAndPort("test1", 1234));
+    auto replCoord = getReplCoord();
+    replCoord->setMyLastAppliedOpTime(OpTime(Timestamp(1, 0), 0));
+    replCoord->setMyLastDurableOpTime(OpTime(Timestamp(1, 0), 0));
+    ASSERT(replCoord->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoord->waitForElectionFinish_forTest();
+    // Wait for primary catch-up
+    getNet()->enterNetwork();
+    getNet()->runReadyNetworkOperations();
+    getNet()->exitNetwork();
+    ASSERT(replCoord->isWaitingForApplierToDrain());
+
+    // The topology coordinator already reports this node as primary, so its serialized topology
+    // must not be served until drain completes.
+    BSONObjBuilder whileDraining;
+    replCoord->appendIsMasterForReplSet(&whileDraining);
+    IsMasterResponse response;
+    ASSERT_OK(response.initialize(whileDraining.obj()));
+    ASSERT_FALSE(response.isMaster());
+    ASSERT_TRUE(response.isSecondary());
+
+    replCoord->signalDrainComplete(makeOperationContext().get());
+    BSONObjBuilder afterDrain;
+    replCoord->appendIsMasterForReplSet(&afterDrain);
+    ASSERT_OK(response.initialize(afterDrain.obj()));
+    ASSERT_TRUE(response.isMaster());
+    ASSERT_FALSE(response.isSecondary());
+}
+
 TEST_F(ReplCoordTest, IsMasterWithCommittedSnapshot) {
     init("mySet");
 
@@ -266,6 +266,12 @@ void ReplicationCoordinatorMock::fillIsMasterForReplSet(IsMasterResponse* result
     result->setElectionId(OID::gen());
 }
 
+void ReplicationCoordinatorMock::appendIsMasterForReplSet(BSONObjBuilder* result) {
+    IsMasterResponse isMasterResponse;
+    fillIsMasterForReplSet(&isMasterResponse);
+    isMasterResponse.addToBSON(result);
+}
+
 void ReplicationCoordinatorMock::appendSlaveInfoData(BSONObjBuilder* result) {}
 
 void ReplicationCoordinatorMock::appendConnectionStats(executor::ConnectionPoolStats* stats) const {
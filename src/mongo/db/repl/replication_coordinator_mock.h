@@ -147,6 +147,8 @@ public:
 
     virtual void fillIsMasterForReplSet(IsMasterResponse* result);
 
+    virtual void appendIsMasterForReplSet(BSONObjBuilder* result);
+
     virtual void appendSlaveInfoData(BSONObjBuilder* result);
 
     void appendConnectionStats(executor::ConnectionPoolStats* stats) const override;
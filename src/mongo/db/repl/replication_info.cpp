@@ -41,7 +41,6 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/query/internal_plans.h"
-#include "mongo/db/repl/is_master_response.h"
 #include "mongo/db/repl/master_slave.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplogreader.h"
@@ -68,9 +67,7 @@ namespace repl {
 void appendReplicationInfo(OperationContext* txn, BSONObjBuilder& result, int level) {
     ReplicationCoordinator* replCoord = getGlobalReplicationCoordinator();
     if (replCoord->getSettings().usingReplSets()) {
-        IsMasterResponse isMasterResponse;
-        replCoord->fillIsMasterForReplSet(&isMasterResponse);
-        result.appendElements(isMasterResponse.toBSON());
+        replCoord->appendIsMasterForReplSet(&result);
         if (level) {
             replCoord->appendSlaveInfoData(&result);
         }
@@ -69,12 +69,14 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/net/socket_exception.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -146,6 +148,84 @@ ServerStatusMetricField<Counter64> displayAttemptsToBecomeSecondary(
 // Number and time of each ApplyOps worker pool round
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
+
+/**
+ * Tracks how evenly each applied batch was spread across the writer threads. Writer 'i' is the
+ * i-th writer vector filled in by fillWriterVectors(), so a hot document or collection shows up as
+ * one writer with many more ops and much more busy time than the others.
+ *
+ * Reported as serverStatus().metrics.repl.apply.writers.
+ */
+class WriterUtilizationStats : public ServerStatusMetric {
+public:
+    WriterUtilizationStats() : ServerStatusMetric("repl.apply.writers") {}
+
+    /**
+     * Records one batch. 'busyMicros[i]' is the time writer 'i' spent applying its ops and
+     * 'batchMicros' is the wall-clock time from scheduling the first writer until all finished.
+     */
+    void recordBatch(const std::vector<MultiApplier::OperationPtrs>& writerVectors,
+                     const std::vector<long long>& busyMicros,
+                     long long batchMicros) {
+        invariant(writerVectors.size() == busyMicros.size());
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_ops.size() != writerVectors.size()) {
+            _ops.assign(writerVectors.size(), 0);
+            _busyMicros.assign(writerVectors.size(), 0);
+            _lastBatchOps.assign(writerVectors.size(), 0);
+            _lastBatchBusyMicros.assign(writerVectors.size(), 0);
+        }
+
+        for (size_t i = 0; i < writerVectors.size(); i++) {
+            _lastBatchOps[i] = writerVectors[i].size();
+            _lastBatchBusyMicros[i] = busyMicros[i];
+            _ops[i] += _lastBatchOps[i];
+            _busyMicros[i] += busyMicros[i];
+        }
+        _batches++;
+        _batchMicros += batchMicros;
+        _lastBatchMicros = batchMicros;
+    }
+
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        BSONObjBuilder writers(b.subobjStart(_leafName));
+        writers.append("numWriters", static_cast<int>(_ops.size()));
+        writers.append("batches", _batches);
+        writers.append("batchMicros", _batchMicros);
+        writers.append("ops", _ops);
+        writers.append("busyMicros", _busyMicros);
+        writers.append("utilization", _utilization(_busyMicros, _batchMicros));
+
+        BSONObjBuilder lastBatch(writers.subobjStart("lastBatch"));
+        lastBatch.append("batchMicros", _lastBatchMicros);
+        lastBatch.append("ops", _lastBatchOps);
+        lastBatch.append("busyMicros", _lastBatchBusyMicros);
+        lastBatch.append("utilization", _utilization(_lastBatchBusyMicros, _lastBatchMicros));
+    }
+
+private:
+    // Fraction of 'batchMicros' that each writer spent busy.
+    static std::vector<double> _utilization(const std::vector<long long>& busyMicros,
+                                            long long batchMicros) {
+        std::vector<double> utilization;
+        for (auto busy : busyMicros) {
+            utilization.push_back(batchMicros > 0 ? double(busy) / batchMicros : 0.0);
+        }
+        return utilization;
+    }
+
+    mutable stdx::mutex _mutex;
+    long long _batches = 0;
+    long long _batchMicros = 0;
+    std::vector<long long> _ops;
+    std::vector<long long> _busyMicros;
+
+    long long _lastBatchMicros = 0;
+    std::vector<long long> _lastBatchOps;
+    std::vector<long long> _lastBatchBusyMicros;
+} writerUtilizationStats;
+
 void initializePrefetchThread() {
     if (!Client::getCurrent()) {
         Client::initThreadIfNotAlready();
@@ -440,16 +520,21 @@ void prefetchOps(const MultiApplier::Operations& ops, OldThreadPool* prefetcherP
 
 // Doles out all the work to the writer pool threads.
 // Does not modify writerVectors, but passes non-const pointers to inner vectors into func.
+// Each writer records the time it spent applying its ops in the matching slot of busyVector.
 void applyOps(std::vector<MultiApplier::OperationPtrs>& writerVectors,
               OldThreadPool* writerPool,
               const MultiApplier::ApplyOperationFn& func,
-              std::vector<Status>* statusVector) {
+              std::vector<Status>* statusVector,
+              std::vector<long long>* busyVector) {
     invariant(writerVectors.size() == statusVector->size());
+    invariant(writerVectors.size() == busyVector->size());
     TimerHolder timer(&applyBatchStats);
     for (size_t i = 0; i < writerVectors.size(); i++) {
         if (!writerVectors[i].empty()) {
-            writerPool->schedule([&func, &writerVectors, statusVector, i] {
+            writerPool->schedule([&func, &writerVectors, statusVector, busyVector, i] {
+                Timer busyTimer;
                 (*statusVector)[i] = func(&writerVectors[i]);
+                (*busyVector)[i] = busyTimer.micros();
             });
         }
     }
@@ -1270,6 +1355,7 @@ StatusWith<OpTime> multiApply(OperationContext* txn,
     }
 
     std::vector<Status> statusVector(workerPool->getNumThreads(), Status::OK());
+    std::vector<long long> busyVector(workerPool->getNumThreads(), 0);
     {
         // We must wait for the all work we've dispatched to complete before leaving this block
         // because the spawned threads refer to objects on our stack, including writerVectors.
@@ -1285,7 +1371,10 @@ StatusWith<OpTime> multiApply(OperationContext* txn,
         storage->setOplogDeleteFromPoint(txn, Timestamp());
         storage->setMinValidToAtLeast(txn, ops.back().getOpTime());
 
-        applyOps(writerVectors, workerPool, applyOperation, &statusVector);
+        Timer batchTimer;
+        applyOps(writerVectors, workerPool, applyOperation, &statusVector, &busyVector);
+        workerPool->join();
+        writerUtilizationStats.recordBatch(writerVectors, busyVector, batchTimer.micros());
     }
 
     // If any of the statuses is not ok, return error.
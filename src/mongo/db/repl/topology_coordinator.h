@@ -265,6 +265,15 @@ public:
     // replset.
     virtual void fillIsMasterForReplSet(IsMasterResponse* response) = 0;
 
+    /**
+     * Returns the fields of fillIsMasterForReplSet()'s response that depend only on the topology,
+     * i.e. everything except lastWrite, as IsMasterResponse::addTopologyToBSON() would. These are
+     * only serialized again when the config, this node's state or the current primary changes.
+     * Sets 'hasConfig' to false if the response has no valid config, so no lastWrite should be
+     * appended.
+     */
+    virtual BSONObj getIsMasterTopology(bool* hasConfig) = 0;
+
     enum class PrepareFreezeResponseResult { kNoAction, kElectSelf };
 
     /**
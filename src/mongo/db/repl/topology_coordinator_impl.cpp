@@ -34,8 +34,10 @@
 
 #include <limits>
 
+#include "mongo/base/counter.h"
 #include "mongo/db/audit.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/heartbeat_response_action.h"
 #include "mongo/db/repl/is_master_response.h"
@@ -75,6 +77,14 @@ int indexOfIterator(const std::vector<T>& vec, typename std::vector<T>::const_it
 // Maximum number of retries for a failed heartbeat.
 const int kMaxHeartbeatRetries = 2;
 
+// How often getIsMasterTopology() could reuse the serialized topology of the last isMaster
+Counter64 isMasterCacheHits;
+ServerStatusMetricField<Counter64> displayIsMasterCacheHits("repl.isMasterCache.hits",
+                                                            &isMasterCacheHits);
+Counter64 isMasterCacheMisses;
+ServerStatusMetricField<Counter64> displayIsMasterCacheMisses("repl.isMasterCache.misses",
+                                                              &isMasterCacheMisses);
+
 /**
  * Returns true if the only up heartbeats are auth errors.
  */
@@ -1814,6 +1824,36 @@ void TopologyCoordinatorImpl::fillIsMasterForReplSet(IsMasterResponse* response)
     }
 }
 
+TopologyCoordinatorImpl::IsMasterCacheKey TopologyCoordinatorImpl::_getIsMasterCacheKey() const {
+    IsMasterCacheKey key;
+    key.configInitialized = _rsConfig.isInitialized();
+    key.configVersion = key.configInitialized ? _rsConfig.getConfigVersion() : -1;
+    key.selfIndex = _selfIndex;
+    key.memberState = getMemberState();
+    key.currentPrimaryIndex = _currentPrimaryIndex;
+    key.electionId = _iAmPrimary() ? _electionId : OID();
+    return key;
+}
+
+BSONObj TopologyCoordinatorImpl::getIsMasterTopology(bool* hasConfig) {
+    auto key = _getIsMasterCacheKey();
+    if (_isMasterCache && _isMasterCache->key == key) {
+        isMasterCacheHits.increment();
+    } else {
+        isMasterCacheMisses.increment();
+
+        IsMasterResponse isMasterResponse;
+        fillIsMasterForReplSet(&isMasterResponse);
+
+        BSONObjBuilder topology;
+        bool topologyHasConfig = isMasterResponse.addTopologyToBSON(&topology);
+        _isMasterCache = IsMasterCache{key, topology.obj(), topologyHasConfig};
+    }
+
+    *hasConfig = _isMasterCache->hasConfig;
+    return _isMasterCache->topology;
+}
+
 StatusWith<TopologyCoordinatorImpl::PrepareFreezeResponseResult>
 TopologyCoordinatorImpl::prepareFreezeResponse(Date_t now, int secs, BSONObjBuilder* response) {
     if (_role != TopologyCoordinator::Role::follower) {
@@ -194,6 +194,7 @@ public:
                                        BSONObjBuilder* response,
                                        Status* result);
     virtual void fillIsMasterForReplSet(IsMasterResponse* response);
+    virtual BSONObj getIsMasterTopology(bool* hasConfig);
     virtual StatusWith<PrepareFreezeResponseResult> prepareFreezeResponse(Date_t now,
                                                                           int secs,
                                                                           BSONObjBuilder* response);
@@ -466,6 +467,37 @@ private:
 
     // Whether or not the storage engine supports read committed.
     ReadCommittedSupport _storageEngineSupportsReadCommitted{ReadCommittedSupport::kUnknown};
+
+    // Everything that fillIsMasterForReplSet() reads, used to tell when the serialized topology
+    // in _isMasterCache is out of date. Config versions only increase, so the version stands in
+    // for the contents of _rsConfig.
+    struct IsMasterCacheKey {
+        bool operator==(const IsMasterCacheKey& other) const {
+            return configInitialized == other.configInitialized &&
+                configVersion == other.configVersion && selfIndex == other.selfIndex &&
+                memberState == other.memberState &&
+                currentPrimaryIndex == other.currentPrimaryIndex &&
+                electionId == other.electionId;
+        }
+
+        bool configInitialized;
+        long long configVersion;
+        int selfIndex;
+        MemberState memberState;
+        int currentPrimaryIndex;
+        OID electionId;
+    };
+
+    IsMasterCacheKey _getIsMasterCacheKey() const;
+
+    struct IsMasterCache {
+        IsMasterCacheKey key;
+        BSONObj topology;
+        bool hasConfig;
+    };
+
+    // The last topology serialized by getIsMasterTopology().
+    boost::optional<IsMasterCache> _isMasterCache;
 };
 
 }  // namespace repl
@@ -73,6 +73,9 @@ struct ServerGlobalParams {
 
     int maxConns = DEFAULT_MAX_CONN;  // Maximum number of simultaneous open connections.
 
+    std::string transportLayer = "legacy";  // --transportLayer (legacy|asio)
+    int transportLayerThreads = 0;          // --transportLayerThreads, 0 selects a default
+
     int unixSocketPermissions = DEFAULT_UNIX_PERMS;  // permissions for the UNIX domain socket
 
     std::string keyFile;  // Path to keyfile, or empty if none.
@@ -196,6 +196,22 @@ Status addGeneralServerOptions(moe::OptionSection* options) {
     options->addOptionChaining(
         "net.maxIncomingConnections", "maxConns", moe::Int, maxConnInfoBuilder.str().c_str());
 
+    options
+        ->addOptionChaining("net.transportLayer",
+                            "transportLayer",
+                            moe::String,
+                            "transport layer for incoming connections: legacy (a thread per "
+                            "connection) or asio (connections share a pool of worker threads)")
+        .hidden()
+        .format("(:?legacy)|(:?asio)", "(legacy/asio)");
+
+    options
+        ->addOptionChaining("net.transportLayerThreads",
+                            "transportLayerThreads",
+                            moe::Int,
+                            "number of worker threads for the asio transport layer")
+        .hidden();
+
     options
         ->addOptionChaining(
             "logpath",
@@ -879,6 +895,18 @@ Status storeServerOptions(const moe::Environment& params) {
         }
     }
 
+    if (params.count("net.transportLayer")) {
+        serverGlobalParams.transportLayer = params["net.transportLayer"].as<std::string>();
+    }
+
+    if (params.count("net.transportLayerThreads")) {
+        serverGlobalParams.transportLayerThreads = params["net.transportLayerThreads"].as<int>();
+
+        if (serverGlobalParams.transportLayerThreads < 0) {
+            return Status(ErrorCodes::BadValue, "transportLayerThreads cannot be negative");
+        }
+    }
+
     if (params.count("net.wireObjectCheck")) {
         serverGlobalParams.objcheck = params["net.wireObjectCheck"].as<bool>();
     }
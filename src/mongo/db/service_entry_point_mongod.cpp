@@ -37,6 +37,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/dbmessage.h"
 #include "mongo/db/instance.h"
+#include "mongo/db/server_options.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/service_entry_point_utils.h"
 #include "mongo/transport/session.h"
@@ -93,6 +94,19 @@ using transport::TransportLayer;
 ServiceEntryPointMongod::ServiceEntryPointMongod(TransportLayer* tl) : _tl(tl) {}
 
 void ServiceEntryPointMongod::startSession(transport::SessionHandle session) {
+    if (serverGlobalParams.transportLayer == "asio") {
+        // The session shares the TransportLayer's worker threads, each request running as a task.
+        // It is counted as a worker until it ends, so that shutdown waits for it to drain.
+        _nWorkers.fetchAndAdd(1);
+        launchServiceEntryTaskChain(
+            std::move(session),
+            [this](const transport::SessionHandle& session, Message* message) {
+                return _handleMessage(session, message);
+            },
+            [this] { _nWorkers.fetchAndSubtract(1); });
+        return;
+    }
+
     // Pass ownership of the transport::SessionHandle into our worker thread. When this
     // thread exits, the session will end.
     launchWrappedServiceEntryWorkerThread(
@@ -128,39 +142,43 @@ void ServiceEntryPointMongod::_sessionLoop(const transport::SessionHandle& sessi
             uassertStatusOK(status);
         }
 
-        // 2. Pass sourced Message up to mongod
-        DbResponse dbresponse;
-        {
-            auto opCtx = cc().makeOperationContext();
-            assembleResponse(opCtx.get(), inMessage, dbresponse, session->remote());
+        inExhaust = _handleMessage(session, &inMessage);
 
-            // opCtx must go out of scope here so that the operation cannot show
-            // up in currentOp results after the response reaches the client
+        if ((counter++ & 0xf) == 0) {
+            markThreadIdle();
         }
+    }
+}
 
-        // 3. Format our response, if we have one
-        Message& toSink = dbresponse.response;
-        if (!toSink.empty()) {
-            toSink.header().setId(nextMessageId());
-            toSink.header().setResponseToMsgId(inMessage.header().getId());
-
-            // If this is an exhaust cursor, don't source more Messages
-            if (dbresponse.exhaustNS.size() > 0 && setExhaustMessage(&inMessage, dbresponse)) {
-                inExhaust = true;
-            } else {
-                inExhaust = false;
-            }
+bool ServiceEntryPointMongod::_handleMessage(const transport::SessionHandle& session,
+                                             Message* inMessage) {
+    // 2. Pass sourced Message up to mongod
+    DbResponse dbresponse;
+    {
+        auto opCtx = cc().makeOperationContext();
+        assembleResponse(opCtx.get(), *inMessage, dbresponse, session->remote());
 
-            // 4. Sink our response to the client
-            uassertStatusOK(session->sinkMessage(toSink).wait());
-        } else {
-            inExhaust = false;
-        }
+        // opCtx must go out of scope here so that the operation cannot show
+        // up in currentOp results after the response reaches the client
+    }
 
-        if ((counter++ & 0xf) == 0) {
-            markThreadIdle();
-        }
+    // 3. Format our response, if we have one
+    Message& toSink = dbresponse.response;
+    if (toSink.empty()) {
+        return false;
     }
+
+    toSink.header().setId(nextMessageId());
+    toSink.header().setResponseToMsgId(inMessage->header().getId());
+
+    // If this is an exhaust cursor, don't source more Messages
+    const bool inExhaust =
+        dbresponse.exhaustNS.size() > 0 && setExhaustMessage(inMessage, dbresponse);
+
+    // 4. Sink our response to the client
+    uassertStatusOK(session->sinkMessage(toSink).wait());
+
+    return inExhaust;
 }
 
 }  // namespace mongo
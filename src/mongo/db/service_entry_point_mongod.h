@@ -36,6 +36,8 @@
 
 namespace mongo {
 
+class Message;
+
 namespace transport {
 class Session;
 class TransportLayer;
@@ -43,7 +45,8 @@ class TransportLayer;
 
 /**
  * The entry point from the TransportLayer into Mongod. startSession() spawns and
- * detaches a new thread for each incoming connection (transport::Session).
+ * detaches a new thread for each incoming connection (transport::Session), unless the asio
+ * transport layer is in use, in which case each request runs as a task on its worker threads.
  */
 class ServiceEntryPointMongod final : public ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPointMongod);
@@ -55,6 +58,10 @@ public:
 
     void startSession(transport::SessionHandle session) override;
 
+    /**
+     * Returns the number of sessions still being serviced: the threads of the thread-per-session
+     * model, or the sessions of the asio transport layer.
+     */
     std::size_t getNumberOfActiveWorkerThreads() const {
         return _nWorkers.load();
     }
@@ -62,6 +69,12 @@ public:
 private:
     void _sessionLoop(const transport::SessionHandle& session);
 
+    /**
+     * Runs one sourced Message and sinks its reply. Returns true if the Message was replaced
+     * with the next getMore of an exhaust cursor, which must be run without sourcing.
+     */
+    bool _handleMessage(const transport::SessionHandle& session, Message* inMessage);
+
     transport::TransportLayer* _tl;
     AtomicWord<std::size_t> _nWorkers;
 };
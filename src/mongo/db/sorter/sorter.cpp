@@ -47,7 +47,10 @@
 
 #include "mongo/db/sorter/sorter.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
+#include <exception>
+#include <memory>
 #include <snappy.h>
 #include <vector>
 
@@ -59,8 +62,12 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/mongos_options.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/print.h"
@@ -120,6 +127,125 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+// A run is only split into pieces of at least this many elements to be sorted on several threads
+const size_t kMinParallelSortRunSize = 64 * 1024;
+
+// Upper bound on the number of threads sorting a single run, and on the number of threads in the
+// pool which helps all Sorters in the process
+const unsigned kMaxParallelSortThreads = 4;
+
+/**
+ * Returns the pool whose threads sort pieces of large runs. It is shared by every Sorter, so that
+ * concurrent sorts cannot start more than kMaxParallelSortThreads helper threads between them.
+ */
+inline ThreadPool* getParallelSortThreadPool() {
+    static ThreadPool* pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "parallelSort";
+        options.minThreads = 0;
+        options.maxThreads = kMaxParallelSortThreads;
+        auto pool = new ThreadPool(options);
+        pool->startup();
+        return pool;
+    }();
+    return pool;
+}
+
+/**
+ * Stable-sorts [begin, end) by splitting it into up to 'numPieces' pieces of at least
+ * kMinParallelSortRunSize elements. The pieces are offered to getParallelSortThreadPool() and the
+ * calling thread sorts every piece which no pool thread has started yet, so a busy pool costs
+ * parallelism but never makes the sort wait for a free pool thread. The sorted pieces are then
+ * merged pairwise on the calling thread.
+ */
+template <typename Iterator, typename Less>
+void parallelStableSort(Iterator begin, Iterator end, const Less& less, unsigned numPieces) {
+    const size_t size = std::distance(begin, end);
+    numPieces = std::min<size_t>(numPieces, size / kMinParallelSortRunSize);
+    if (numPieces <= 1) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    struct Piece {
+        Iterator begin;
+        Iterator end;
+        AtomicWord<bool> claimed;
+        std::exception_ptr exception;
+    };
+
+    // Pool tasks may only run after this call has returned, by which time the calling thread has
+    // sorted their pieces itself, so the pieces are owned jointly with the scheduled tasks.
+    struct State {
+        explicit State(unsigned numPieces) : pieces(new Piece[numPieces]) {}
+
+        std::unique_ptr<Piece[]> pieces;
+        stdx::mutex mutex;
+        stdx::condition_variable pieceSorted;
+        unsigned piecesSorted = 0;
+    };
+
+    auto state = std::make_shared<State>(numPieces);
+    for (unsigned i = 0; i < numPieces; i++) {
+        state->pieces[i].begin = begin + size * i / numPieces;
+        state->pieces[i].end = begin + size * (i + 1) / numPieces;
+    }
+
+    // 'less' is only used by whoever claims a piece, and this call outlives every claimed piece
+    auto sortPiece = [&less](State* state, Piece* piece) {
+        if (piece->claimed.swap(true)) {
+            return;
+        }
+        try {
+            std::stable_sort(piece->begin, piece->end, less);
+        } catch (...) {
+            piece->exception = std::current_exception();
+        }
+        stdx::lock_guard<stdx::mutex> lk(state->mutex);
+        ++state->piecesSorted;
+        state->pieceSorted.notify_all();
+    };
+
+    // A piece whose task can't be scheduled is simply left to the calling thread
+    for (unsigned i = 1; i < numPieces; i++) {
+        Piece* piece = &state->pieces[i];
+        getParallelSortThreadPool()->schedule(
+            [state, piece, sortPiece] { sortPiece(state.get(), piece); });
+    }
+
+    for (unsigned i = 0; i < numPieces; i++) {
+        sortPiece(state.get(), &state->pieces[i]);
+    }
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(state->mutex);
+        state->pieceSorted.wait(lk, [&] { return state->piecesSorted == numPieces; });
+    }
+
+    Piece* pieces = state->pieces.get();
+    for (unsigned i = 0; i < numPieces; i++) {
+        if (pieces[i].exception) {
+            std::rethrow_exception(pieces[i].exception);
+        }
+    }
+
+    // Merging neighbouring pieces, from the left, keeps the sort stable
+    for (unsigned width = 1; width < numPieces; width *= 2) {
+        for (unsigned i = 0; i + width < numPieces; i += 2 * width) {
+            const unsigned last = std::min(i + 2 * width, numPieces) - 1;
+            std::inplace_merge(pieces[i].begin, pieces[i + width].begin, pieces[last].end, less);
+        }
+    }
+}
+
+/** Stable-sorts [begin, end), spreading large runs over several threads */
+template <typename Iterator, typename Less>
+void sortRun(Iterator begin, Iterator end, const Less& less) {
+    const unsigned numThreads =
+        std::max(1U, std::min(kMaxParallelSortThreads, stdx::thread::hardware_concurrency()));
+    parallelStableSort(begin, end, less, numThreads);
+}
+
 /** Ensures a named file is deleted when this object goes out of scope */
 class FileDeleter {
 public:
@@ -472,7 +598,7 @@ private:
 
     void sort() {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        sortRun(_data.begin(), _data.end(), less);
 
         // Does 2x more compares than stable_sort
         // TODO test on windows
@@ -675,7 +801,7 @@ private:
         if (_data.size() == _opts.limit) {
             std::sort_heap(_data.begin(), _data.end(), less);
         } else {
-            std::stable_sort(_data.begin(), _data.end(), less);
+            sortRun(_data.begin(), _data.end(), less);
         }
     }
 
@@ -336,6 +336,38 @@ public:
     }
 };
 
+class ParallelStableSortTests {
+public:
+    void run() {
+        const size_t numItems = 16 * sorter::kMinParallelSortRunSize;
+
+        // Few distinct keys, so that stability matters. The second member records the input order.
+        std::vector<std::pair<int, int>> input;
+        input.reserve(numItems);
+        for (size_t i = 0; i < numItems; i++) {
+            input.emplace_back(std::rand() % 1000, i);
+        }
+
+        auto less = [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
+            return lhs.first < rhs.first;
+        };
+
+        std::vector<std::pair<int, int>> expected(input);
+        std::stable_sort(expected.begin(), expected.end(), less);
+
+        for (unsigned numThreads = 1; numThreads <= 8; numThreads *= 2) {
+            std::vector<std::pair<int, int>> vec(input);
+            sorter::parallelStableSort(vec.begin(), vec.end(), less, numThreads);
+            ASSERT(vec == expected);
+
+            // NoLimitSorter sorts its runs in a deque
+            std::deque<std::pair<int, int>> deque(input.begin(), input.end());
+            sorter::parallelStableSort(deque.begin(), deque.end(), less, numThreads);
+            ASSERT(std::equal(deque.begin(), deque.end(), expected.begin()));
+        }
+    }
+};
+
 namespace SorterTests {
 class Basic {
 public:
@@ -521,6 +553,19 @@ public:
 };
 
 
+template <bool Random = true>
+class LotsOfDataParallelSort : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) {
+        // Make sure the runs are large enough to be sorted on several threads and that we spill
+        MONGO_STATIC_ASSERT(MEM_LIMIT / sizeof(IWPair) > 2 * sorter::kMinParallelSortRunSize);
+        MONGO_STATIC_ASSERT(MEM_LIMIT / sizeof(IWPair) < Parent::NUM_ITEMS);
+
+        return opts.MaxMemoryUsageBytes(MEM_LIMIT).ExtSortAllowed();
+    }
+    enum { MEM_LIMIT = 2 * 1024 * 1024 };
+};
+
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
@@ -554,11 +599,14 @@ public:
         add<InMemIterTests>();
         add<SortedFileWriterAndFileIteratorTests>();
         add<MergeIteratorTests>();
+        add<ParallelStableSortTests>();
         add<SorterTests::Basic>();
         add<SorterTests::Limit>();
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/false>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
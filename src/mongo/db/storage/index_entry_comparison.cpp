@@ -69,13 +69,18 @@ int IndexEntryComparison::compare(const IndexKeyEntry& lhs, const IndexKeyEntry&
         const BSONElement l = lhsIt.next();
         const BSONElement r = rhsIt.next();
 
-        if (int cmp = l.woCompare(r, /*compareFieldNames=*/false)) {
-            if (cmp == std::numeric_limits<int>::min()) {
-                // can't be negated
-                cmp = -1;
+        // Values with identical bytes always compare equal, so a memcmp is enough to step over
+        // the leading fields that neighbouring keys of a compound index usually share. Field
+        // names are not part of the check, so exclusive query fields are still handled below.
+        if (!l.binaryEqualValues(r)) {
+            if (int cmp = l.woCompare(r, /*compareFieldNames=*/false)) {
+                if (cmp == std::numeric_limits<int>::min()) {
+                    // can't be negated
+                    cmp = -1;
+                }
+
+                return _order.descending(mask) ? -cmp : cmp;
             }
-
-            return _order.descending(mask) ? -cmp : cmp;
         }
 
         // Here is where the weirdness begins. We sometimes want to fudge the comparison
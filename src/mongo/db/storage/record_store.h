@@ -31,6 +31,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -267,6 +268,20 @@ public:
     virtual std::unique_ptr<RecordFetcher> fetcherForId(const RecordId& id) const {
         return {};
     }
+
+    /**
+     * Looks up the Records with the provided ids in whatever order suits the storage engine, and
+     * appends them to 'out' in the order of 'ids'. An entry is boost::none if there is no Record
+     * with that id. Unlike seekExact(), the returned Records own their data.
+     *
+     * Returns false, without looking anything up, if the cursor cannot do better than a
+     * seekExact() call per id. The resulting position of the cursor is unspecified. If a
+     * WriteConflictException is thrown, the contents of 'out' are unspecified.
+     */
+    virtual bool seekExactBatch(const std::vector<RecordId>& ids,
+                                std::vector<boost::optional<Record>>* out) {
+        return false;
+    }
 };
 
 /**
@@ -66,6 +66,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/background.h"
@@ -284,6 +285,10 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sizeStorer->fillCache();
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
+
+    _ticketController = stdx::make_unique<WiredTigerTicketController>(
+        _conn, &openReadTransaction, &openWriteTransaction);
+    _ticketController->go();
 }
 
 
@@ -311,6 +316,11 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("totalTickets", openReadTransaction.outof());
         bbb.done();
     }
+    {
+        BSONObjBuilder bbb(bb.subobjStart("adaptive"));
+        WiredTigerTicketController::appendStats(&bbb);
+        bbb.done();
+    }
     bb.done();
 }
 
@@ -320,6 +330,8 @@ void WiredTigerKVEngine::cleanShutdown() {
         syncSizeInfo(true);
     if (_conn) {
         // these must be the last things we do before _conn->close();
+        if (_ticketController)
+            _ticketController->shutdown();
         if (_journalFlusher)
             _journalFlusher->shutdown();
         _sizeStorer.reset();
@@ -49,6 +49,7 @@ class ClockSource;
 class JournalListener;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
+class WiredTigerTicketController;
 
 class WiredTigerKVEngine final : public KVEngine {
 public:
@@ -177,6 +178,7 @@ private:
     bool _ephemeral;
     bool _readOnly;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
+    std::unique_ptr<WiredTigerTicketController> _ticketController;
 
     std::string _rsOptions;
     std::string _indexOptions;
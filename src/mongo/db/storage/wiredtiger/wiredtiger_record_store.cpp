@@ -35,6 +35,8 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
+#include <algorithm>
+#include <numeric>
 #include <wiredtiger.h>
 
 #include "mongo/base/checked_cast.h"
@@ -502,6 +504,30 @@ public:
         return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
     }
 
+    bool seekExactBatch(const std::vector<RecordId>& ids,
+                        std::vector<boost::optional<Record>>* out) final {
+        // Look the records up in key order, so that consecutive searches walk the table in one
+        // direction and reuse the pages the previous ones brought into cache, rather than
+        // jumping around in index order.
+        std::vector<size_t> order(ids.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&ids](size_t lhs, size_t rhs) {
+            return ids[lhs] < ids[rhs];
+        });
+
+        const size_t firstOut = out->size();
+        out->resize(firstOut + ids.size());
+        for (size_t i : order) {
+            auto record = seekExact(ids[i]);
+            if (record) {
+                // The next search reuses the cursor's buffer.
+                record->data.makeOwned();
+            }
+            (*out)[firstOut + i] = std::move(record);
+        }
+        return true;
+    }
+
     void save() final {
         try {
             if (_cursor)
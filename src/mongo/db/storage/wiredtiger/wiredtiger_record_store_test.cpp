@@ -310,6 +310,52 @@ TEST(WiredTigerRecordStoreTest, Isolation2) {
     }
 }
 
+TEST(WiredTigerRecordStoreTest, SeekExactBatchReturnsRecordsInRequestedOrder) {
+    unique_ptr<HarnessHelper> harnessHelper(newHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < 10; i++) {
+            const std::string data = str::stream() << "record" << i;
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, false);
+            ASSERT_OK(res.getStatus());
+            ids.push_back(res.getValue());
+        }
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getCursor(opCtx.get());
+
+    // Out of key order, with a duplicate and an id that does not exist.
+    const RecordId missing(ids.back().repr() + 100);
+    const std::vector<int> order{7, 2, 9, 2, -1, 0, 5};
+    std::vector<RecordId> request;
+    for (int i : order) {
+        request.push_back(i < 0 ? missing : ids[i]);
+    }
+
+    std::vector<boost::optional<Record>> records;
+    ASSERT(cursor->seekExactBatch(request, &records));
+    ASSERT_EQ(order.size(), records.size());
+
+    for (size_t i = 0; i < order.size(); i++) {
+        if (order[i] < 0) {
+            ASSERT(!records[i]);
+            continue;
+        }
+        ASSERT(records[i]);
+        ASSERT_EQ(request[i], records[i]->id);
+        ASSERT(records[i]->data.isOwned());
+        ASSERT_EQ(std::string(str::stream() << "record" << order[i]),
+                  std::string(records[i]->data.data()));
+    }
+}
+
 TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -40,6 +40,8 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/scopeguard.h"
 
@@ -47,6 +49,82 @@ namespace mongo {
 
 using std::string;
 
+namespace {
+
+const char kStatisticsURI[] = "statistics:";
+const char kStatisticsConfig[] = "statistics=(fast)";
+
+// The connection statistics a WiredTiger build has never change, so the keys under each field
+// are only looked up once.
+stdx::mutex statisticsKeysMutex;
+std::unique_ptr<WiredTigerUtil::StatisticsKeysByField> statisticsKeys;
+
+StatusWith<const WiredTigerUtil::StatisticsKeysByField*> getStatisticsKeys(WT_SESSION* s) {
+    stdx::lock_guard<stdx::mutex> lk(statisticsKeysMutex);
+    if (!statisticsKeys) {
+        auto swKeys =
+            WiredTigerUtil::getStatisticsKeysByField(s, kStatisticsURI, kStatisticsConfig);
+        if (!swKeys.isOK()) {
+            return swKeys.getStatus();
+        }
+        statisticsKeys =
+            stdx::make_unique<WiredTigerUtil::StatisticsKeysByField>(std::move(swKeys.getValue()));
+    }
+    return statisticsKeys.get();
+}
+
+void appendStatisticsError(const Status& status, BSONObjBuilder* bob) {
+    bob->append("error", "unable to retrieve statistics");
+    bob->append("code", static_cast<int>(status.code()));
+    bob->append("reason", status.reason());
+}
+
+/**
+ * Generates only the named top-level fields of the section. The WiredTiger statistics under those
+ * fields are read by key, so that frequent samplers such as high resolution FTDC do not pay for
+ * reading every statistic.
+ */
+BSONObj generateIncludedFields(WT_SESSION* s, const BSONObj& include) {
+    BSONObjBuilder bob;
+
+    auto swKeys = getStatisticsKeys(s);
+    if (swKeys.isOK()) {
+        std::vector<int> keys;
+        for (auto&& field : include) {
+            if (field.type() != String)
+                continue;
+            auto it = swKeys.getValue()->find(field.str());
+            if (it != swKeys.getValue()->end())
+                keys.insert(keys.end(), it->second.begin(), it->second.end());
+        }
+
+        if (!keys.empty()) {
+            Status status = WiredTigerUtil::exportStatisticsToBSON(
+                s, kStatisticsURI, kStatisticsConfig, keys, &bob);
+            if (!status.isOK()) {
+                appendStatisticsError(status, &bob);
+            }
+        }
+    } else {
+        appendStatisticsError(swKeys.getStatus(), &bob);
+    }
+
+    BSONObjBuilder globalStats;
+    WiredTigerKVEngine::appendGlobalStats(globalStats);
+    BSONObj global = globalStats.obj();
+    for (auto&& field : include) {
+        if (field.type() != String)
+            continue;
+        BSONElement elem = global[field.valueStringData()];
+        if (!elem.eoo())
+            bob.append(elem);
+    }
+
+    return bob.obj();
+}
+
+}  // namespace
+
 WiredTigerServerStatusSection::WiredTigerServerStatusSection(WiredTigerKVEngine* engine)
     : ServerStatusSection(kWiredTigerEngineName), _engine(engine) {}
 
@@ -64,14 +142,19 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* txn,
 
     WT_SESSION* s = session->getSession();
     invariant(s);
-    const string uri = "statistics:";
+
+    // {wiredTiger: {include: [<field>, ...]}} generates only the named top-level fields.
+    if (configElement.type() == Object) {
+        BSONElement include = configElement.Obj()["include"];
+        if (include.type() == Array) {
+            return generateIncludedFields(s, include.Obj());
+        }
+    }
 
     BSONObjBuilder bob;
-    Status status = WiredTigerUtil::exportTableToBSON(s, uri, "statistics=(fast)", &bob);
+    Status status = WiredTigerUtil::exportTableToBSON(s, kStatisticsURI, kStatisticsConfig, &bob);
     if (!status.isOK()) {
-        bob.append("error", "unable to retrieve statistics");
-        bob.append("code", static_cast<int>(status.code()));
-        bob.append("reason", status.reason());
+        appendStatisticsError(status, &bob);
     }
 
     WiredTigerKVEngine::appendGlobalStats(bob);
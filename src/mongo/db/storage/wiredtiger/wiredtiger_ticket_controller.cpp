@@ -0,0 +1,411 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/log.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrentTransactions, bool, false);
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrentTransactionsMin, int, 16);
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrentTransactionsMax, int, 256);
+
+namespace {
+
+// TicketHolder refuses to shrink below this.
+const int kMinimumTickets = 5;
+
+// Ticket availability is polled this often, and decisions are made once per interval.
+const Milliseconds kPollInterval(100);
+const int kPollsPerInterval = 10;
+
+// How often to check whether the controller has been enabled while it is disabled.
+const Milliseconds kDisabledCheckInterval(5000);
+
+// The cache is considered under pressure when application threads evict pages at more than this
+// rate while the cache is nearly full, or when dirty data passes this fraction of the cache size.
+// WiredTiger only asks application threads to evict above its eviction triggers, so an occasional
+// application eviction is normal and does not count.
+const double kApplicationEvictionsPerSecPressure = 100;
+const double kUsedPressureFraction = 0.95;
+const double kDirtyPressureFraction = 0.20;
+
+struct HolderStats {
+    int tickets = 0;
+    double saturation = 0;
+    const char* lastAction = "hold";
+    long long grows = 0;
+    long long shrinks = 0;
+    long long reverts = 0;
+};
+
+struct ControllerStats {
+    long long intervals = 0;
+    double throughputPerSec = 0;
+    double estimatedLatencyMicros = 0;
+    double cacheUsedFraction = 0;
+    double cacheDirtyFraction = 0;
+    long long applicationEvictions = 0;
+    HolderStats read;
+    HolderStats write;
+};
+
+stdx::mutex controllerStatsMutex;
+ControllerStats controllerStats;
+
+struct WiredTigerCounters {
+    uint64_t transactions = 0;
+    uint64_t applicationEvictions = 0;
+    uint64_t cacheBytesInUse = 0;
+    uint64_t cacheBytesDirty = 0;
+    uint64_t cacheBytesMax = 0;
+};
+
+StatusWith<WiredTigerCounters> readCounters(WT_SESSION* session) {
+    WiredTigerCounters counters;
+    const std::pair<int, uint64_t*> wanted[] = {
+        {WT_STAT_CONN_TXN_COMMIT, &counters.transactions},
+        {WT_STAT_CONN_CACHE_EVICTION_APP, &counters.applicationEvictions},
+        {WT_STAT_CONN_CACHE_BYTES_INUSE, &counters.cacheBytesInUse},
+        {WT_STAT_CONN_CACHE_BYTES_DIRTY, &counters.cacheBytesDirty},
+        {WT_STAT_CONN_CACHE_BYTES_MAX, &counters.cacheBytesMax},
+    };
+    for (auto&& stat : wanted) {
+        auto swValue = WiredTigerUtil::getStatisticsValue(
+            session, "statistics:", "statistics=(fast)", stat.first);
+        if (!swValue.isOK()) {
+            return swValue.getStatus();
+        }
+        *stat.second = swValue.getValue();
+    }
+
+    auto swRollbacks = WiredTigerUtil::getStatisticsValue(
+        session, "statistics:", "statistics=(fast)", WT_STAT_CONN_TXN_ROLLBACK);
+    if (!swRollbacks.isOK()) {
+        return swRollbacks.getStatus();
+    }
+    counters.transactions += swRollbacks.getValue();
+    return counters;
+}
+
+void recordDecision(HolderStats* stats,
+                    const WiredTigerTicketPolicy::Sample& sample,
+                    const WiredTigerTicketPolicy::Decision& decision) {
+    stats->tickets = decision.tickets;
+    stats->saturation = sample.saturation;
+    stats->lastAction = WiredTigerTicketPolicy::actionName(decision.action);
+    switch (decision.action) {
+        case WiredTigerTicketPolicy::Action::kGrow:
+            stats->grows++;
+            break;
+        case WiredTigerTicketPolicy::Action::kShrink:
+            stats->shrinks++;
+            break;
+        case WiredTigerTicketPolicy::Action::kRevert:
+            stats->reverts++;
+            break;
+        case WiredTigerTicketPolicy::Action::kHold:
+            break;
+    }
+}
+
+void appendHolderStats(const HolderStats& stats, BSONObjBuilder* b) {
+    b->append("tickets", stats.tickets);
+    b->append("saturation", stats.saturation);
+    b->append("lastAction", stats.lastAction);
+    b->append("grows", stats.grows);
+    b->append("shrinks", stats.shrinks);
+    b->append("reverts", stats.reverts);
+}
+
+}  // namespace
+
+//
+// WiredTigerTicketPolicy
+//
+
+const double WiredTigerTicketPolicy::kSaturationThreshold = 0.5;
+const double WiredTigerTicketPolicy::kRegressionThreshold = 0.95;
+
+WiredTigerTicketPolicy::Decision WiredTigerTicketPolicy::decide(const Sample& sample,
+                                                                int currentTickets,
+                                                                int minTickets,
+                                                                int maxTickets) {
+    // The bounds can be changed at runtime, so bring the current count back within them first.
+    if (currentTickets < minTickets) {
+        _evaluatingGrow = false;
+        return {Action::kGrow, minTickets};
+    }
+    if (currentTickets > maxTickets) {
+        _evaluatingGrow = false;
+        return {Action::kShrink, maxTickets};
+    }
+
+    if (sample.cachePressure) {
+        // More concurrent transactions would only add to the pressure. Abandon any grow we were
+        // evaluating, since its throughput is no longer comparable, and back off a step once the
+        // pressure has lasted long enough that it is not just a burst.
+        _evaluatingGrow = false;
+        if (++_pressureIntervals < kPressureIntervals) {
+            return {Action::kHold, currentTickets};
+        }
+        _pressureIntervals = 0;
+        const int target = std::max(minTickets, currentTickets - std::max(1, currentTickets / 8));
+        if (target < currentTickets) {
+            return {Action::kShrink, target};
+        }
+        return {Action::kHold, currentTickets};
+    }
+    _pressureIntervals = 0;
+
+    if (_evaluatingGrow) {
+        _evaluatingGrow = false;
+        if (sample.throughput < _throughputBeforeGrow * kRegressionThreshold) {
+            _cooldown = kCooldownIntervals;
+            return {Action::kRevert, std::max(minTickets, _ticketsBeforeGrow)};
+        }
+    }
+
+    if (_cooldown > 0) {
+        --_cooldown;
+        return {Action::kHold, currentTickets};
+    }
+
+    if (sample.saturation >= kSaturationThreshold && currentTickets < maxTickets) {
+        _evaluatingGrow = true;
+        _ticketsBeforeGrow = currentTickets;
+        _throughputBeforeGrow = sample.throughput;
+        const int step = std::max(8, currentTickets / 8);
+        return {Action::kGrow, std::min(maxTickets, currentTickets + step)};
+    }
+
+    return {Action::kHold, currentTickets};
+}
+
+const char* WiredTigerTicketPolicy::actionName(Action action) {
+    switch (action) {
+        case Action::kHold:
+            return "hold";
+        case Action::kGrow:
+            return "grow";
+        case Action::kShrink:
+            return "shrink";
+        case Action::kRevert:
+            return "revert";
+    }
+    MONGO_UNREACHABLE;
+}
+
+//
+// WiredTigerTicketController
+//
+
+WiredTigerTicketController::WiredTigerTicketController(WT_CONNECTION* conn,
+                                                       TicketHolder* readTickets,
+                                                       TicketHolder* writeTickets)
+    : BackgroundJob(false /* deleteSelf */),
+      _conn(conn),
+      _readTickets(readTickets),
+      _writeTickets(writeTickets) {}
+
+void WiredTigerTicketController::run() {
+    Client::initThread(name().c_str());
+
+    LOG(1) << "starting " << name() << " thread";
+
+    WiredTigerSession session(_conn);
+    bool havePrevious = false;
+    WiredTigerCounters previous;
+
+    while (true) {
+        if (!wiredTigerAdaptiveConcurrentTransactions.load()) {
+            // Start from a fresh baseline if the controller is enabled again later.
+            havePrevious = false;
+            _readPolicy = WiredTigerTicketPolicy();
+            _writePolicy = WiredTigerTicketPolicy();
+            if (!_sleepFor(kDisabledCheckInterval)) {
+                break;
+            }
+            continue;
+        }
+
+        Timer intervalTimer;
+        int readSaturatedPolls = 0;
+        int writeSaturatedPolls = 0;
+        long long ticketsInUse = 0;
+        bool shuttingDown = false;
+        for (int i = 0; i < kPollsPerInterval; i++) {
+            if (!_sleepFor(kPollInterval)) {
+                shuttingDown = true;
+                break;
+            }
+            readSaturatedPolls += _readTickets->available() <= 0;
+            writeSaturatedPolls += _writeTickets->available() <= 0;
+            ticketsInUse += _readTickets->used() + _writeTickets->used();
+        }
+
+        if (shuttingDown) {
+            break;
+        }
+
+        auto swCounters = readCounters(session.getSession());
+        if (!swCounters.isOK()) {
+            LOG(1) << name() << " unable to read WiredTiger statistics: " << swCounters.getStatus();
+            continue;
+        }
+        const WiredTigerCounters current = swCounters.getValue();
+        if (!havePrevious) {
+            havePrevious = true;
+            previous = current;
+            continue;
+        }
+
+        const uint64_t transactions = current.transactions - previous.transactions;
+        const uint64_t applicationEvictions =
+            current.applicationEvictions - previous.applicationEvictions;
+        previous = current;
+
+        const double intervalSecs = std::max(intervalTimer.micros(), 1000LL) / (1000.0 * 1000);
+        const double cacheMax = std::max<uint64_t>(current.cacheBytesMax, 1);
+        const double usedFraction = current.cacheBytesInUse / cacheMax;
+        const double dirtyFraction = current.cacheBytesDirty / cacheMax;
+        const bool evicting = usedFraction > kUsedPressureFraction &&
+            applicationEvictions / intervalSecs > kApplicationEvictionsPerSecPressure;
+
+        WiredTigerTicketPolicy::Sample readSample;
+        readSample.saturation = double(readSaturatedPolls) / kPollsPerInterval;
+        readSample.throughput = transactions;
+        readSample.cachePressure = evicting;
+
+        WiredTigerTicketPolicy::Sample writeSample;
+        writeSample.saturation = double(writeSaturatedPolls) / kPollsPerInterval;
+        writeSample.throughput = transactions;
+        writeSample.cachePressure = evicting || dirtyFraction > kDirtyPressureFraction;
+
+        const int minTickets =
+            std::max(kMinimumTickets, wiredTigerAdaptiveConcurrentTransactionsMin.load());
+        const int maxTickets =
+            std::max(minTickets, wiredTigerAdaptiveConcurrentTransactionsMax.load());
+
+        auto applyDecision = [&](const char* which,
+                                 TicketHolder* holder,
+                                 WiredTigerTicketPolicy* policy,
+                                 const WiredTigerTicketPolicy::Sample& sample) {
+            const int currentTickets = holder->outof();
+            auto decision = policy->decide(sample, currentTickets, minTickets, maxTickets);
+            if (decision.tickets != currentTickets) {
+                LOG(1) << name() << " resizing " << which << " tickets from " << currentTickets
+                       << " to " << decision.tickets << " ("
+                       << WiredTigerTicketPolicy::actionName(decision.action)
+                       << ", saturation: " << sample.saturation
+                       << ", transactions: " << sample.throughput
+                       << ", cache pressure: " << sample.cachePressure << ")";
+                Status status = holder->resize(decision.tickets);
+                if (!status.isOK()) {
+                    warning() << name() << " failed to resize " << which
+                              << " tickets: " << status;
+                    decision = {WiredTigerTicketPolicy::Action::kHold, holder->outof()};
+                }
+            }
+            return decision;
+        };
+
+        const auto readDecision = applyDecision("read", _readTickets, &_readPolicy, readSample);
+        const auto writeDecision =
+            applyDecision("write", _writeTickets, &_writePolicy, writeSample);
+
+        const double throughputPerSec = transactions / intervalSecs;
+        const double avgTicketsInUse = double(ticketsInUse) / kPollsPerInterval;
+
+        stdx::lock_guard<stdx::mutex> lk(controllerStatsMutex);
+        controllerStats.intervals++;
+        controllerStats.throughputPerSec = throughputPerSec;
+        // Little's law: the average number of transactions in flight divided by their completion
+        // rate gives the average time each one spends holding a ticket.
+        controllerStats.estimatedLatencyMicros =
+            throughputPerSec > 0 ? avgTicketsInUse / throughputPerSec * 1000 * 1000 : 0;
+        controllerStats.cacheUsedFraction = usedFraction;
+        controllerStats.cacheDirtyFraction = dirtyFraction;
+        controllerStats.applicationEvictions = applicationEvictions;
+        recordDecision(&controllerStats.read, readSample, readDecision);
+        recordDecision(&controllerStats.write, writeSample, writeDecision);
+    }
+
+    LOG(1) << "stopping " << name() << " thread";
+}
+
+void WiredTigerTicketController::shutdown() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _shuttingDown = true;
+    }
+    _shutdownCV.notify_all();
+    wait();
+}
+
+bool WiredTigerTicketController::_sleepFor(Milliseconds duration) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    return !_shutdownCV.wait_for(lk, duration.toSystemDuration(), [&] { return _shuttingDown; });
+}
+
+void WiredTigerTicketController::appendStats(BSONObjBuilder* b) {
+    stdx::lock_guard<stdx::mutex> lk(controllerStatsMutex);
+    b->append("enabled", wiredTigerAdaptiveConcurrentTransactions.load());
+    b->append("intervals", controllerStats.intervals);
+    b->append("throughputPerSec", controllerStats.throughputPerSec);
+    b->append("estimatedLatencyMicros", controllerStats.estimatedLatencyMicros);
+    b->append("cacheUsedFraction", controllerStats.cacheUsedFraction);
+    b->append("cacheDirtyFraction", controllerStats.cacheDirtyFraction);
+    b->append("applicationEvictions", controllerStats.applicationEvictions);
+    {
+        BSONObjBuilder read(b->subobjStart("read"));
+        appendHolderStats(controllerStats.read, &read);
+    }
+    {
+        BSONObjBuilder write(b->subobjStart("write"));
+        appendHolderStats(controllerStats.write, &write);
+    }
+}
+
+}  // namespace mongo
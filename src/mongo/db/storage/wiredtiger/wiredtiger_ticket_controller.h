@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <wiredtiger.h>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/background.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class TicketHolder;
+
+extern std::atomic<bool> wiredTigerAdaptiveConcurrentTransactions;  // NOLINT
+extern std::atomic<int> wiredTigerAdaptiveConcurrentTransactionsMin;  // NOLINT
+extern std::atomic<int> wiredTigerAdaptiveConcurrentTransactionsMax;  // NOLINT
+
+/**
+ * Decides how many tickets a single TicketHolder should have, one sampling interval at a time.
+ *
+ * The policy grows the ticket count additively while the tickets are saturated, keeps a grow only
+ * if throughput did not drop as a result, and shrinks by a small step while the WiredTiger cache
+ * stays under pressure. Separated from the sampling thread so that it can be tested directly.
+ */
+class WiredTigerTicketPolicy {
+public:
+    struct Sample {
+        // Fraction of the polls during the interval at which no ticket was available.
+        double saturation = 0;
+
+        // Transactions committed or rolled back during the interval.
+        uint64_t throughput = 0;
+
+        // True if the WiredTiger cache was under pressure during the interval.
+        bool cachePressure = false;
+    };
+
+    enum class Action { kHold, kGrow, kShrink, kRevert };
+
+    struct Decision {
+        Action action;
+        int tickets;
+    };
+
+    // The tickets are considered saturated if none were available at least this often.
+    static const double kSaturationThreshold;
+
+    // A grow is undone if throughput falls below this fraction of what it was before the grow.
+    static const double kRegressionThreshold;
+
+    // Number of intervals to wait after undoing a grow before trying to grow again.
+    static const int kCooldownIntervals = 5;
+
+    // Number of consecutive intervals of cache pressure needed before each shrink, so that a
+    // passing burst of eviction does not cost tickets.
+    static const int kPressureIntervals = 3;
+
+    Decision decide(const Sample& sample, int currentTickets, int minTickets, int maxTickets);
+
+    static const char* actionName(Action action);
+
+private:
+    // Set for the interval following a grow, so that the effect of the grow can be evaluated.
+    bool _evaluatingGrow = false;
+    int _ticketsBeforeGrow = 0;
+    uint64_t _throughputBeforeGrow = 0;
+
+    int _cooldown = 0;
+    int _pressureIntervals = 0;
+};
+
+/**
+ * Background thread that resizes the WiredTiger read and write TicketHolders while
+ * wiredTigerAdaptiveConcurrentTransactions is enabled. Every second it combines ticket usage
+ * polled during the interval with WiredTiger's transaction and cache statistics, and applies the
+ * decisions of a WiredTigerTicketPolicy per holder.
+ */
+class WiredTigerTicketController : public BackgroundJob {
+    MONGO_DISALLOW_COPYING(WiredTigerTicketController);
+
+public:
+    WiredTigerTicketController(WT_CONNECTION* conn,
+                               TicketHolder* readTickets,
+                               TicketHolder* writeTickets);
+
+    std::string name() const override {
+        return "WTTicketController";
+    }
+
+    void run() override;
+
+    void shutdown();
+
+    /**
+     * Appends the most recent measurements and decisions of the controller, and how many of each
+     * kind of decision it has made.
+     */
+    static void appendStats(BSONObjBuilder* b);
+
+private:
+    WT_CONNECTION* const _conn;
+    TicketHolder* const _readTickets;
+    TicketHolder* const _writeTickets;
+
+    WiredTigerTicketPolicy _readPolicy;
+    WiredTigerTicketPolicy _writePolicy;
+
+    // Sleeps for 'duration' unless shut down first. Returns false once shutting down.
+    bool _sleepFor(Milliseconds duration);
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _shutdownCV;
+    bool _shuttingDown = false;
+};
+
+}  // namespace mongo
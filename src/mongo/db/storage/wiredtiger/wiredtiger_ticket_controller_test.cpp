@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_controller.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Action = WiredTigerTicketPolicy::Action;
+using Sample = WiredTigerTicketPolicy::Sample;
+
+const int kMin = 16;
+const int kMax = 256;
+
+Sample makeSample(double saturation, uint64_t throughput, bool cachePressure = false) {
+    Sample sample;
+    sample.saturation = saturation;
+    sample.throughput = throughput;
+    sample.cachePressure = cachePressure;
+    return sample;
+}
+
+TEST(WiredTigerTicketPolicyTest, HoldsWhenNotSaturated) {
+    WiredTigerTicketPolicy policy;
+    auto decision = policy.decide(makeSample(0.1, 1000), 128, kMin, kMax);
+    ASSERT(decision.action == Action::kHold);
+    ASSERT_EQ(128, decision.tickets);
+}
+
+TEST(WiredTigerTicketPolicyTest, GrowsWhileSaturatedAndThroughputHolds) {
+    WiredTigerTicketPolicy policy;
+    auto decision = policy.decide(makeSample(1.0, 1000), 128, kMin, kMax);
+    ASSERT(decision.action == Action::kGrow);
+    ASSERT_EQ(144, decision.tickets);
+
+    // Throughput improved, so the grow is kept and, still saturated, we grow again.
+    decision = policy.decide(makeSample(1.0, 1100), 144, kMin, kMax);
+    ASSERT(decision.action == Action::kGrow);
+    ASSERT_EQ(162, decision.tickets);
+}
+
+TEST(WiredTigerTicketPolicyTest, GrowIsRevertedIfThroughputDrops) {
+    WiredTigerTicketPolicy policy;
+    auto decision = policy.decide(makeSample(1.0, 1000), 64, kMin, kMax);
+    ASSERT(decision.action == Action::kGrow);
+    ASSERT_EQ(72, decision.tickets);
+
+    decision = policy.decide(makeSample(1.0, 800), 72, kMin, kMax);
+    ASSERT(decision.action == Action::kRevert);
+    ASSERT_EQ(64, decision.tickets);
+
+    // No further growth until the cooldown has passed.
+    for (int i = 0; i < WiredTigerTicketPolicy::kCooldownIntervals; i++) {
+        decision = policy.decide(makeSample(1.0, 1000), 64, kMin, kMax);
+        ASSERT(decision.action == Action::kHold);
+        ASSERT_EQ(64, decision.tickets);
+    }
+    decision = policy.decide(makeSample(1.0, 1000), 64, kMin, kMax);
+    ASSERT(decision.action == Action::kGrow);
+}
+
+// Feeds 'intervals' samples with cache pressure, expecting to hold on all but the last.
+WiredTigerTicketPolicy::Decision decideUnderPressure(WiredTigerTicketPolicy* policy,
+                                                     int currentTickets,
+                                                     int intervals) {
+    for (int i = 1; i < intervals; i++) {
+        auto decision = policy->decide(makeSample(1.0, 1000, true), currentTickets, kMin, kMax);
+        ASSERT(decision.action == Action::kHold);
+        ASSERT_EQ(currentTickets, decision.tickets);
+    }
+    return policy->decide(makeSample(1.0, 1000, true), currentTickets, kMin, kMax);
+}
+
+TEST(WiredTigerTicketPolicyTest, ShrinksUnderSustainedCachePressure) {
+    WiredTigerTicketPolicy policy;
+    auto decision =
+        decideUnderPressure(&policy, 128, WiredTigerTicketPolicy::kPressureIntervals);
+    ASSERT(decision.action == Action::kShrink);
+    ASSERT_EQ(112, decision.tickets);
+
+    decision = decideUnderPressure(&policy, 17, WiredTigerTicketPolicy::kPressureIntervals);
+    ASSERT(decision.action == Action::kShrink);
+    ASSERT_EQ(kMin, decision.tickets);
+
+    decision = decideUnderPressure(&policy, kMin, WiredTigerTicketPolicy::kPressureIntervals);
+    ASSERT(decision.action == Action::kHold);
+    ASSERT_EQ(kMin, decision.tickets);
+}
+
+TEST(WiredTigerTicketPolicyTest, BriefCachePressureDoesNotShrink) {
+    WiredTigerTicketPolicy policy;
+    for (int i = 0; i < 3; i++) {
+        auto decision =
+            decideUnderPressure(&policy, 128, WiredTigerTicketPolicy::kPressureIntervals - 1);
+        ASSERT(decision.action == Action::kHold);
+        ASSERT_EQ(128, decision.tickets);
+
+        // An interval without pressure starts the count over.
+        decision = policy.decide(makeSample(0.1, 1000), 128, kMin, kMax);
+        ASSERT(decision.action == Action::kHold);
+    }
+}
+
+TEST(WiredTigerTicketPolicyTest, NeverGrowsPastMaximum) {
+    WiredTigerTicketPolicy policy;
+    auto decision = policy.decide(makeSample(1.0, 1000), 250, kMin, kMax);
+    ASSERT(decision.action == Action::kGrow);
+    ASSERT_EQ(kMax, decision.tickets);
+
+    decision = policy.decide(makeSample(1.0, 1000), kMax, kMin, kMax);
+    ASSERT(decision.action == Action::kHold);
+    ASSERT_EQ(kMax, decision.tickets);
+}
+
+TEST(WiredTigerTicketPolicyTest, ClampsToChangedBounds) {
+    WiredTigerTicketPolicy policy;
+    auto decision = policy.decide(makeSample(0, 1000), 8, kMin, kMax);
+    ASSERT(decision.action == Action::kGrow);
+    ASSERT_EQ(kMin, decision.tickets);
+
+    decision = policy.decide(makeSample(0, 1000), 300, kMin, kMax);
+    ASSERT(decision.action == Action::kShrink);
+    ASSERT_EQ(kMax, decision.tickets);
+}
+
+}  // namespace
+}  // namespace mongo
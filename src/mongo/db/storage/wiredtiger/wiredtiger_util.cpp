@@ -439,12 +439,37 @@ int WiredTigerUtil::verifyTable(OperationContext* txn,
     return (session->verify)(session, uri.c_str(), NULL);
 }
 
-Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
-                                         const std::string& uri,
-                                         const std::string& config,
-                                         BSONObjBuilder* bob) {
-    invariant(session);
-    invariant(bob);
+namespace {
+
+/**
+ * Splits the description of a statistic into the name of the top-level field it is exported under
+ * and its name within that field. The field name is empty for statistics exported at the top
+ * level under their full description.
+ */
+void splitStatisticDescription(StringData desc, StringData* prefix, StringData* suffix) {
+    size_t idx = desc.find(':');
+    if (idx != string::npos) {
+        *prefix = desc.substr(0, idx);
+        *suffix = desc.substr(idx + 1);
+    } else {
+        idx = desc.find(' ');
+    }
+
+    if (idx != string::npos) {
+        *prefix = desc.substr(0, idx);
+        *suffix = desc.substr(idx + 1);
+    } else {
+        *prefix = desc;
+        *suffix = "num";
+    }
+}
+
+/**
+ * Opens a cursor on 'uri' with 'config', which may be empty.
+ */
+StatusWith<WT_CURSOR*> openStatisticsCursor(WT_SESSION* session,
+                                            const std::string& uri,
+                                            const std::string& config) {
     WT_CURSOR* c = NULL;
     const char* cursorConfig = config.empty() ? NULL : config.c_str();
     int ret = session->open_cursor(session, uri.c_str(), NULL, cursorConfig, &c);
@@ -453,54 +478,117 @@ Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
                       str::stream() << "unable to open cursor at URI " << uri << ". reason: "
                                     << wiredtiger_strerror(ret));
     }
-    bob->append("uri", uri);
     invariant(c);
-    ON_BLOCK_EXIT(c->close, c);
+    return c;
+}
 
-    std::map<string, BSONObjBuilder*> subs;
-    const char* desc;
-    uint64_t value;
-    while (c->next(c) == 0 && c->get_value(c, &desc, NULL, &value) == 0) {
-        StringData key(desc);
+/**
+ * Appends statistics in the layout of exportTableToBSON(). Statistics with a field name are
+ * grouped into one subobject per field, which are appended by done().
+ */
+class StatisticsAppender {
+public:
+    explicit StatisticsAppender(BSONObjBuilder* bob) : _bob(bob) {}
 
+    void append(const char* desc, long long value) {
         StringData prefix;
         StringData suffix;
+        splitStatisticDescription(desc, &prefix, &suffix);
 
-        size_t idx = key.find(':');
-        if (idx != string::npos) {
-            prefix = key.substr(0, idx);
-            suffix = key.substr(idx + 1);
+        if (prefix.size() == 0) {
+            _bob->appendNumber(desc, value);
         } else {
-            idx = key.find(' ');
+            _subs[prefix.toString()].appendNumber(mongoutils::str::ltrim(suffix.toString()),
+                                                  value);
         }
+    }
 
-        if (idx != string::npos) {
-            prefix = key.substr(0, idx);
-            suffix = key.substr(idx + 1);
-        } else {
-            prefix = key;
-            suffix = "num";
+    void done() {
+        for (auto&& sub : _subs) {
+            _bob->append(sub.first, sub.second.obj());
         }
+    }
 
-        long long v = _castStatisticsValue<long long>(value);
+private:
+    BSONObjBuilder* const _bob;
+    std::map<string, BSONObjBuilder> _subs;
+};
 
-        if (prefix.size() == 0) {
-            bob->appendNumber(desc, v);
-        } else {
-            BSONObjBuilder*& sub = subs[prefix.toString()];
-            if (!sub)
-                sub = new BSONObjBuilder();
-            sub->appendNumber(mongoutils::str::ltrim(suffix.toString()), v);
-        }
+}  // namespace
+
+Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
+                                         const std::string& uri,
+                                         const std::string& config,
+                                         BSONObjBuilder* bob) {
+    invariant(session);
+    invariant(bob);
+    auto swCursor = openStatisticsCursor(session, uri, config);
+    if (!swCursor.isOK()) {
+        return swCursor.getStatus();
     }
+    bob->append("uri", uri);
+    WT_CURSOR* c = swCursor.getValue();
+    ON_BLOCK_EXIT(c->close, c);
 
-    for (std::map<string, BSONObjBuilder*>::const_iterator it = subs.begin(); it != subs.end();
-         ++it) {
-        const std::string& s = it->first;
-        bob->append(s, it->second->obj());
-        delete it->second;
+    StatisticsAppender appender(bob);
+    const char* desc;
+    uint64_t value;
+    while (c->next(c) == 0 && c->get_value(c, &desc, NULL, &value) == 0) {
+        appender.append(desc, _castStatisticsValue<long long>(value));
     }
+    appender.done();
     return Status::OK();
 }
 
+Status WiredTigerUtil::exportStatisticsToBSON(WT_SESSION* session,
+                                              const std::string& uri,
+                                              const std::string& config,
+                                              const std::vector<int>& keys,
+                                              BSONObjBuilder* bob) {
+    invariant(session);
+    invariant(bob);
+    auto swCursor = openStatisticsCursor(session, uri, config);
+    if (!swCursor.isOK()) {
+        return swCursor.getStatus();
+    }
+    WT_CURSOR* c = swCursor.getValue();
+    ON_BLOCK_EXIT(c->close, c);
+
+    StatisticsAppender appender(bob);
+    const char* desc;
+    uint64_t value;
+    for (int key : keys) {
+        c->set_key(c, key);
+        if (c->search(c) == 0 && c->get_value(c, &desc, NULL, &value) == 0) {
+            appender.append(desc, _castStatisticsValue<long long>(value));
+        }
+    }
+    appender.done();
+    return Status::OK();
+}
+
+StatusWith<WiredTigerUtil::StatisticsKeysByField> WiredTigerUtil::getStatisticsKeysByField(
+    WT_SESSION* session, const std::string& uri, const std::string& config) {
+    invariant(session);
+    auto swCursor = openStatisticsCursor(session, uri, config);
+    if (!swCursor.isOK()) {
+        return swCursor.getStatus();
+    }
+    WT_CURSOR* c = swCursor.getValue();
+    ON_BLOCK_EXIT(c->close, c);
+
+    StatisticsKeysByField keysByField;
+    int key;
+    const char* desc;
+    while (c->next(c) == 0 && c->get_key(c, &key) == 0 &&
+           c->get_value(c, &desc, NULL, NULL) == 0) {
+        StringData prefix;
+        StringData suffix;
+        splitStatisticDescription(desc, &prefix, &suffix);
+        keysByField[prefix.size() == 0 ? std::string(desc) : prefix.toString()].push_back(key);
+    }
+
+    return keysByField;
+}
+
 }  // namespace mongo
@@ -31,6 +31,9 @@
 #pragma once
 
 #include <limits>
+#include <map>
+#include <string>
+#include <vector>
 #include <wiredtiger.h>
 
 #include "mongo/base/disallow_copying.h"
@@ -96,6 +99,12 @@ private:
     WiredTigerUtil();
 
 public:
+    /**
+     * Keys of statistics, by the name of the top-level field exportTableToBSON() reports them
+     * under.
+     */
+    using StatisticsKeysByField = std::map<std::string, std::vector<int>>;
+
     /**
      * Fetch the type and source fields out of the colgroup metadata.  'tableUri' must be a
      * valid table: uri.
@@ -114,6 +123,26 @@ public:
                                     const std::string& config,
                                     BSONObjBuilder* bob);
 
+    /**
+     * Exports the statistics at 'uri' with the given keys to BSON in the same layout as
+     * exportTableToBSON(), but without the 'uri' field. Each statistic is read with a keyed search,
+     * so the cost depends on the number of keys rather than on the number of statistics. Keys
+     * which are not found are skipped.
+     */
+    static Status exportStatisticsToBSON(WT_SESSION* s,
+                                         const std::string& uri,
+                                         const std::string& config,
+                                         const std::vector<int>& keys,
+                                         BSONObjBuilder* bob);
+
+    /**
+     * Reads all the statistics at 'uri' and returns their keys grouped by top-level field, so that
+     * exportStatisticsToBSON() can later read the fields of interest.
+     */
+    static StatusWith<StatisticsKeysByField> getStatisticsKeysByField(WT_SESSION* s,
+                                                                      const std::string& uri,
+                                                                      const std::string& config);
+
     /**
      * Gets entire metadata string for collection/index at URI.
      */
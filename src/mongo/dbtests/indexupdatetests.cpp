@@ -43,6 +43,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_d.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/util/scopeguard.h"
 
 namespace IndexUpdateTests {
 
@@ -510,6 +511,109 @@ public:
     }
 };
 
+/** Foreground index builds of large collections generate and sort the keys on several threads. */
+class InsertBuildParallelKeyGeneration : public IndexBuildBase {
+public:
+    void run() {
+        const int oldThreads = maxIndexBuildKeyGenerationThreads.load();
+        maxIndexBuildKeyGenerationThreads.store(4);
+        ON_BLOCK_EXIT([&] { maxIndexBuildKeyGenerationThreads.store(oldThreads); });
+
+        // Create a new collection, where 'a' is multikey, half of the documents match the filter of
+        // the partial index on 'b' and the first and the last document have the same 'c'.
+        const int nDocs = 20000;
+        Database* db = _ctx.db();
+        Collection* coll;
+        {
+            WriteUnitOfWork wunit(&_txn);
+            db->dropCollection(&_txn, _ns);
+            coll = db->createCollection(&_txn, _ns);
+            wunit.commit();
+        }
+        OpDebug* const nullOpDebug = nullptr;
+        for (int i = 0; i < nDocs; i += 1000) {
+            WriteUnitOfWork wunit(&_txn);
+            for (int j = i; j < i + 1000; j++) {
+                ASSERT_OK(coll->insertDocument(
+                    &_txn,
+                    BSON("_id" << j << "a" << BSON_ARRAY(j << j + nDocs) << "b" << j % 2 << "c"
+                               << (j == nDocs - 1 ? 0 : j)),
+                    nullOpDebug,
+                    true));
+            }
+            wunit.commit();
+        }
+
+        MultiIndexBlock indexer(&_txn, coll);
+        indexer.allowInterruption();
+
+        const std::vector<BSONObj> specs{
+            BSON("name"
+                 << "a"
+                 << "ns"
+                 << coll->ns().ns()
+                 << "key"
+                 << BSON("a" << 1)
+                 << "v"
+                 << static_cast<int>(kIndexVersion)),
+            BSON("name"
+                 << "b"
+                 << "ns"
+                 << coll->ns().ns()
+                 << "key"
+                 << BSON("b" << 1)
+                 << "v"
+                 << static_cast<int>(kIndexVersion)
+                 << "partialFilterExpression"
+                 << BSON("b" << 1)),
+            BSON("name"
+                 << "c"
+                 << "ns"
+                 << coll->ns().ns()
+                 << "key"
+                 << BSON("c" << 1)
+                 << "v"
+                 << static_cast<int>(kIndexVersion)
+                 << "unique"
+                 << true)};
+
+        ASSERT_OK(indexer.init(specs).getStatus());
+
+        std::set<RecordId> dups;
+        ASSERT_OK(indexer.insertAllDocumentsInCollection(&dups));
+
+        // Either the first or the last document is a dup, but not both.
+        ASSERT_EQUALS(dups.size(), 1U);
+        const int dupId = coll->docFor(&_txn, *dups.begin()).value()["_id"].Int();
+        ASSERT(dupId == 0 || dupId == nDocs - 1);
+
+        {
+            WriteUnitOfWork wunit(&_txn);
+            indexer.commit();
+            wunit.commit();
+        }
+
+        ASSERT_EQUALS(2 * nDocs, numKeys("a"));
+        ASSERT(coll->getIndexCatalog()
+                   ->getEntry(coll->getIndexCatalog()->findIndexByName(&_txn, "a"))
+                   ->isMultikey());
+        ASSERT_EQUALS(nDocs / 2, numKeys("b"));
+        ASSERT_EQUALS(nDocs - 1, numKeys("c"));
+    }
+
+private:
+    int64_t numKeys(StringData indexName) {
+        IndexCatalog* catalog = collection()->getIndexCatalog();
+        IndexDescriptor* descriptor = catalog->findIndexByName(&_txn, indexName);
+        ASSERT(descriptor);
+
+        int64_t numKeys;
+        ValidateResults results;
+        ASSERT_OK(catalog->getIndex(descriptor)->validate(&_txn, &numKeys, &results));
+        return numKeys;
+    }
+};
+
 /** Index creation is killed if mayInterrupt is true. */
 class InsertBuildIndexInterrupt : public IndexBuildBase {
 public:
@@ -1031,6 +1135,7 @@ public:
         add<InsertBuildEnforceUnique<false>>();
         add<InsertBuildFillDups<true>>();
         add<InsertBuildFillDups<false>>();
+        add<InsertBuildParallelKeyGeneration>();
         add<InsertBuildIndexInterrupt>();
         add<InsertBuildIndexInterruptDisallowed>();
         add<InsertBuildIdIndexInterrupt>();
@@ -46,12 +46,19 @@
 #include <iostream>
 #include <mutex>
 
+#include "mongo/bson/bson_validate.h"
 #include "mongo/config.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/lasterror.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/parsed_add_fields.h"
+#include "mongo/db/pipeline/parsed_aggregation_projection.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/mmap_v1/dur_stats.h"
 #include "mongo/db/storage/mmap_v1/mmap.h"
 #include "mongo/db/storage/storage_options.h"
@@ -63,6 +70,9 @@
 #include "mongo/util/timer.h"
 #include "mongo/util/version.h"
 
+// Need access to internal classes
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace PerfTests {
 
 using std::cout;
@@ -450,6 +460,328 @@ public:
     }
 };
 
+/**
+ * Measures validateBSON, as run on every incoming document when objcheck is enabled, for a few
+ * typical document shapes.
+ */
+class BSONValidateBase : public B {
+public:
+    virtual int howLongMillis() {
+        return 500;
+    }
+    virtual bool showDurStats() {
+        return false;
+    }
+    virtual unsigned batchSize() {
+        return 1000;
+    }
+    void prep() {
+        _obj = makeObj();
+        ASSERT_OK(validateBSON(_obj.objdata(), _obj.objsize(), BSONVersion::kLatest));
+    }
+    void timed() {
+        validateBSON(_obj.objdata(), _obj.objsize(), BSONVersion::kLatest);
+    }
+
+protected:
+    virtual BSONObj makeObj() = 0;
+
+private:
+    BSONObj _obj;
+};
+
+// A small order-like document with short field names and mixed value types.
+class BSONValidateSmall : public BSONValidateBase {
+public:
+    string name() {
+        return "bson-validate-small";
+    }
+    BSONObj makeObj() {
+        return BSON("_id" << OID::gen() << "customer" << 12345 << "status"
+                          << "shipped"
+                          << "total"
+                          << 99.95
+                          << "created"
+                          << Date_t::now()
+                          << "gift"
+                          << false
+                          << "tags"
+                          << BSON_ARRAY("a"
+                                        << "b"));
+    }
+};
+
+// A large flat document with many fields of moderate name length.
+class BSONValidateWide : public BSONValidateBase {
+public:
+    string name() {
+        return "bson-validate-wide";
+    }
+    BSONObj makeObj() {
+        BSONObjBuilder b;
+        b.append("_id", OID::gen());
+        for (int i = 0; i < 1000; i++) {
+            b.append(str::stream() << "attribute_number_" << i, i);
+        }
+        return b.obj();
+    }
+};
+
+// A document with an array of nested subdocuments, like embedded line items.
+class BSONValidateNested : public BSONValidateBase {
+public:
+    string name() {
+        return "bson-validate-nested";
+    }
+    BSONObj makeObj() {
+        BSONObjBuilder b;
+        b.append("_id", OID::gen());
+        BSONArrayBuilder items(b.subarrayStart("items"));
+        for (int i = 0; i < 200; i++) {
+            items.append(BSON("sku" << i << "description"
+                                    << "a short item description"
+                                    << "quantity"
+                                    << i % 7
+                                    << "price"
+                                    << BSON("amount" << 1.5 * i << "currency"
+                                                     << "USD")));
+        }
+        items.done();
+        return b.obj();
+    }
+};
+
+// A document dominated by long string values.
+class BSONValidateStrings : public BSONValidateBase {
+public:
+    string name() {
+        return "bson-validate-strings";
+    }
+    BSONObj makeObj() {
+        BSONObjBuilder b;
+        b.append("_id", OID::gen());
+        for (int i = 0; i < 16; i++) {
+            b.append(str::stream() << "text" << i, string(4096, 'x'));
+        }
+        return b.obj();
+    }
+};
+
+// Compares neighbouring keys of a compound index whose leading fields repeat, as they do for
+// {tenant: 1, region: 1, createdAt: 1, seq: 1}.
+class CompoundKeyCompareBase : public B {
+public:
+    virtual int howLongMillis() {
+        return 500;
+    }
+    virtual bool showDurStats() {
+        return false;
+    }
+    virtual unsigned batchSize() {
+        return 1000;
+    }
+    void prep() {
+        const Date_t start = Date_t::now();
+        for (int i = 0; i < kNumKeys; i++) {
+            const std::string tenant = str::stream() << "tenant-" << (i / 500);
+            _keys.push_back(BSON("" << tenant << ""
+                                    << "region-north-america-east"
+                                    << ""
+                                    << (start + Seconds(i / 10))
+                                    << ""
+                                    << i));
+        }
+    }
+
+protected:
+    static const int kNumKeys = 1000;
+    std::vector<BSONObj> _keys;
+    size_t _pos = 0;
+};
+
+class IndexEntryCompareCompound : public CompoundKeyCompareBase {
+public:
+    string name() {
+        return "index-entry-compare-compound";
+    }
+    void timed() {
+        const size_t next = (_pos + 1) % kNumKeys;
+        _cmp.compare(IndexKeyEntry(_keys[_pos], RecordId(1)),
+                     IndexKeyEntry(_keys[next], RecordId(2)));
+        _pos = next;
+    }
+
+private:
+    const IndexEntryComparison _cmp{Ordering::make(BSON("a" << 1 << "b" << 1 << "c" << 1 << "d"
+                                                            << 1))};
+};
+
+class KeyStringCompareCompound : public CompoundKeyCompareBase {
+public:
+    string name() {
+        return "keystring-compare-compound";
+    }
+    void prep() {
+        CompoundKeyCompareBase::prep();
+        const Ordering ord = Ordering::make(BSON("a" << 1 << "b" << 1 << "c" << 1 << "d" << 1));
+        for (auto&& key : _keys) {
+            _keyStrings.emplace_back(
+                stdx::make_unique<KeyString>(KeyString::Version::V1, key, ord, RecordId(1)));
+        }
+    }
+    void timed() {
+        const size_t next = (_pos + 1) % kNumKeys;
+        _keyStrings[_pos]->compare(*_keyStrings[next]);
+        _pos = next;
+    }
+
+private:
+    std::vector<std::unique_ptr<KeyString>> _keyStrings;
+};
+
+// Applies an aggregation projection as DocumentSourceProject does, to Documents built from BSON as
+// DocumentSourceCursor builds them, so that each Document is only referenced by the projection.
+class ProjectDocumentsBase : public B {
+public:
+    virtual int howLongMillis() {
+        return 500;
+    }
+    virtual bool showDurStats() {
+        return false;
+    }
+    virtual unsigned batchSize() {
+        return 1000;
+    }
+    void prep() {
+        _projection = makeProjection();
+        _doc = BSON("_id" << 1 << "a" << 1 << "b" << 2.5 << "c"
+                          << "a string which is too long to be stored inline"
+                          << "d"
+                          << BSON("e" << 1 << "f" << 2)
+                          << "g"
+                          << BSON_ARRAY(1 << 2 << 3)
+                          << "h"
+                          << true
+                          << "i"
+                          << 3
+                          << "j"
+                          << "short");
+    }
+    void timed() {
+        Document output = _projection->applyTransformation(Document(_doc));
+        invariant(!output.empty());
+    }
+
+protected:
+    virtual std::unique_ptr<parsed_aggregation_projection::ParsedAggregationProjection>
+    makeProjection() = 0;
+
+private:
+    std::unique_ptr<parsed_aggregation_projection::ParsedAggregationProjection> _projection;
+    BSONObj _doc;
+};
+
+class ProjectInclusion : public ProjectDocumentsBase {
+public:
+    string name() {
+        return "project-inclusion";
+    }
+
+protected:
+    std::unique_ptr<parsed_aggregation_projection::ParsedAggregationProjection> makeProjection() {
+        return parsed_aggregation_projection::ParsedAggregationProjection::create(
+            BSON("a" << 1 << "c" << 1 << "d.e" << 1 << "k" << BSON("$add" << BSON_ARRAY("$a"
+                                                                                  << "$i"))));
+    }
+};
+
+class ProjectExclusion : public ProjectDocumentsBase {
+public:
+    string name() {
+        return "project-exclusion";
+    }
+
+protected:
+    std::unique_ptr<parsed_aggregation_projection::ParsedAggregationProjection> makeProjection() {
+        return parsed_aggregation_projection::ParsedAggregationProjection::create(
+            BSON("b" << 0 << "g" << 0 << "d.f" << 0));
+    }
+};
+
+class ProjectAddFields : public ProjectDocumentsBase {
+public:
+    string name() {
+        return "project-addfields";
+    }
+
+protected:
+    std::unique_ptr<parsed_aggregation_projection::ParsedAggregationProjection> makeProjection() {
+        return parsed_aggregation_projection::ParsedAddFields::create(
+            BSON("k" << BSON("$add" << BSON_ARRAY("$a"
+                                                  << "$i"))));
+    }
+};
+
+class SortRunBase : public B {
+public:
+    virtual int howLongMillis() {
+        return 2000;
+    }
+    virtual bool showDurStats() {
+        return false;
+    }
+    virtual unsigned batchSize() {
+        return 1;
+    }
+    void prep() {
+        // Few distinct keys, as in a sort on a low cardinality field
+        const size_t numItems = 16 * sorter::kMinParallelSortRunSize;
+        _input.reserve(numItems);
+        for (size_t i = 0; i < numItems; i++) {
+            _input.emplace_back(std::rand() % 1000, i);
+        }
+    }
+    void timed() {
+        std::vector<std::pair<int, int>> run(_input);
+        sorter::parallelStableSort(
+            run.begin(),
+            run.end(),
+            [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
+                return lhs.first < rhs.first;
+            },
+            numThreads());
+    }
+
+protected:
+    virtual unsigned numThreads() = 0;
+
+private:
+    std::vector<std::pair<int, int>> _input;
+};
+
+class SortRunSerial : public SortRunBase {
+public:
+    string name() {
+        return "sort-run-serial";
+    }
+
+protected:
+    unsigned numThreads() {
+        return 1;
+    }
+};
+
+class SortRunParallel : public SortRunBase {
+public:
+    string name() {
+        return "sort-run-parallel";
+    }
+
+protected:
+    unsigned numThreads() {
+        return sorter::kMaxParallelSortThreads;
+    }
+};
 
 class All : public Suite {
 public:
@@ -463,6 +795,17 @@ public:
         add<boosttimed_mutexspeed>();
         add<stdmutexspeed>();
         add<stdtimed_mutexspeed>();
+        add<BSONValidateSmall>();
+        add<BSONValidateWide>();
+        add<BSONValidateNested>();
+        add<BSONValidateStrings>();
+        add<IndexEntryCompareCompound>();
+        add<KeyStringCompareCompound>();
+        add<ProjectInclusion>();
+        add<ProjectExclusion>();
+        add<ProjectAddFields>();
+        add<SortRunSerial>();
+        add<SortRunParallel>();
     }
 } myall;
 }
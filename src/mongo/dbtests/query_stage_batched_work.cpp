@@ -0,0 +1,453 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file tests PlanStage::workBatch() and its use by PlanExecutor.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/fetch.h"
+#include "mongo/db/exec/index_scan.h"
+#include "mongo/db/exec/limit.h"
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/plan_stats.h"
+#include "mongo/db/exec/projection.h"
+#include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/exec/skip.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/dbtests/dbtests.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/timer.h"
+
+namespace QueryStageBatchedWork {
+
+using std::unique_ptr;
+using std::vector;
+using stdx::make_unique;
+
+class QueryStageBatchedWorkBase {
+public:
+    QueryStageBatchedWorkBase(int numObj = 300) : _numObj(numObj), _client(&_txn) {
+        OldClientWriteContext ctx(&_txn, ns());
+        _client.createIndex(ns(), BSON("foo" << 1));
+
+        for (int i = 0; i < _numObj; ++i) {
+            _client.insert(ns(), BSON("foo" << i << "bar" << i % 7 << "baz" << "x"));
+        }
+    }
+
+    virtual ~QueryStageBatchedWorkBase() {
+        OldClientWriteContext ctx(&_txn, ns());
+        _client.dropCollection(ns());
+    }
+
+    unique_ptr<MatchExpression> parseFilter(const BSONObj& filterObj) {
+        const CollatorInterface* collator = nullptr;
+        StatusWithMatchExpression statusWithMatcher = MatchExpressionParser::parse(
+            filterObj, ExtensionsCallbackDisallowExtensions(), collator);
+        ASSERT_OK(statusWithMatcher.getStatus());
+        return std::move(statusWithMatcher.getValue());
+    }
+
+    /**
+     * Builds LIMIT <- SKIP <- PROJECTION <- COLLSCAN, with 'filter' on the COLLSCAN.
+     */
+    unique_ptr<PlanStage> makeCollScanPlan(Collection* collection,
+                                           WorkingSet* ws,
+                                           const MatchExpression* filter,
+                                           long long limit = 100) {
+        CollectionScanParams params;
+        params.collection = collection;
+        params.direction = CollectionScanParams::FORWARD;
+        auto scan = make_unique<CollectionScan>(&_txn, params, ws, filter);
+
+        ProjectionStageParams projParams(_extensionsCallback);
+        projParams.projObj = BSON("_id" << 0 << "foo" << 1 << "bar" << 1);
+        auto proj = make_unique<ProjectionStage>(&_txn, projParams, ws, scan.release());
+        auto skip = make_unique<SkipStage>(&_txn, 3, ws, proj.release());
+        return make_unique<LimitStage>(&_txn, limit, ws, skip.release());
+    }
+
+    /**
+     * Builds LIMIT <- FETCH <- IXSCAN over {foo: 1}, with 'filter' on the FETCH.
+     */
+    unique_ptr<PlanStage> makeIndexScanPlan(Collection* collection,
+                                            WorkingSet* ws,
+                                            const MatchExpression* filter) {
+        vector<IndexDescriptor*> indexes;
+        collection->getIndexCatalog()->findIndexesByKeyPattern(
+            &_txn, BSON("foo" << 1), false, &indexes);
+        ASSERT_EQUALS(indexes.size(), 1U);
+
+        IndexScanParams params;
+        params.descriptor = indexes[0];
+        params.bounds.isSimpleRange = true;
+        params.bounds.startKey = BSON("" << 10);
+        params.bounds.endKey = BSON("" << _numObj);
+        params.bounds.boundInclusion = BoundInclusion::kIncludeBothStartAndEndKeys;
+        params.direction = 1;
+        auto scan = make_unique<IndexScan>(&_txn, params, ws, nullptr);
+
+        auto fetch = make_unique<FetchStage>(&_txn, ws, scan.release(), filter, collection);
+        return make_unique<LimitStage>(&_txn, 150, ws, fetch.release());
+    }
+
+    /**
+     * Runs 'root' to EOF one work() at a time and returns the results.
+     */
+    vector<BSONObj> runWithWork(PlanStage* root, WorkingSet* ws) {
+        vector<BSONObj> results;
+        for (;;) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = root->work(&id);
+            if (PlanStage::ADVANCED == state) {
+                results.push_back(ws->get(id)->obj.value().getOwned());
+                ws->free(id);
+            } else if (PlanStage::IS_EOF == state) {
+                return results;
+            } else {
+                ASSERT_EQUALS(PlanStage::NEED_TIME, state);
+            }
+        }
+    }
+
+    /**
+     * Runs 'root' to EOF in batches of 'maxWorks' and returns the results.
+     */
+    vector<BSONObj> runWithWorkBatch(PlanStage* root, WorkingSet* ws, size_t maxWorks) {
+        ASSERT_TRUE(root->treeSupportsBatchedWork());
+
+        vector<BSONObj> results;
+        vector<WorkingSetID> ids;
+        for (;;) {
+            ids.clear();
+            WorkingSetID stateId = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = root->workBatch(maxWorks, &ids, &stateId);
+            ASSERT_LESS_THAN_OR_EQUALS(ids.size(), maxWorks);
+            for (auto&& id : ids) {
+                results.push_back(ws->get(id)->obj.value().getOwned());
+                ws->free(id);
+            }
+
+            if (PlanStage::IS_EOF == state) {
+                return results;
+            }
+            ASSERT_TRUE(PlanStage::ADVANCED == state || PlanStage::NEED_TIME == state);
+        }
+    }
+
+    /**
+     * Returns the number of documents tested by the COLLSCAN at the bottom of 'stats'.
+     */
+    static size_t docsTested(const PlanStageStats* stats) {
+        while (!stats->children.empty()) {
+            stats = stats->children[0].get();
+        }
+        ASSERT_EQUALS(STAGE_COLLSCAN, stats->stageType);
+        return static_cast<const CollectionScanStats*>(stats->specific.get())->docsTested;
+    }
+
+    static void assertSameResults(const vector<BSONObj>& expected, const vector<BSONObj>& actual) {
+        ASSERT_EQUALS(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_BSONOBJ_EQ(expected[i], actual[i]);
+        }
+    }
+
+    static const char* ns() {
+        return "unittests.QueryStageBatchedWork";
+    }
+
+protected:
+    const ServiceContext::UniqueOperationContext _txnPtr = cc().makeOperationContext();
+    OperationContext& _txn = *_txnPtr;
+    const int _numObj;
+
+private:
+    ExtensionsCallbackDisallowExtensions _extensionsCallback;
+    DBDirectClient _client;
+};
+
+/**
+ * Sets internalQueryExecBatchedWorkSize for the lifetime of the object.
+ */
+class ScopedBatchedWorkSize {
+public:
+    explicit ScopedBatchedWorkSize(int batchSize)
+        : _oldBatchSize(internalQueryExecBatchedWorkSize.load()) {
+        internalQueryExecBatchedWorkSize.store(batchSize);
+    }
+
+    ~ScopedBatchedWorkSize() {
+        internalQueryExecBatchedWorkSize.store(_oldBatchSize);
+    }
+
+private:
+    const int _oldBatchSize;
+};
+
+//
+// COLLSCAN -> PROJECTION -> SKIP -> LIMIT produces the same results and examines the same
+// documents whether it is worked in batches or not.
+//
+class QueryStageBatchedWorkCollScanPlan : public QueryStageBatchedWorkBase {
+public:
+    void run() {
+        AutoGetCollectionForRead ctx(&_txn, ns());
+        Collection* collection = ctx.getCollection();
+        unique_ptr<MatchExpression> filter = parseFilter(BSON("bar" << BSON("$ne" << 3)));
+
+        WorkingSet ws;
+        unique_ptr<PlanStage> root = makeCollScanPlan(collection, &ws, filter.get());
+        vector<BSONObj> expected = runWithWork(root.get(), &ws);
+        ASSERT_EQUALS(expected.size(), 100U);
+        const size_t expectedDocsTested = docsTested(root->getStats().get());
+
+        for (size_t maxWorks : {1U, 7U, 64U, 1000U}) {
+            WorkingSet batchWs;
+            unique_ptr<PlanStage> batchRoot = makeCollScanPlan(collection, &batchWs, filter.get());
+            assertSameResults(expected, runWithWorkBatch(batchRoot.get(), &batchWs, maxWorks));
+
+            // LIMIT never asks for more works than it has results left to return, so the scan
+            // stops where it would have stopped without batching.
+            auto stats = batchRoot->getStats();
+            ASSERT_EQUALS(expectedDocsTested, docsTested(stats.get()));
+            ASSERT_EQUALS(expected.size(), stats->common.advanced);
+        }
+    }
+};
+
+//
+// IXSCAN -> FETCH -> LIMIT produces the same results whether it is worked in batches or not.
+//
+class QueryStageBatchedWorkIndexScanPlan : public QueryStageBatchedWorkBase {
+public:
+    void run() {
+        AutoGetCollectionForRead ctx(&_txn, ns());
+        Collection* collection = ctx.getCollection();
+        unique_ptr<MatchExpression> filter =
+            parseFilter(BSON("bar" << BSON("$in" << BSON_ARRAY(1 << 2))));
+
+        WorkingSet ws;
+        unique_ptr<PlanStage> root = makeIndexScanPlan(collection, &ws, filter.get());
+        vector<BSONObj> expected = runWithWork(root.get(), &ws);
+        ASSERT_FALSE(expected.empty());
+
+        for (size_t maxWorks : {1U, 5U, 128U}) {
+            WorkingSet batchWs;
+            unique_ptr<PlanStage> batchRoot = makeIndexScanPlan(collection, &batchWs, filter.get());
+            assertSameResults(expected, runWithWorkBatch(batchRoot.get(), &batchWs, maxWorks));
+        }
+    }
+};
+
+//
+// A plan containing a stage without batch support must be worked one unit at a time.
+//
+class QueryStageBatchedWorkUnsupportedTree : public QueryStageBatchedWorkBase {
+public:
+    void run() {
+        AutoGetCollectionForRead ctx(&_txn, ns());
+        WorkingSet ws;
+        unique_ptr<PlanStage> root = makeCollScanPlan(ctx.getCollection(), &ws, nullptr);
+        ASSERT_TRUE(root->treeSupportsBatchedWork());
+
+        auto queuedData = make_unique<QueuedDataStage>(&_txn, &ws);
+        ASSERT_FALSE(queuedData->treeSupportsBatchedWork());
+
+        LimitStage limit(&_txn, 100, &ws, queuedData.release());
+        ASSERT_TRUE(limit.supportsBatchedWork());
+        ASSERT_FALSE(limit.treeSupportsBatchedWork());
+    }
+};
+
+//
+// PlanExecutor returns the same documents when internalQueryExecBatchedWorkSize is set.
+//
+class QueryStageBatchedWorkExecutor : public QueryStageBatchedWorkBase {
+public:
+    void run() {
+        vector<BSONObj> expected = runExecutor();
+        ASSERT_EQUALS(expected.size(), 100U);
+
+        ScopedBatchedWorkSize batchSize(16);
+        assertSameResults(expected, runExecutor());
+    }
+
+private:
+    vector<BSONObj> runExecutor() {
+        AutoGetCollectionForRead ctx(&_txn, ns());
+        unique_ptr<MatchExpression> filter = parseFilter(BSON("bar" << BSON("$ne" << 3)));
+        auto ws = make_unique<WorkingSet>();
+        unique_ptr<PlanStage> root = makeCollScanPlan(ctx.getCollection(), ws.get(), filter.get());
+
+        auto statusWithPlanExecutor = PlanExecutor::make(&_txn,
+                                                         std::move(ws),
+                                                         std::move(root),
+                                                         ctx.getCollection(),
+                                                         PlanExecutor::YIELD_MANUAL);
+        ASSERT_OK(statusWithPlanExecutor.getStatus());
+        unique_ptr<PlanExecutor> exec = std::move(statusWithPlanExecutor.getValue());
+
+        vector<BSONObj> results;
+        PlanExecutor::ExecState state;
+        for (BSONObj obj; PlanExecutor::ADVANCED == (state = exec->getNext(&obj, NULL));) {
+            results.push_back(obj.getOwned());
+        }
+        ASSERT_EQUALS(PlanExecutor::IS_EOF, state);
+        ASSERT_TRUE(exec->isEOF());
+        return results;
+    }
+};
+
+//
+// A batch ends as soon as the yield policy says to yield, so a PlanExecutor yields as often by
+// iteration count whether it works the plan in batches or not.
+//
+class QueryStageBatchedWorkYieldsWithinBatch : public QueryStageBatchedWorkBase {
+public:
+    QueryStageBatchedWorkYieldsWithinBatch()
+        : _oldYieldIterations(internalQueryExecYieldIterations.load()) {
+        internalQueryExecYieldIterations.store(kYieldIterations);
+    }
+
+    ~QueryStageBatchedWorkYieldsWithinBatch() {
+        internalQueryExecYieldIterations.store(_oldYieldIterations);
+    }
+
+    void run() {
+        ScopedBatchedWorkSize batchSize(1000);
+
+        AutoGetCollectionForRead ctx(&_txn, ns());
+        auto ws = make_unique<WorkingSet>();
+        unique_ptr<PlanStage> root = makeCollScanPlan(ctx.getCollection(), ws.get(), nullptr);
+
+        auto statusWithPlanExecutor = PlanExecutor::make(&_txn,
+                                                         std::move(ws),
+                                                         std::move(root),
+                                                         ctx.getCollection(),
+                                                         PlanExecutor::YIELD_AUTO);
+        ASSERT_OK(statusWithPlanExecutor.getStatus());
+        unique_ptr<PlanExecutor> exec = std::move(statusWithPlanExecutor.getValue());
+
+        size_t numResults = 0;
+        for (BSONObj obj; PlanExecutor::ADVANCED == exec->getNext(&obj, NULL);) {
+            ++numResults;
+        }
+        ASSERT_EQUALS(numResults, 100U);
+
+        // The plan only takes a couple of batches, so it would hardly yield at all if the policy
+        // were only consulted between them.
+        auto stats = exec->getRootStage()->getStats();
+        ASSERT_GREATER_THAN_OR_EQUALS(stats->common.yields,
+                                      docsTested(stats.get()) / kYieldIterations - 1);
+    }
+
+private:
+    static const int kYieldIterations = 10;
+
+    const int _oldYieldIterations;
+};
+
+//
+// Not a pass/fail test: logs the per-document cost of running COLLSCAN -> PROJECTION -> SKIP ->
+// LIMIT through a PlanExecutor with and without batched work.
+//
+class QueryStageBatchedWorkPerDocumentCost : public QueryStageBatchedWorkBase {
+public:
+    QueryStageBatchedWorkPerDocumentCost() : QueryStageBatchedWorkBase(kNumObj) {}
+
+    void run() {
+        const double unbatchedNanos = nanosPerDocument();
+        for (int batchSize : {16, 128, 1024}) {
+            ScopedBatchedWorkSize scopedBatchSize(batchSize);
+            mongo::unittest::log() << "COLLSCAN -> PROJECTION -> SKIP -> LIMIT: " << unbatchedNanos
+                  << " ns/doc unbatched, " << nanosPerDocument() << " ns/doc in batches of "
+                  << batchSize;
+        }
+    }
+
+private:
+    static const int kNumObj = 20000;
+    static const int kRuns = 5;
+
+    double nanosPerDocument() {
+        AutoGetCollectionForRead ctx(&_txn, ns());
+        long long bestMicros = std::numeric_limits<long long>::max();
+        for (int run = 0; run < kRuns; ++run) {
+            auto ws = make_unique<WorkingSet>();
+            unique_ptr<PlanStage> root =
+                makeCollScanPlan(ctx.getCollection(), ws.get(), nullptr, kNumObj);
+            auto statusWithPlanExecutor = PlanExecutor::make(&_txn,
+                                                             std::move(ws),
+                                                             std::move(root),
+                                                             ctx.getCollection(),
+                                                             PlanExecutor::YIELD_MANUAL);
+            ASSERT_OK(statusWithPlanExecutor.getStatus());
+            unique_ptr<PlanExecutor> exec = std::move(statusWithPlanExecutor.getValue());
+
+            Timer timer;
+            BSONObj obj;
+            while (PlanExecutor::ADVANCED == exec->getNext(&obj, NULL)) {
+            }
+            bestMicros = std::min(bestMicros, timer.micros());
+        }
+        return bestMicros * 1000.0 / kNumObj;
+    }
+};
+
+class All : public Suite {
+public:
+    All() : Suite("QueryStageBatchedWork") {}
+
+    void setupTests() {
+        add<QueryStageBatchedWorkCollScanPlan>();
+        add<QueryStageBatchedWorkIndexScanPlan>();
+        add<QueryStageBatchedWorkUnsupportedTree>();
+        add<QueryStageBatchedWorkExecutor>();
+        add<QueryStageBatchedWorkYieldsWithinBatch>();
+        add<QueryStageBatchedWorkPerDocumentCost>();
+    }
+};
+
+SuiteInstance<All> all;
+}  // namespace QueryStageBatchedWork
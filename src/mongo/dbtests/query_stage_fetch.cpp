@@ -32,18 +32,26 @@
 
 #include "mongo/platform/basic.h"
 
+#include <limits>
+
 #include "mongo/client/dbclientcursor.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/exec/fetch.h"
+#include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 
@@ -219,6 +227,92 @@ public:
     }
 };
 
+//
+// With batched work enabled, FETCH looks up the records of each batch from its IXSCAN together.
+// A yield part way through the batch must drop the records looked up so far, and the members
+// still waiting to be fetched must be invalidated like any others.
+//
+class FetchStagePrefetchedBatchYieldAndInvalidate : public QueryStageFetchBase {
+public:
+    FetchStagePrefetchedBatchYieldAndInvalidate()
+        : _oldBatchSize(internalQueryExecBatchedWorkSize.load()),
+          _oldYieldIterations(internalQueryExecYieldIterations.load()),
+          _oldYieldPeriodMS(internalQueryExecYieldPeriodMS.load()) {
+        internalQueryExecBatchedWorkSize.store(kNumObj);
+        internalQueryExecYieldIterations.store(kYieldIterations);
+        // Only yield by iteration count, so that the batches are the same on slow machines.
+        internalQueryExecYieldPeriodMS.store(std::numeric_limits<int>::max());
+    }
+
+    ~FetchStagePrefetchedBatchYieldAndInvalidate() {
+        internalQueryExecBatchedWorkSize.store(_oldBatchSize);
+        internalQueryExecYieldIterations.store(_oldYieldIterations);
+        internalQueryExecYieldPeriodMS.store(_oldYieldPeriodMS);
+    }
+
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        _client.createIndex(ns(), BSON("foo" << 1));
+        for (int i = 0; i < kNumObj; ++i) {
+            insert(BSON("foo" << i));
+        }
+        Collection* coll = ctx.getCollection();
+
+        std::vector<IndexDescriptor*> indexes;
+        coll->getIndexCatalog()->findIndexesByKeyPattern(&_txn, BSON("foo" << 1), false, &indexes);
+        ASSERT_EQUALS(indexes.size(), 1U);
+
+        IndexScanParams params;
+        params.descriptor = indexes[0];
+        params.bounds.isSimpleRange = true;
+        params.bounds.startKey = BSON("" << 0);
+        params.bounds.endKey = BSON("" << kNumObj);
+        params.bounds.boundInclusion = BoundInclusion::kIncludeBothStartAndEndKeys;
+        params.direction = 1;
+
+        auto ws = make_unique<WorkingSet>();
+        auto scan = make_unique<IndexScan>(&_txn, params, ws.get(), nullptr);
+        auto fetch = make_unique<FetchStage>(&_txn, ws.get(), scan.release(), nullptr, coll);
+        ASSERT_TRUE(fetch->treeSupportsBatchedWork());
+
+        auto statusWithPlanExecutor = PlanExecutor::make(
+            &_txn, std::move(ws), std::move(fetch), coll, PlanExecutor::YIELD_AUTO);
+        ASSERT_OK(statusWithPlanExecutor.getStatus());
+        unique_ptr<PlanExecutor> exec = std::move(statusWithPlanExecutor.getValue());
+
+        // The IXSCAN's batch ends after kYieldIterations keys, when the yield policy first says to
+        // yield, and FETCH then stops after the first of them. The rest have been looked up
+        // already and are waiting for FETCH in its next batch.
+        BSONObj obj;
+        ASSERT_EQUALS(PlanExecutor::ADVANCED, exec->getNext(&obj, NULL));
+        ASSERT_EQUALS(0, obj["foo"].numberInt());
+
+        // Delete one of the waiting documents while yielding.
+        exec->saveState();
+        remove(BSON("foo" << 1));
+        exec->restoreState();
+
+        // Without document level locking, the deletion invalidates the waiting member, which is
+        // fetched before the document goes away. Otherwise, FETCH must look the document up again
+        // after the yield instead of returning the record it looked up before.
+        int expected = supportsDocLocking() ? 2 : 1;
+        PlanExecutor::ExecState state;
+        while (PlanExecutor::ADVANCED == (state = exec->getNext(&obj, NULL))) {
+            ASSERT_EQUALS(expected++, obj["foo"].numberInt());
+        }
+        ASSERT_EQUALS(PlanExecutor::IS_EOF, state);
+        ASSERT_EQUALS(kNumObj, expected);
+    }
+
+private:
+    static const int kNumObj = 50;
+    static const int kYieldIterations = 10;
+
+    const int _oldBatchSize;
+    const int _oldYieldIterations;
+    const int _oldYieldPeriodMS;
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_fetch") {}
@@ -226,6 +320,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStagePrefetchedBatchYieldAndInvalidate>();
     }
 };
 
@@ -104,7 +104,7 @@ public:
             _children.back().get(), true, interval.min, interval.max, lastInterval));
     }
 
-    StatusWith<double> computeDistance(WorkingSetMember* member) final {
+    StatusWith<double> computeDistance(WorkingSet* workingSet, WorkingSetMember* member) final {
         ASSERT(member->hasObj());
         return StatusWith<double>(member->obj.value()["distance"].numberDouble());
     }
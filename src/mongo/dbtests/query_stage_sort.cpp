@@ -41,6 +41,7 @@
 #include "mongo/db/exec/sort.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 
@@ -156,11 +157,13 @@ public:
         params.collection = coll;
         params.pattern = BSON("foo" << direction);
         params.limit = limit();
+        params.allowDiskUse = allowDiskUse();
 
         auto keyGenStage = make_unique<SortKeyGeneratorStage>(
             &_txn, queuedDataStage.release(), ws.get(), params.pattern, BSONObj(), nullptr);
 
         auto sortStage = make_unique<SortStage>(&_txn, params, ws.get(), keyGenStage.release());
+        SortStage* sortStagePtr = sortStage.get();
 
         auto fetchStage =
             make_unique<FetchStage>(&_txn, ws.get(), sortStage.release(), nullptr, coll);
@@ -192,6 +195,10 @@ public:
         }
         ASSERT_EQUALS(PlanExecutor::IS_EOF, state);
         checkCount(count);
+
+        // Tests which allow the sort to use disk are set up so that it has to.
+        auto stats = sortStagePtr->getStats();
+        ASSERT_EQUALS(allowDiskUse(), static_cast<SortStats*>(stats->specific.get())->usedDisk);
     }
 
     /**
@@ -215,6 +222,10 @@ public:
         return 0;
     };
 
+    // Whether the sort may spill to disk.
+    virtual bool allowDiskUse() const {
+        return false;
+    }
 
     static const char* ns() {
         return "unittests.QueryStageSort";
@@ -302,6 +313,48 @@ public:
     }
 };
 
+// Sort more objects than fit in the memory limit, so that they are spilled to disk.
+template <int LIMIT>
+class QueryStageSortSpillToDisk : public QueryStageSortTestBase {
+public:
+    QueryStageSortSpillToDisk() : _originalMaxBytes(internalQueryExecMaxBlockingSortBytes) {
+        internalQueryExecMaxBlockingSortBytes = 10 * 1024;
+    }
+
+    ~QueryStageSortSpillToDisk() {
+        internalQueryExecMaxBlockingSortBytes = _originalMaxBytes;
+    }
+
+    virtual int numObj() {
+        return 2000;
+    }
+
+    virtual int limit() const {
+        return LIMIT;
+    }
+
+    virtual bool allowDiskUse() const {
+        return true;
+    }
+
+    void run() {
+        OldClientWriteContext ctx(&_txn, ns());
+        Database* db = ctx.db();
+        Collection* coll = db->getCollection(ns());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_txn);
+            coll = db->createCollection(&_txn, ns());
+            wuow.commit();
+        }
+
+        fillData();
+        sortAndCheck(-1, coll);
+    }
+
+private:
+    const int _originalMaxBytes;
+};
+
 // Mutation invalidation of docs fed to sort.
 class QueryStageSortMutationInvalidation : public QueryStageSortTestBase {
 public:
@@ -586,6 +639,9 @@ public:
         // and a special case for limit == 1
         add<QueryStageSortDecWithLimit<1>>();
         add<QueryStageSortExt>();
+        add<QueryStageSortSpillToDisk<0>>();
+        // A limit larger than fits in memory must still spill, while only keeping the top results.
+        add<QueryStageSortSpillToDisk<1000>>();
         add<QueryStageSortMutationInvalidation>();
         add<QueryStageSortDeletionInvalidation>();
         add<QueryStageSortDeletionInvalidationWithLimit<10>>();
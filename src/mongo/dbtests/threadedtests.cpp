@@ -38,7 +38,9 @@
 #include <iostream>
 
 #include "mongo/config.h"
+#include "mongo/db/catalog/cursor_manager.h"
 #include "mongo/db/client.h"
+#include "mongo/db/clientcursor.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/bits.h"
@@ -554,6 +556,73 @@ private:
     }
 };
 
+// Many threads concurrently pinning and unpinning their own cursors, and registering and
+// deregistering executors, on a single CursorManager. This is the access pattern of many clients
+// issuing getMores against one hot collection. Also reports throughput, to make contention on the
+// cursor registry visible.
+class CursorManagerConcurrency : public ThreadedTest<16> {
+    static const int cursorsPerThread = 16;
+    static const int iterations = 20000;
+
+public:
+    CursorManagerConcurrency() : _cursorManager("unittests.cursorManagerConcurrency") {}
+
+private:
+    virtual void setup() {
+        _timer.reset();
+    }
+
+    virtual void subthread(int x) {
+        std::vector<CursorId> ids;
+        for (int i = 0; i < cursorsPerThread; i++) {
+            auto cursor = new ClientCursor(&_cursorManager,
+                                           nullptr,
+                                           "unittests.cursorManagerConcurrency",
+                                           false,
+                                           0,
+                                           BSONObj());
+            ids.push_back(cursor->cursorid());
+        }
+
+        // The registry only stores executor pointers, so distinct addresses are enough to stand in
+        // for real executors as long as they are deregistered before anything could use them.
+        char fakeExecutors[cursorsPerThread];
+
+        for (int i = 0; i < iterations; i++) {
+            const int which = i % cursorsPerThread;
+            {
+                ClientCursorPin pin(&_cursorManager, ids[which]);
+                ASSERT(pin.c());
+                ASSERT_EQUALS(ids[which], pin.c()->cursorid());
+            }
+
+            auto exec = reinterpret_cast<PlanExecutor*>(&fakeExecutors[which]);
+            _cursorManager.registerExecutor(exec);
+            _cursorManager.deregisterExecutor(exec);
+        }
+
+        for (auto id : ids) {
+            ClientCursorPin pin(&_cursorManager, id);
+            ASSERT(pin.c());
+            pin.deleteUnderlying();
+        }
+    }
+
+    virtual void validate() {
+        ASSERT_EQUALS(0U, _cursorManager.numCursors());
+
+        const long long micros = std::max(_timer.micros(), 1LL);
+        const long long ops = static_cast<long long>(nthreads) * iterations;
+        mongo::unittest::log() << "CursorManager: " << nthreads << " threads did " << ops
+                               << " pin/unpin + register/deregister rounds in " << micros
+                               << " micros (" << (ops * 1000 * 1000 / micros) << " rounds/sec)"
+                               << endl;
+    }
+
+    CursorManager _cursorManager;
+    Timer _timer;
+};
+
 class All : public Suite {
 public:
     All() : Suite("threading") {}
@@ -579,6 +648,8 @@ public:
         add<RWLockTest4>();
 
         add<TicketHolderWaits>();
+
+        add<CursorManagerConcurrency>();
     }
 };
 
@@ -39,9 +39,10 @@
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 // One interesting implementation note herein concerns how setup() and
-// refresh() are invoked outside of the global lock, but setTimeout is not.
+// refresh() are invoked outside of the specific pool's lock, but setTimeout is not.
 // This implementation detail simplifies mocks, allowing them to return
 // synchronously sometimes, whereas having timeouts fire instantly adds little
 // value. In practice, dumping the locks is always safe (because we restrict
@@ -63,8 +64,20 @@ public:
     ~SpecificPool();
 
     /**
-     * Gets a connection from the specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Locks this pool's mutex. If another thread holds it, records how long
+     * the caller was blocked.
+     */
+    stdx::unique_lock<stdx::mutex> lock();
+
+    /**
+     * Returns true once the pool has been removed from its parent. Callers
+     * which looked the pool up before that must look the host up again.
+     */
+    bool isShutdown(const stdx::unique_lock<stdx::mutex>& lk);
+
+    /**
+     * Gets a connection from the specific pool. Sinks a unique_lock on this
+     * pool's _mutex
      */
     void getConnection(const HostAndPort& hostAndPort,
                        Milliseconds timeout,
@@ -79,11 +92,16 @@ public:
     void processFailure(const Status& status, stdx::unique_lock<stdx::mutex> lk);
 
     /**
-     * Returns a connection to a specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Returns a connection to a specific pool. Sinks a unique_lock on this
+     * pool's _mutex
      */
     void returnConnection(ConnectionInterface* connection, stdx::unique_lock<stdx::mutex> lk);
 
+    /**
+     * Returns the host this pool connects to.
+     */
+    const HostAndPort& getHostAndPort() const;
+
     /**
      * Returns the number of connections currently checked out of the pool.
      */
@@ -104,13 +122,28 @@ public:
      */
     size_t createdConnections(const stdx::unique_lock<stdx::mutex>& lk);
 
+    /**
+     * Returns how long requests waited before being handed a connection.
+     */
+    const ConnectionPoolWaitHistogram& checkoutWait(const stdx::unique_lock<stdx::mutex>& lk);
+
+    /**
+     * Returns how long callers were blocked acquiring this pool's mutex.
+     */
+    const ConnectionPoolWaitHistogram& lockContention(const stdx::unique_lock<stdx::mutex>& lk);
+
 private:
     using OwnedConnection = std::unique_ptr<ConnectionInterface>;
     using OwnershipPool = stdx::unordered_map<ConnectionInterface*, OwnedConnection>;
-    using Request = std::pair<Date_t, GetConnectionCallback>;
+    struct Request {
+        Date_t expiration;
+        GetConnectionCallback callback;
+        // Value of _waitTimer when the request was made
+        long long requestedMicros;
+    };
     struct RequestComparator {
         bool operator()(const Request& a, const Request& b) {
-            return a.first > b.first;
+            return a.expiration > b.expiration;
         }
     };
 
@@ -132,6 +165,9 @@ private:
 
     const HostAndPort _hostAndPort;
 
+    // Guards all of the state below
+    stdx::mutex _mutex;
+
     OwnershipPool _readyPool;
     OwnershipPool _processingPool;
     OwnershipPool _droppedProcessingPool;
@@ -146,6 +182,11 @@ private:
 
     size_t _created;
 
+    // Only used to measure elapsed time for the histograms below
+    const Timer _waitTimer;
+    ConnectionPoolWaitHistogram _checkoutWait;
+    ConnectionPoolWaitHistogram _lockContention;
+
     /**
      * The current state of the pool
      *
@@ -167,6 +208,9 @@ private:
         // hostTimeout is passed, we're waiting for any processing
         // connections to finish before shutting down
         kInShutdown,
+
+        // The pool has been removed from its parent and must not be used
+        kShutdown,
     };
 
     State _state;
@@ -189,62 +233,86 @@ ConnectionPool::ConnectionPool(std::unique_ptr<DependentTypeFactoryInterface> im
 ConnectionPool::~ConnectionPool() = default;
 
 void ConnectionPool::dropConnections(const HostAndPort& hostAndPort) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    std::shared_ptr<SpecificPool> pool;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+        auto iter = _pools.find(hostAndPort);
+
+        if (iter == _pools.end())
+            return;
+
+        pool = iter->second;
+    }
 
-    auto iter = _pools.find(hostAndPort);
+    auto lk = pool->lock();
 
-    if (iter == _pools.end())
+    if (pool->isShutdown(lk))
         return;
 
-    iter->second.get()->processFailure(
-        Status(ErrorCodes::PooledConnectionsDropped, "Pooled connections dropped"), std::move(lk));
+    pool->processFailure(Status(ErrorCodes::PooledConnectionsDropped, "Pooled connections dropped"),
+                         std::move(lk));
 }
 
 void ConnectionPool::get(const HostAndPort& hostAndPort,
                          Milliseconds timeout,
                          GetConnectionCallback cb) {
-    SpecificPool* pool;
-
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    while (true) {
+        std::shared_ptr<SpecificPool> pool;
+        {
+            // Only the lookup happens under the global mutex
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+            auto& slot = _pools[hostAndPort];
+            if (!slot)
+                slot = std::make_shared<SpecificPool>(this, hostAndPort);
+            pool = slot;
+        }
 
-    auto iter = _pools.find(hostAndPort);
+        invariant(pool);
 
-    if (iter == _pools.end()) {
-        auto handle = stdx::make_unique<SpecificPool>(this, hostAndPort);
-        pool = handle.get();
-        _pools[hostAndPort] = std::move(handle);
-    } else {
-        pool = iter->second.get();
-    }
+        auto lk = pool->lock();
 
-    invariant(pool);
+        // We raced with the pool's host timeout, which removed it from _pools
+        // after we looked it up. Look the host up again.
+        if (pool->isShutdown(lk))
+            continue;
 
-    pool->getConnection(hostAndPort, timeout, std::move(lk), std::move(cb));
+        pool->getConnection(hostAndPort, timeout, std::move(lk), std::move(cb));
+        return;
+    }
 }
 
 void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    std::vector<std::shared_ptr<SpecificPool>> pools;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+        pools.reserve(_pools.size());
+        for (const auto& kv : _pools) {
+            pools.push_back(kv.second);
+        }
+    }
 
-    for (const auto& kv : _pools) {
-        HostAndPort host = kv.first;
+    for (const auto& pool : pools) {
+        auto lk = pool->lock();
+
+        if (pool->isShutdown(lk))
+            continue;
 
-        auto& pool = kv.second;
         ConnectionStatsPer hostStats{pool->inUseConnections(lk),
                                      pool->availableConnections(lk),
                                      pool->createdConnections(lk),
                                      pool->refreshingConnections(lk)};
-        stats->updateStatsForHost(_name, host, hostStats);
+        hostStats.checkoutWait = pool->checkoutWait(lk);
+        hostStats.lockContention = pool->lockContention(lk);
+        stats->updateStatsForHost(_name, pool->getHostAndPort(), hostStats);
     }
 }
 
-void ConnectionPool::returnConnection(ConnectionInterface* conn) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-
-    auto iter = _pools.find(conn->getHostAndPort());
-
-    invariant(iter != _pools.end());
-
-    iter->second.get()->returnConnection(conn, std::move(lk));
+void ConnectionPool::ConnectionHandleDeleter::operator()(ConnectionInterface* connection) {
+    if (_pool && connection)
+        _pool->returnConnection(connection, _pool->lock());
 }
 
 ConnectionPool::SpecificPool::SpecificPool(ConnectionPool* parent, const HostAndPort& hostAndPort)
@@ -260,6 +328,24 @@ ConnectionPool::SpecificPool::~SpecificPool() {
     DESTRUCTOR_GUARD(_requestTimer->cancelTimeout();)
 }
 
+stdx::unique_lock<stdx::mutex> ConnectionPool::SpecificPool::lock() {
+    stdx::unique_lock<stdx::mutex> lk(_mutex, stdx::try_to_lock);
+    if (!lk.owns_lock()) {
+        Timer blocked;
+        lk.lock();
+        _lockContention.increment(blocked.elapsed());
+    }
+    return lk;
+}
+
+bool ConnectionPool::SpecificPool::isShutdown(const stdx::unique_lock<stdx::mutex>& lk) {
+    return _state == State::kShutdown;
+}
+
+const HostAndPort& ConnectionPool::SpecificPool::getHostAndPort() const {
+    return _hostAndPort;
+}
+
 size_t ConnectionPool::SpecificPool::inUseConnections(const stdx::unique_lock<stdx::mutex>& lk) {
     return _checkedOutPool.size();
 }
@@ -278,6 +364,16 @@ size_t ConnectionPool::SpecificPool::createdConnections(const stdx::unique_lock<
     return _created;
 }
 
+const ConnectionPoolWaitHistogram& ConnectionPool::SpecificPool::checkoutWait(
+    const stdx::unique_lock<stdx::mutex>& lk) {
+    return _checkoutWait;
+}
+
+const ConnectionPoolWaitHistogram& ConnectionPool::SpecificPool::lockContention(
+    const stdx::unique_lock<stdx::mutex>& lk) {
+    return _lockContention;
+}
+
 void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
                                                  Milliseconds timeout,
                                                  stdx::unique_lock<stdx::mutex> lk,
@@ -289,7 +385,7 @@ void ConnectionPool::SpecificPool::getConnection(const HostAndPort& hostAndPort,
         ? RemoteCommandRequest::kNoExpirationDate
         : _parent->_factory->now() + timeout;
 
-    _requests.push(make_pair(expiration, std::move(cb)));
+    _requests.push(Request{expiration, std::move(cb), _waitTimer.micros()});
 
     updateStateInLock();
 
@@ -337,7 +433,7 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
                          [this](ConnectionInterface* connPtr, Status status) {
                              connPtr->indicateUsed();
 
-                             stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+                             auto lk = lock();
 
                              auto conn = takeFromProcessingPool(connPtr);
 
@@ -346,7 +442,7 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
                                  return;
 
                              // If we're in shutdown, we don't need refreshed connections
-                             if (_state == State::kInShutdown)
+                             if (_state == State::kInShutdown || _state == State::kShutdown)
                                  return;
 
                              // If the connection refreshed successfully, throw it back in the ready
@@ -381,7 +477,7 @@ void ConnectionPool::SpecificPool::addToReady(stdx::unique_lock<stdx::mutex>& lk
     connPtr->setTimeout(_parent->_options.refreshRequirement, [this, connPtr]() {
         OwnedConnection conn;
 
-        stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+        auto lk = lock();
 
         if (!_readyPool.count(connPtr)) {
             // We've already been checked out. We don't need to refresh
@@ -392,7 +488,7 @@ void ConnectionPool::SpecificPool::addToReady(stdx::unique_lock<stdx::mutex>& lk
         conn = takeFromPool(_readyPool, connPtr);
 
         // If we're in shutdown, we don't need to refresh connections
-        if (_state == State::kInShutdown)
+        if (_state == State::kInShutdown || _state == State::kShutdown)
             return;
 
         _checkedOutPool[connPtr] = std::move(conn);
@@ -437,7 +533,7 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status,
     lk.unlock();
 
     while (requestsToFail.size()) {
-        requestsToFail.top().second(status);
+        requestsToFail.top().callback(status);
         requestsToFail.pop();
     }
 }
@@ -479,7 +575,9 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
         }
 
         // Grab the request and callback
-        auto cb = std::move(_requests.top().second);
+        auto cb = std::move(_requests.top().callback);
+        _checkoutWait.increment(
+            Microseconds(_waitTimer.micros() - _requests.top().requestedMicros));
         _requests.pop();
 
         auto connPtr = conn.get();
@@ -492,7 +590,7 @@ void ConnectionPool::SpecificPool::fulfillRequests(stdx::unique_lock<stdx::mutex
         // pass it to the user
         connPtr->resetToUnknown();
         lk.unlock();
-        cb(ConnectionHandle(connPtr, ConnectionHandleDeleter(_parent)));
+        cb(ConnectionHandle(connPtr, ConnectionHandleDeleter(this)));
         lk.lock();
     }
 }
@@ -530,7 +628,7 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
                        [this](ConnectionInterface* connPtr, Status status) {
                            connPtr->indicateUsed();
 
-                           stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+                           auto lk = lock();
 
                            auto conn = takeFromProcessingPool(connPtr);
 
@@ -553,7 +651,10 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
 
 // Called every second after hostTimeout until all processing connections reap
 void ConnectionPool::SpecificPool::shutdown() {
-    stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+    // Removing the pool from the parent requires the global mutex, which must
+    // be acquired before the pool's own mutex.
+    stdx::unique_lock<stdx::mutex> parentLk(_parent->_mutex);
+    auto lk = lock();
 
     // We're racing:
     //
@@ -587,6 +688,12 @@ void ConnectionPool::SpecificPool::shutdown() {
     invariant(_requests.empty());
     invariant(_checkedOutPool.empty());
 
+    // Anyone who looked this pool up before we took the global mutex will see
+    // kShutdown and look the host up again.
+    _state = State::kShutdown;
+
+    // Erasing may destroy this pool, so release its mutex first.
+    lk.unlock();
     _parent->_pools.erase(_hostAndPort);
 }
 
@@ -616,29 +723,29 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
 
         // If we were already running and the timer is the same as it was
         // before, nothing to do
-        if (_state == State::kRunning && _requestTimerExpiration == _requests.top().first)
+        if (_state == State::kRunning && _requestTimerExpiration == _requests.top().expiration)
             return;
 
         _state = State::kRunning;
 
         _requestTimer->cancelTimeout();
 
-        _requestTimerExpiration = _requests.top().first;
+        _requestTimerExpiration = _requests.top().expiration;
 
-        auto timeout = _requests.top().first - _parent->_factory->now();
+        auto timeout = _requests.top().expiration - _parent->_factory->now();
 
         // We set a timer for the most recent request, then invoke each timed
         // out request we couldn't service
         _requestTimer->setTimeout(timeout, [this]() {
-            stdx::unique_lock<stdx::mutex> lk(_parent->_mutex);
+            auto lk = lock();
 
             auto now = _parent->_factory->now();
 
             while (_requests.size()) {
                 auto& x = _requests.top();
 
-                if (x.first <= now) {
-                    auto cb = std::move(x.second);
+                if (x.expiration <= now) {
+                    auto cb = std::move(x.callback);
                     _requests.pop();
 
                     lk.unlock();
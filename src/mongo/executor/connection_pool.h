@@ -124,8 +124,6 @@ public:
     void appendConnectionStats(ConnectionPoolStats* stats) const;
 
 private:
-    void returnConnection(ConnectionInterface* connection);
-
     std::string _name;
 
     // Options are set at startup and never changed at run time, so these are
@@ -134,23 +132,24 @@ private:
 
     const std::unique_ptr<DependentTypeFactoryInterface> _factory;
 
-    // The global mutex for specific pool access and the generation counter
+    // Guards only the map of specific pools. Each SpecificPool synchronizes its own state with
+    // its own mutex, so checking out and returning connections to different hosts does not
+    // serialize on this lock.
     mutable stdx::mutex _mutex;
-    stdx::unordered_map<HostAndPort, std::unique_ptr<SpecificPool>> _pools;
+    stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> _pools;
 };
 
 class ConnectionPool::ConnectionHandleDeleter {
 public:
     ConnectionHandleDeleter() = default;
-    ConnectionHandleDeleter(ConnectionPool* pool) : _pool(pool) {}
+    ConnectionHandleDeleter(SpecificPool* pool) : _pool(pool) {}
 
-    void operator()(ConnectionInterface* connection) {
-        if (_pool && connection)
-            _pool->returnConnection(connection);
-    }
+    void operator()(ConnectionInterface* connection);
 
 private:
-    ConnectionPool* _pool = nullptr;
+    // A specific pool is not shut down while any of its connections are checked out, so this
+    // pointer outlives the connection it returns.
+    SpecificPool* _pool = nullptr;
 };
 
 /**
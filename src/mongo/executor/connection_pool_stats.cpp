@@ -30,12 +30,52 @@
 
 #include "mongo/executor/connection_pool_stats.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
 #include "mongo/util/map_util.h"
 
 namespace mongo {
 namespace executor {
 
+void ConnectionPoolWaitHistogram::increment(Microseconds duration) {
+    const auto micros = std::max<long long>(durationCount<Microseconds>(duration), 0);
+    const size_t bucket =
+        micros == 0 ? 0 : 64 - countLeadingZeros64(static_cast<unsigned long long>(micros));
+    buckets[std::min(bucket, kNumBuckets - 1)]++;
+    count++;
+    totalMicros += micros;
+}
+
+ConnectionPoolWaitHistogram& ConnectionPoolWaitHistogram::operator+=(
+    const ConnectionPoolWaitHistogram& other) {
+    for (size_t i = 0; i < kNumBuckets; i++) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    totalMicros += other.totalMicros;
+
+    return *this;
+}
+
+void ConnectionPoolWaitHistogram::appendToBSON(StringData fieldName,
+                                               BSONObjBuilder* builder) const {
+    BSONObjBuilder histogramBuilder(builder->subobjStart(fieldName));
+    {
+        BSONArrayBuilder arrayBuilder(histogramBuilder.subarrayStart("histogram"));
+        for (size_t i = 0; i < kNumBuckets; i++) {
+            if (buckets[i] == 0)
+                continue;
+            BSONObjBuilder entryBuilder(arrayBuilder.subobjStart());
+            entryBuilder.append("micros", i == 0 ? 0LL : 1LL << (i - 1));
+            entryBuilder.append("count", static_cast<long long>(buckets[i]));
+        }
+    }
+    histogramBuilder.append("totalMicros", static_cast<long long>(totalMicros));
+    histogramBuilder.append("count", static_cast<long long>(count));
+}
+
 ConnectionStatsPer::ConnectionStatsPer(size_t nInUse,
                                        size_t nAvailable,
                                        size_t nCreated,
@@ -49,6 +89,8 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     available += other.available;
     created += other.created;
     refreshing += other.refreshing;
+    checkoutWait += other.checkoutWait;
+    lockContention += other.lockContention;
 
     return *this;
 }
@@ -83,6 +125,8 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
             poolInfo.appendNumber("poolAvailable", poolStats.available);
             poolInfo.appendNumber("poolCreated", poolStats.created);
             poolInfo.appendNumber("poolRefreshing", poolStats.refreshing);
+            poolStats.checkoutWait.appendToBSON("poolCheckoutWait", &poolInfo);
+            poolStats.lockContention.appendToBSON("poolLockContention", &poolInfo);
             for (auto&& host : statsByPoolHost[pool.first]) {
                 BSONObjBuilder hostInfo(poolInfo.subobjStart(host.first.toString()));
                 auto hostStats = host.second;
@@ -90,6 +134,8 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
                 hostInfo.appendNumber("available", hostStats.available);
                 hostInfo.appendNumber("created", hostStats.created);
                 hostInfo.appendNumber("refreshing", hostStats.refreshing);
+                hostStats.checkoutWait.appendToBSON("checkoutWait", &hostInfo);
+                hostStats.lockContention.appendToBSON("lockContention", &hostInfo);
             }
         }
     }
@@ -102,6 +148,8 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result) {
             hostInfo.appendNumber("available", hostStats.available);
             hostInfo.appendNumber("created", hostStats.created);
             hostInfo.appendNumber("refreshing", hostStats.refreshing);
+            hostStats.checkoutWait.appendToBSON("checkoutWait", &hostInfo);
+            hostStats.lockContention.appendToBSON("lockContention", &hostInfo);
         }
     }
 }
@@ -28,12 +28,40 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
+
+#include "mongo/base/string_data.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/net/hostandport.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
+
+class BSONObjBuilder;
+
 namespace executor {
 
+/**
+ * Counts durations in power-of-two microsecond buckets. Connection pools use it to report how
+ * long callers waited for a connection and how long they were blocked on a pool's mutex.
+ */
+struct ConnectionPoolWaitHistogram {
+    static const size_t kNumBuckets = 32;
+
+    void increment(Microseconds duration);
+
+    ConnectionPoolWaitHistogram& operator+=(const ConnectionPoolWaitHistogram& other);
+
+    void appendToBSON(StringData fieldName, BSONObjBuilder* builder) const;
+
+    // buckets[0] counts durations under 1 microsecond and buckets[i] counts durations in
+    // [2^(i-1), 2^i) microseconds. The last bucket also counts everything longer.
+    std::array<uint64_t, kNumBuckets> buckets{};
+    uint64_t count = 0;
+    uint64_t totalMicros = 0;
+};
+
 /**
  * Holds connection information for a specific pool or remote host. These objects are maintained by
  * a parent ConnectionPoolStats object and should not need to be created directly.
@@ -49,6 +77,8 @@ struct ConnectionStatsPer {
     size_t available = 0u;
     size_t created = 0u;
     size_t refreshing = 0u;
+    ConnectionPoolWaitHistogram checkoutWait;
+    ConnectionPoolWaitHistogram lockContention;
 };
 
 /**
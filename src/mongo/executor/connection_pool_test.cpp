@@ -30,6 +30,7 @@
 #include "mongo/executor/connection_pool_test_fixture.h"
 
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/stdx/future.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/unittest.h"
@@ -830,6 +831,48 @@ TEST_F(ConnectionPoolTest, dropConnections) {
     ASSERT(reachedB);
 }
 
+
+/**
+ * Verify that each host's pool reports its own connections and checkout waits.
+ */
+TEST_F(ConnectionPoolTest, statsArePerHost) {
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool");
+
+    const HostAndPort host1("localhost:30000");
+    const HostAndPort host2("localhost:30001");
+
+    // Check out one connection from each host and keep the second one
+    ConnectionPool::ConnectionHandle handle;
+    ConnectionImpl::pushSetup(Status::OK());
+    pool.get(host1,
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 doneWith(swConn.getValue());
+             });
+    ConnectionImpl::pushSetup(Status::OK());
+    pool.get(host2,
+             Milliseconds(5000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 handle = std::move(swConn.getValue());
+             });
+    ASSERT(handle);
+
+    ConnectionPoolStats stats;
+    pool.appendConnectionStats(&stats);
+
+    ASSERT_EQ(stats.statsByHost[host1].inUse, 0U);
+    ASSERT_EQ(stats.statsByHost[host1].available, 1U);
+    ASSERT_EQ(stats.statsByHost[host1].checkoutWait.count, 1U);
+    ASSERT_EQ(stats.statsByHost[host2].inUse, 1U);
+    ASSERT_EQ(stats.statsByHost[host2].available, 0U);
+    ASSERT_EQ(stats.statsByHost[host2].checkoutWait.count, 1U);
+    ASSERT_EQ(stats.statsByPool["test pool"].checkoutWait.count, 2U);
+
+    doneWith(handle);
+}
+
 }  // namespace connection_pool_test_details
 }  // namespace executor
 }  // namespace mongo
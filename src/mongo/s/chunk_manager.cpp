@@ -87,9 +87,11 @@ public:
                         RangeMap* currMap,
                         ChunkVersion* maxVersion,
                         MaxChunkVersionMap* maxShardVersions,
-                        ChunkManager* manager)
+                        ChunkManager* manager,
+                        BSONObjSet* changedChunks)
         : ConfigDiffTracker<shared_ptr<Chunk>>(ns, currMap, maxVersion, maxShardVersions),
-          _manager(manager) {}
+          _manager(manager),
+          _changedChunks(changedChunks) {}
 
     bool isTracked(const ChunkType& chunk) const final {
         // Mongos tracks all shards
@@ -103,6 +105,7 @@ public:
     pair<BSONObj, shared_ptr<Chunk>> rangeFor(OperationContext* txn,
                                               const ChunkType& chunk) const final {
         shared_ptr<Chunk> c(new Chunk(txn, _manager, chunk));
+        _changedChunks->insert(chunk.getMax());
         return make_pair(chunk.getMax(), c);
     }
 
@@ -113,6 +116,9 @@ public:
 
 private:
     ChunkManager* const _manager;
+
+    // Receives the max key of every chunk loaded from the config server
+    BSONObjSet* const _changedChunks;
 };
 
 bool allOfType(BSONType type, const BSONObj& o) {
@@ -125,7 +131,26 @@ bool allOfType(BSONType type, const BSONObj& o) {
     return true;
 }
 
-bool isChunkMapValid(const ChunkMap& chunkMap) {
+bool areChunksAdjacent(ChunkMap::const_iterator last, ChunkMap::const_iterator it) {
+    if (SimpleBSONObjComparator::kInstance.evaluate(it->second->getMin() ==
+                                                    last->second->getMax())) {
+        return true;
+    }
+
+    log() << last->second->toString();
+    log() << it->second->toString();
+    log() << it->second->getMin();
+    log() << last->second->getMax();
+    return false;
+}
+
+/**
+ * Checks that the chunks in 'chunkMap' cover the whole key space without gaps or overlaps. If
+ * 'changedChunks' is specified, only the boundaries of those chunks are checked, which is
+ * sufficient when the remainder of the map was copied from an already validated map, because a gap
+ * or an overlap can only appear next to a chunk which has been reloaded.
+ */
+bool isChunkMapValid(const ChunkMap& chunkMap, const BSONObjSet* changedChunks = nullptr) {
 #define ENSURE(x)                                          \
     do {                                                   \
         if (!(x)) {                                        \
@@ -142,22 +167,30 @@ bool isChunkMapValid(const ChunkMap& chunkMap) {
     ENSURE(allOfType(MinKey, chunkMap.begin()->second->getMin()));
     ENSURE(allOfType(MaxKey, boost::prior(chunkMap.end())->second->getMax()));
 
-    // Make sure there are no gaps or overlaps
-    for (ChunkMap::const_iterator it = boost::next(chunkMap.begin()), end = chunkMap.end();
-         it != end;
-         ++it) {
-        ChunkMap::const_iterator last = boost::prior(it);
-
-        if (SimpleBSONObjComparator::kInstance.evaluate(it->second->getMin() !=
-                                                        last->second->getMax())) {
-            log() << last->second->toString();
-            log() << it->second->toString();
-            log() << it->second->getMin();
-            log() << last->second->getMax();
+    if (!changedChunks) {
+        // Make sure there are no gaps or overlaps
+        for (ChunkMap::const_iterator it = boost::next(chunkMap.begin()), end = chunkMap.end();
+             it != end;
+             ++it) {
+            ENSURE(areChunksAdjacent(boost::prior(it), it));
+        }
+
+        return true;
+    }
+
+    // Make sure there are no gaps or overlaps around the chunks which were reloaded
+    for (const auto& changedChunkMax : *changedChunks) {
+        ChunkMap::const_iterator it = chunkMap.find(changedChunkMax);
+        ENSURE(it != chunkMap.end());
+
+        if (it != chunkMap.begin()) {
+            ENSURE(areChunksAdjacent(boost::prior(it), it));
         }
 
-        ENSURE(SimpleBSONObjComparator::kInstance.evaluate(it->second->getMin() ==
-                                                           last->second->getMax()));
+        ChunkMap::const_iterator next = boost::next(it);
+        if (next != chunkMap.end()) {
+            ENSURE(areChunksAdjacent(it, next));
+        }
     }
 
     return true;
@@ -214,22 +247,43 @@ void ChunkManager::loadExistingRanges(OperationContext* txn, const ChunkManager*
             SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<std::shared_ptr<Chunk>>();
         set<ShardId> shardIds;
         ShardVersionMap shardVersions;
+        BSONObjSet changedChunks = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
 
         Timer t;
 
         log() << "ChunkManager loading chunks for " << _ns << " sequenceNumber: " << _sequenceNumber
               << " based on: " << (oldManager ? oldManager->getVersion().toString() : "(empty)");
 
-        if (_load(txn, chunkMap, shardIds, &shardVersions, oldManager)) {
+        if (_load(txn, chunkMap, shardIds, &shardVersions, oldManager, &changedChunks)) {
+            // A chunk read from the config server may have been replaced by a later one from the
+            // same diff, for example when it was merged, so only keep those still in the map
+            for (auto it = changedChunks.begin(); it != changedChunks.end();) {
+                if (chunkMap.count(*it)) {
+                    ++it;
+                } else {
+                    it = changedChunks.erase(it);
+                }
+            }
+
+            // If only a small part of the old routing table changed, validate and rebuild just the
+            // regions around the reloaded chunks. The old manager stays untouched, so readers which
+            // still hold it are not affected.
+            const bool incremental = oldManager && !oldManager->_chunkRangeMap.empty() &&
+                !chunkMap.empty() && _version.epoch() == oldManager->getVersion().epoch() &&
+                changedChunks.size() < chunkMap.size() / 2;
+
             // TODO: Merge into diff code above, so we validate in one place
-            if (isChunkMapValid(chunkMap)) {
+            if (isChunkMapValid(chunkMap, incremental ? &changedChunks : nullptr)) {
                 _chunkMap = std::move(chunkMap);
                 _shardIds = std::move(shardIds);
                 _shardVersions = std::move(shardVersions);
-                _chunkRangeMap = _constructRanges(_chunkMap);
+                _chunkRangeMap = incremental
+                    ? _updateRanges(oldManager->_chunkRangeMap, _chunkMap, changedChunks)
+                    : _constructRanges(_chunkMap);
 
                 log() << "ChunkManager load took " << t.millis() << " ms and found version "
-                      << _version;
+                      << _version << " (" << changedChunks.size() << " of " << _chunkMap.size()
+                      << " chunks changed" << (incremental ? ", refreshed incrementally)" : ")");
 
                 return;
             }
@@ -251,7 +305,8 @@ bool ChunkManager::_load(OperationContext* txn,
                          ChunkMap& chunkMap,
                          set<ShardId>& shardIds,
                          ShardVersionMap* shardVersions,
-                         const ChunkManager* oldManager) {
+                         const ChunkManager* oldManager,
+                         BSONObjSet* changedChunks) {
     // Reset the max version, but not the epoch, when we aren't loading from the oldManager
     _version = ChunkVersion(0, 0, _version.epoch());
 
@@ -267,9 +322,12 @@ bool ChunkManager::_load(OperationContext* txn,
         // Load a copy of the chunk map, replacing the chunk manager with our own
         const ChunkMap& oldChunkMap = oldManager->getChunkMap();
 
-        // Could be v.expensive
-        // TODO: If chunks were immutable and didn't reference the manager, we could do more
-        // interesting things here
+        // Still linear in the number of chunks, since this allocates a new Chunk for every entry,
+        // so the refresh of a collection with very many chunks stays expensive even when few of
+        // them changed. The bounds themselves are shared with the old chunks rather than copied,
+        // and the old map is already sorted, so each entry is appended without a search.
+        // TODO: If chunks were immutable and didn't reference the manager, they could be shared
+        // between the old and the new map instead
         for (const auto& oldChunkMapEntry : oldChunkMap) {
             shared_ptr<Chunk> oldC = oldChunkMapEntry.second;
             shared_ptr<Chunk> newC(new Chunk(this,
@@ -279,7 +337,7 @@ bool ChunkManager::_load(OperationContext* txn,
                                              oldC->getLastmod(),
                                              oldC->getBytesWritten()));
 
-            chunkMap.insert(make_pair(oldC->getMax(), newC));
+            chunkMap.insert(chunkMap.end(), make_pair(oldC->getMax(), newC));
         }
 
         LOG(2) << "loading chunk manager for collection " << _ns
@@ -288,7 +346,7 @@ bool ChunkManager::_load(OperationContext* txn,
     }
 
     // Attach a diff tracker for the versioned chunk data
-    CMConfigDiffTracker differ(_ns, &chunkMap, &_version, shardVersions, this);
+    CMConfigDiffTracker differ(_ns, &chunkMap, &_version, shardVersions, this, changedChunks);
 
     // Diff tracker should *always* find at least one chunk if collection exists
     // Get the diff query required
@@ -336,6 +394,7 @@ bool ChunkManager::_load(OperationContext* txn,
         // Set all our data to empty
         chunkMap.clear();
         shardVersions->clear();
+        changedChunks->clear();
 
         _version = ChunkVersion(0, 0, OID());
         _configOpTime = opTime;
@@ -358,6 +417,7 @@ bool ChunkManager::_load(OperationContext* txn,
         // Set all our data to empty to be extra safe
         chunkMap.clear();
         shardVersions->clear();
+        changedChunks->clear();
 
         _version = ChunkVersion(0, 0, OID());
 
@@ -788,12 +848,87 @@ ChunkManager::ChunkRangeMap ChunkManager::_constructRanges(const ChunkMap& chunk
         return chunkRangeMap;
     }
 
-    ChunkMap::const_iterator current = chunkMap.cbegin();
+    _appendRanges(chunkMap.cbegin(), chunkMap.cend(), &chunkRangeMap);
+
+    invariant(!chunkRangeMap.empty());
+    invariant(allOfType(MinKey, chunkRangeMap.begin()->second.getMin()));
+    invariant(allOfType(MaxKey, chunkRangeMap.rbegin()->first));
+
+    return chunkRangeMap;
+}
+
+ChunkManager::ChunkRangeMap ChunkManager::_updateRanges(const ChunkRangeMap& oldChunkRangeMap,
+                                                        const ChunkMap& chunkMap,
+                                                        const BSONObjSet& changedChunks) {
+    invariant(!oldChunkRangeMap.empty());
+    invariant(!chunkMap.empty());
+
+    // Find the windows of the key space which need to be rebuilt. Each window extends over the old
+    // ranges touched by a changed chunk plus one more range on each side, so that the rebuilt
+    // ranges get merged with their neighbours if they end up on the same shard. Since the window
+    // boundaries are old range boundaries which no changed chunk straddles, they are also chunk
+    // boundaries in the new chunk map. Changed chunks are visited in key order, so overlapping or
+    // touching windows can be coalesced as they are generated.
+    vector<pair<BSONObj, BSONObj>> windows;
+
+    for (const auto& changedChunkMax : changedChunks) {
+        const auto chunkIt = chunkMap.find(changedChunkMax);
+        invariant(chunkIt != chunkMap.end());
+
+        auto first = oldChunkRangeMap.upper_bound(chunkIt->second->getMin());
+        invariant(first != oldChunkRangeMap.end());
+        if (first != oldChunkRangeMap.begin()) {
+            --first;
+        }
+
+        auto last = oldChunkRangeMap.lower_bound(chunkIt->second->getMax());
+        invariant(last != oldChunkRangeMap.end());
+        if (std::next(last) != oldChunkRangeMap.end()) {
+            ++last;
+        }
+
+        if (!windows.empty() && SimpleBSONObjComparator::kInstance.evaluate(
+                                    first->second.getMin() <= windows.back().second)) {
+            windows.back().second = last->first;
+        } else {
+            windows.emplace_back(first->second.getMin(), last->first);
+        }
+    }
+
+    // Copying the old ranges is linear in their number, which is usually much smaller than the
+    // number of chunks, since neighbouring chunks on the same shard share a range.
+    ChunkRangeMap chunkRangeMap = oldChunkRangeMap;
+
+    for (const auto& window : windows) {
+        chunkRangeMap.erase(chunkRangeMap.upper_bound(window.first),
+                            chunkRangeMap.upper_bound(window.second));
+
+        const auto windowBegin = chunkMap.upper_bound(window.first);
+        const auto windowEnd = chunkMap.upper_bound(window.second);
+        invariant(windowBegin != windowEnd);
+        invariant(SimpleBSONObjComparator::kInstance.evaluate(windowBegin->second->getMin() ==
+                                                              window.first));
+        invariant(SimpleBSONObjComparator::kInstance.evaluate(std::prev(windowEnd)->first ==
+                                                              window.second));
+
+        _appendRanges(windowBegin, windowEnd, &chunkRangeMap);
+    }
+
+    invariant(allOfType(MinKey, chunkRangeMap.begin()->second.getMin()));
+    invariant(allOfType(MaxKey, chunkRangeMap.rbegin()->first));
+
+    return chunkRangeMap;
+}
+
+void ChunkManager::_appendRanges(ChunkMap::const_iterator begin,
+                                 ChunkMap::const_iterator end,
+                                 ChunkRangeMap* chunkRangeMap) {
+    ChunkMap::const_iterator current = begin;
 
-    while (current != chunkMap.cend()) {
+    while (current != end) {
         const auto rangeFirst = current;
         current = std::find_if(
-            current, chunkMap.cend(), [&rangeFirst](const ChunkMap::value_type& chunkMapEntry) {
+            current, end, [&rangeFirst](const ChunkMap::value_type& chunkMapEntry) {
                 return chunkMapEntry.second->getShardId() != rangeFirst->second->getShardId();
             });
         const auto rangeLast = std::prev(current);
@@ -801,22 +936,16 @@ ChunkManager::ChunkRangeMap ChunkManager::_constructRanges(const ChunkMap& chunk
         const BSONObj rangeMin = rangeFirst->second->getMin();
         const BSONObj rangeMax = rangeLast->second->getMax();
 
-        auto insertResult = chunkRangeMap.insert(std::make_pair(
+        auto insertResult = chunkRangeMap->insert(std::make_pair(
             rangeMax, ShardAndChunkRange(rangeMin, rangeMax, rangeFirst->second->getShardId())));
         invariant(insertResult.second);
-        if (insertResult.first != chunkRangeMap.begin()) {
+        if (insertResult.first != chunkRangeMap->begin()) {
             // Make sure there are no gaps in the ranges
             insertResult.first--;
             invariant(
                 SimpleBSONObjComparator::kInstance.evaluate(insertResult.first->first == rangeMin));
         }
     }
-
-    invariant(!chunkRangeMap.empty());
-    invariant(allOfType(MinKey, chunkRangeMap.begin()->second.getMin()));
-    invariant(allOfType(MaxKey, chunkRangeMap.rbegin()->first));
-
-    return chunkRangeMap;
 }
 
 uint64_t ChunkManager::getCurrentDesiredChunkSize() const {
@@ -239,19 +239,39 @@ private:
     /**
      * If load was successful, returns true and it is guaranteed that the _chunkMap and
      * _chunkRangeMap are consistent with each other. If false is returned, it is not safe to use
-     * the chunk manager anymore.
+     * the chunk manager anymore. The max keys of all chunks read from the config server are
+     * returned in 'changedChunks'.
      */
     bool _load(OperationContext* txn,
                ChunkMap& chunks,
                std::set<ShardId>& shardIds,
                ShardVersionMap* shardVersions,
-               const ChunkManager* oldManager);
+               const ChunkManager* oldManager,
+               BSONObjSet* changedChunks);
 
     /**
      * Merges consecutive chunks, which reside on the same shard into a single range.
      */
     static ChunkRangeMap _constructRanges(const ChunkMap& chunkMap);
 
+    /**
+     * Produces the same result as _constructRanges(chunkMap), but starts from the ranges of the
+     * previous version of the chunk map and only rebuilds the parts of the key space around the
+     * chunks whose max keys are in 'changedChunks'. All other chunks in 'chunkMap' must be
+     * unchanged relative to 'oldChunkRangeMap'.
+     */
+    static ChunkRangeMap _updateRanges(const ChunkRangeMap& oldChunkRangeMap,
+                                       const ChunkMap& chunkMap,
+                                       const BSONObjSet& changedChunks);
+
+    /**
+     * Merges the consecutive chunks in [begin, end), which reside on the same shard, into ranges
+     * and inserts them into 'chunkRangeMap'.
+     */
+    static void _appendRanges(ChunkMap::const_iterator begin,
+                              ChunkMap::const_iterator end,
+                              ChunkRangeMap* chunkRangeMap);
+
     // All members should be const for thread-safety
     const std::string _ns;
     const ShardKeyPattern _keyPattern;
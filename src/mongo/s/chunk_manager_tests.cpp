@@ -243,6 +243,122 @@ TEST_F(ChunkManagerTests, Basic) {
     std::cout << "completely done";
 }
 
+/**
+ * Tests that a ChunkManager, which is refreshed incrementally from an old ChunkManager, routes
+ * exactly like a ChunkManager which loads the same chunks from scratch.
+ */
+TEST_F(ChunkManagerTests, IncrementalRefresh) {
+    const ShardId otherShardId("shard0001");
+    const OID epoch = OID::gen();
+    const int numChunks = 24;
+
+    std::vector<BSONObj> shards{
+        BSON(ShardType::name() << _shardId << ShardType::host()
+                               << ConnectionString(HostAndPort("hostFooBar:27017")).toString()),
+        BSON(ShardType::name() << otherShardId << ShardType::host()
+                               << ConnectionString(HostAndPort("hostBarFoo:27017")).toString())};
+
+    auto makeChunk = [&](const BSONObj& min,
+                         const BSONObj& max,
+                         const ShardId& shardId,
+                         const ChunkVersion& version) {
+        ChunkType chunk;
+        chunk.setNS(_collName);
+        chunk.setMin(min);
+        chunk.setMax(max);
+        chunk.setShard(shardId);
+        chunk.setVersion(version);
+        return chunk.toBSON();
+    };
+
+    auto boundary = [&](int i) {
+        if (i == 0) {
+            return BSON("_id" << MINKEY);
+        } else if (i == numChunks) {
+            return BSON("_id" << MAXKEY);
+        }
+        return BSON("_id" << i * 10);
+    };
+
+    // Every four consecutive chunks reside on the same shard, alternating between the two shards
+    std::vector<BSONObj> chunks;
+    for (int i = 0; i < numChunks; i++) {
+        chunks.push_back(makeChunk(boundary(i),
+                                   boundary(i + 1),
+                                   (i / 4) % 2 == 0 ? _shardId : otherShardId,
+                                   ChunkVersion(1, i, epoch)));
+    }
+
+    CollectionType collType;
+    collType.setNs(NamespaceString{_collName});
+    collType.setEpoch(epoch);
+    collType.setUpdatedAt(jsTime());
+    collType.setKeyPattern(BSON("_id" << 1));
+    collType.setUnique(false);
+    collType.setDropped(false);
+
+    ChunkManager manager(operationContext(), collType);
+    auto future = launchAsync([&] { manager.loadExistingRanges(operationContext(), nullptr); });
+    expectFindOnConfigSendBSONObjVector(chunks);
+    expectFindOnConfigSendBSONObjVector(shards);
+    future.timed_get(kFutureTimeout);
+
+    // Move chunks in the second and the sixth group of chunks to the other shard and split the last
+    // chunk, which leaves the ranges of the fourth group untouched. One chunk of the third group is
+    // split and merged back within the same diff, so the split chunk is no longer in the new map.
+    std::vector<BSONObj> diff{
+        makeChunk(boundary(5), boundary(6), _shardId, ChunkVersion(2, 0, epoch)),
+        makeChunk(boundary(7), boundary(8), _shardId, ChunkVersion(2, 1, epoch)),
+        makeChunk(boundary(9), BSON("_id" << 95), _shardId, ChunkVersion(2, 2, epoch)),
+        makeChunk(BSON("_id" << 95), boundary(10), _shardId, ChunkVersion(2, 3, epoch)),
+        makeChunk(boundary(9), boundary(10), _shardId, ChunkVersion(2, 4, epoch)),
+        makeChunk(boundary(21), boundary(22), _shardId, ChunkVersion(3, 0, epoch)),
+        makeChunk(boundary(23), BSON("_id" << 235), otherShardId, ChunkVersion(3, 1, epoch)),
+        makeChunk(BSON("_id" << 235), boundary(24), otherShardId, ChunkVersion(3, 2, epoch))};
+
+    std::vector<BSONObj> allChunks(chunks.begin(), chunks.end() - 1);
+    allChunks[5] = diff[0];
+    allChunks[7] = diff[1];
+    allChunks[9] = diff[4];
+    allChunks[21] = diff[5];
+    allChunks.push_back(diff[6]);
+    allChunks.push_back(diff[7]);
+
+    ChunkManager refreshedManager(manager.getns(), manager.getShardKeyPattern(), nullptr, false);
+    future = launchAsync(
+        [&] { refreshedManager.loadExistingRanges(operationContext(), &manager); });
+    expectFindOnConfigSendBSONObjVector(diff);
+    future.timed_get(kFutureTimeout);
+
+    ChunkManager reloadedManager(operationContext(), collType);
+    future = launchAsync([&] { reloadedManager.loadExistingRanges(operationContext(), nullptr); });
+    expectFindOnConfigSendBSONObjVector(allChunks);
+    future.timed_get(kFutureTimeout);
+
+    ASSERT_EQ(ChunkVersion(3, 2, epoch).toString(), refreshedManager.getVersion().toString());
+    ASSERT_EQ(reloadedManager.getVersion().toString(), refreshedManager.getVersion().toString());
+    ASSERT_EQ(numChunks + 1, refreshedManager.numChunks());
+
+    // The old manager must not have been affected by the refresh
+    ASSERT_EQ(ChunkVersion(1, numChunks - 1, epoch).toString(), manager.getVersion().toString());
+    ASSERT_EQ(numChunks, manager.numChunks());
+
+    for (int key = -5; key <= numChunks * 10 + 5; key += 5) {
+        for (int length = 0; length <= 20; length += 5) {
+            const BSONObj min = BSON("_id" << key);
+            const BSONObj max = BSON("_id" << key + length);
+
+            set<ShardId> refreshedShardIds;
+            refreshedManager.getShardIdsForRange(refreshedShardIds, min, max);
+
+            set<ShardId> reloadedShardIds;
+            reloadedManager.getShardIdsForRange(reloadedShardIds, min, max);
+
+            ASSERT(refreshedShardIds == reloadedShardIds);
+        }
+    }
+}
+
 /**
  * Tests that chunk metadata is created correctly when using ChunkManager to create chunks for the
  * first time. Creating chunks on multiple shards is not tested here since there are unresolved
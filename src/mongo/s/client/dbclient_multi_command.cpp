@@ -30,6 +30,9 @@
 
 #include "mongo/s/client/dbclient_multi_command.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "mongo/db/audit.h"
 #include "mongo/db/client.h"
 #include "mongo/db/dbmessage.h"
@@ -40,6 +43,7 @@
 #include "mongo/s/write_ops/batched_command_request.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/net/message.h"
+#include "mongo/util/net/socket_poll.h"
 
 namespace mongo {
 
@@ -148,7 +152,10 @@ void DBClientMultiCommand::sendAll() {
          it != _pendingCommands.end();
          ++it) {
         PendingCommand* command = *it;
-        dassert(!command->conn);
+
+        // Skip commands which were sent (or failed to send) by an earlier sendAll
+        if (command->conn || !command->status.isOK())
+            continue;
 
         try {
             dassert(command->endpoint.type() == ConnectionString::MASTER ||
@@ -156,8 +163,7 @@ void DBClientMultiCommand::sendAll() {
 
             command->conn = stdx::make_unique<ShardConnection>(command->endpoint, "");
 
-            DBClientBase* const actualConn =
-                (!_isConfig ? command->conn->get() : command->conn->getRawConn());
+            DBClientBase* const actualConn = _getActualConn(command);
 
             // Sanity check if we're sending a batch write that we're talking to a new-enough
             // server.
@@ -178,9 +184,90 @@ int DBClientMultiCommand::numPending() const {
     return static_cast<int>(_pendingCommands.size());
 }
 
+DBClientBase* DBClientMultiCommand::_getActualConn(PendingCommand* command) const {
+    return !_isConfig ? command->conn->get() : command->conn->getRawConn();
+}
+
+size_t DBClientMultiCommand::chooseReadyCommand(const std::vector<ReadyCheck>& commands,
+                                                int timeoutMillis,
+                                                bool* timedOut) {
+    invariant(!commands.empty());
+    *timedOut = false;
+
+    std::vector<size_t> candidates;
+    std::vector<pollfd> pollFds;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        const ReadyCheck& command = commands[i];
+        auto sameEndpoint = [&](size_t other) {
+            return commands[other].endpoint == command.endpoint;
+        };
+        if (std::any_of(candidates.begin(), candidates.end(), sameEndpoint))
+            continue;
+
+        // Failures to send can be reported without waiting for anything
+        if (!command.sent)
+            return i;
+
+        if (command.fd < 0 || !isPollSupported()) {
+            // No way to tell when this one is ready, so wait for the oldest command instead
+            return 0;
+        }
+
+        pollfd pollFd;
+        pollFd.fd = command.fd;
+        pollFd.events = POLLIN;
+        pollFd.revents = 0;
+        pollFds.push_back(pollFd);
+        candidates.push_back(i);
+    }
+
+    const int numReady = socketPoll(pollFds.data(), pollFds.size(), timeoutMillis);
+    if (numReady > 0) {
+        for (size_t i = 0; i < pollFds.size(); ++i) {
+            if (pollFds[i].revents != 0)
+                return candidates[i];
+        }
+    }
+
+    // Timed out, or failed to poll, in which case receiving on the oldest command reports the
+    // error, if any.
+    *timedOut = (numReady == 0);
+    return 0;
+}
+
+DBClientMultiCommand::PendingQueue::iterator DBClientMultiCommand::_nextReadyCommand(
+    bool* timedOut) {
+    std::vector<ReadyCheck> commands;
+    commands.reserve(_pendingCommands.size());
+    double soTimeoutSecs = 0;
+    for (PendingCommand* command : _pendingCommands) {
+        ReadyCheck check{command->endpoint, command->status.isOK() && command->conn, -1};
+        if (check.sent) {
+            DBClientBase* const actualConn = _getActualConn(command);
+            if (commands.empty()) {
+                // Wait no longer than the oldest command's connection would wait to read its
+                // response.
+                soTimeoutSecs = actualConn->getSoTimeout();
+            }
+
+            // Each connection only has one command outstanding, so no part of its response can
+            // have been read ahead into a buffer, and polling its socket tells whether the
+            // response has arrived.
+            DBClientConnection* const conn = dynamic_cast<DBClientConnection*>(actualConn);
+            check.fd = conn ? conn->port().rawFD() : -1;
+        }
+        commands.push_back(check);
+    }
+
+    const int timeoutMillis = soTimeoutSecs > 0 ? static_cast<int>(soTimeoutSecs * 1000) : -1;
+    return _pendingCommands.begin() + chooseReadyCommand(commands, timeoutMillis, timedOut);
+}
+
 Status DBClientMultiCommand::recvAny(ConnectionString* endpoint, BSONSerializable* response) {
-    unique_ptr<PendingCommand> command(_pendingCommands.front());
-    _pendingCommands.pop_front();
+    bool timedOut = false;
+    auto readyIt = _nextReadyCommand(&timedOut);
+    unique_ptr<PendingCommand> command(*readyIt);
+    _pendingCommands.erase(readyIt);
 
     *endpoint = command->endpoint;
     if (!command->status.isOK())
@@ -188,13 +275,21 @@ Status DBClientMultiCommand::recvAny(ConnectionString* endpoint, BSONSerializabl
 
     dassert(command->conn);
 
+    if (timedOut) {
+        // Waiting on the connection again would double the timeout. The response may still turn
+        // up later, so the connection cannot be reused either.
+        command->conn->kill();
+        return Status(ErrorCodes::NetworkTimeout,
+                      str::stream() << "timed out waiting for a write command response from "
+                                    << endpoint->toString());
+    }
+
     try {
         // Holds the data and BSONObj for the command result
         Message toRecv;
         BSONObj result;
 
-        DBClientBase* const actualConn =
-            (!_isConfig ? command->conn->get() : command->conn->getRawConn());
+        DBClientBase* const actualConn = _getActualConn(command.get());
 
         recvAsCmd(actualConn, &toRecv, &result);
         command->conn->done();
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <deque>
+#include <vector>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/s/client/multi_command_dispatch.h"
@@ -63,6 +64,35 @@ public:
 
     Status recvAny(ConnectionString* endpoint, BSONSerializable* response) override;
 
+    /**
+     * Describes a pending command to chooseReadyCommand().
+     */
+    struct ReadyCheck {
+        ConnectionString endpoint;
+
+        // False if the command failed to send, in which case its error can be reported right away.
+        bool sent;
+
+        // The socket the command's response will arrive on, or -1 if there is none to poll.
+        int fd;
+    };
+
+    /**
+     * Chooses the command whose response recvAny() should receive next among 'commands', which
+     * are ordered oldest first and must not be empty. Only the oldest command for each endpoint is
+     * considered, so that responses from an endpoint come back in the order their commands were
+     * sent. A command which failed to send is chosen without waiting. Otherwise waits up to
+     * 'timeoutMillis', or indefinitely if it is negative, for one of the responses to arrive.
+     *
+     * Chooses the oldest command if there is no way to tell which response arrives first, or if
+     * none arrived in time, in which case '*timedOut' is set.
+     *
+     * Exposed for testing.
+     */
+    static size_t chooseReadyCommand(const std::vector<ReadyCheck>& commands,
+                                     int timeoutMillis,
+                                     bool* timedOut);
+
 private:
     // All info associated with an pre- or in-flight command
     struct PendingCommand {
@@ -83,6 +113,19 @@ private:
 
     typedef std::deque<PendingCommand*> PendingQueue;
 
+    /**
+     * Returns the connection the command was sent on.
+     */
+    DBClientBase* _getActualConn(PendingCommand* command) const;
+
+    /**
+     * Waits until the response to one of the pending commands can be received without blocking,
+     * or that command failed to send, and returns it. Sets '*timedOut' if the returned command's
+     * response did not arrive within its connection's socket timeout. Must only be called with
+     * commands pending.
+     */
+    PendingQueue::iterator _nextReadyCommand(bool* timedOut);
+
     const bool _isConfig;
 
     PendingQueue _pendingCommands;
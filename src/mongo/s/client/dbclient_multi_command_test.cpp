@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/client/dbclient_multi_command.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <vector>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/net/hostandport.h"
+
+namespace mongo {
+namespace {
+
+#ifndef _WIN32
+
+using ReadyCheck = DBClientMultiCommand::ReadyCheck;
+
+const ConnectionString kHostA(HostAndPort("hostA", 27017));
+const ConnectionString kHostB(HostAndPort("hostB", 27017));
+
+/**
+ * A connected pair of sockets, standing in for a connection to a shard host. Writing to the
+ * shard's end makes a response arrive on the client's end.
+ */
+class FakeConnection {
+public:
+    FakeConnection() {
+        ASSERT_EQUALS(0, ::socketpair(PF_UNIX, SOCK_STREAM, 0, _fds));
+    }
+
+    ~FakeConnection() {
+        ::close(_fds[0]);
+        ::close(_fds[1]);
+    }
+
+    int clientFD() const {
+        return _fds[0];
+    }
+
+    void respond() {
+        const char byte = 0;
+        ASSERT_EQUALS(1, ::write(_fds[1], &byte, 1));
+    }
+
+private:
+    int _fds[2];
+};
+
+TEST(DBClientMultiCommandTest, ChoosesHostWhoseResponseArrivedFirst) {
+    FakeConnection slow;
+    FakeConnection fast;
+    fast.respond();
+
+    bool timedOut = true;
+    std::vector<ReadyCheck> commands{{kHostA, true, slow.clientFD()},
+                                     {kHostB, true, fast.clientFD()}};
+    ASSERT_EQUALS(1U, DBClientMultiCommand::chooseReadyCommand(commands, -1, &timedOut));
+    ASSERT_FALSE(timedOut);
+}
+
+TEST(DBClientMultiCommandTest, ChoosesOnlyOldestCommandForEachHost) {
+    FakeConnection first;
+    FakeConnection second;
+    second.respond();
+
+    // The second response to host A must not be taken before the first.
+    bool timedOut = false;
+    std::vector<ReadyCheck> commands{{kHostA, true, first.clientFD()},
+                                     {kHostA, true, second.clientFD()}};
+    ASSERT_EQUALS(0U, DBClientMultiCommand::chooseReadyCommand(commands, 10, &timedOut));
+    ASSERT_TRUE(timedOut);
+
+    first.respond();
+    ASSERT_EQUALS(0U, DBClientMultiCommand::chooseReadyCommand(commands, -1, &timedOut));
+    ASSERT_FALSE(timedOut);
+}
+
+TEST(DBClientMultiCommandTest, ChoosesCommandWhichFailedToSendWithoutWaiting) {
+    FakeConnection slow;
+
+    bool timedOut = true;
+    std::vector<ReadyCheck> commands{{kHostA, true, slow.clientFD()}, {kHostB, false, -1}};
+    ASSERT_EQUALS(1U, DBClientMultiCommand::chooseReadyCommand(commands, -1, &timedOut));
+    ASSERT_FALSE(timedOut);
+}
+
+TEST(DBClientMultiCommandTest, ChoosesOldestCommandWhenSomeCannotBePolled) {
+    FakeConnection fast;
+    fast.respond();
+
+    bool timedOut = true;
+    std::vector<ReadyCheck> commands{{kHostA, true, -1}, {kHostB, true, fast.clientFD()}};
+    ASSERT_EQUALS(0U, DBClientMultiCommand::chooseReadyCommand(commands, -1, &timedOut));
+    ASSERT_FALSE(timedOut);
+}
+
+TEST(DBClientMultiCommandTest, ReportsTimeoutWhenNoResponseArrives) {
+    FakeConnection slowA;
+    FakeConnection slowB;
+
+    bool timedOut = false;
+    std::vector<ReadyCheck> commands{{kHostA, true, slowA.clientFD()},
+                                     {kHostB, true, slowB.clientFD()}};
+    ASSERT_EQUALS(0U, DBClientMultiCommand::chooseReadyCommand(commands, 10, &timedOut));
+    ASSERT_TRUE(timedOut);
+}
+
+#endif
+
+}  // namespace
+}  // namespace mongo
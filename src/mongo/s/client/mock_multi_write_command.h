@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <deque>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/s/client/multi_command_dispatch.h"
@@ -86,6 +88,9 @@ struct MockWriteResult {
  *
  * If an endpoint isn't registered with a MockEndpoint, just returns BatchedCommandResponses
  * with ok : true.
+ *
+ * An endpoint may be marked slow, in which case its responses are only returned once no other
+ * endpoint has a response pending, as if it took longer to respond than all the others.
  */
 class MockMultiWriteCommand : public MultiCommandDispatch {
 public:
@@ -101,6 +106,10 @@ public:
         _pending.push_back(endpoint);
     }
 
+    void setSlowEndpoint(const ConnectionString& endpoint) {
+        _slowEndpoint = endpoint;
+    }
+
     void sendAll() override {
         // No-op
     }
@@ -117,9 +126,21 @@ public:
         BatchedCommandResponse* batchResponse =  //
             static_cast<BatchedCommandResponse*>(response);
 
-        *endpoint = _pending.front();
-        MockWriteResult* mockResponse = releaseByHost(_pending.front());
-        _pending.pop_front();
+        // Responses from the same endpoint are returned in order, so the oldest pending command
+        // of any endpoint but the slow one may be returned.
+        auto next = std::find_if(_pending.begin(),
+                                 _pending.end(),
+                                 [this](const ConnectionString& pending) {
+                                     return !(pending == _slowEndpoint);
+                                 });
+        if (next == _pending.end()) {
+            next = _pending.begin();
+        }
+
+        *endpoint = *next;
+        MockWriteResult* mockResponse = releaseByHost(*next);
+        _pending.erase(next);
+        _received.push_back(*endpoint);
 
         if (NULL == mockResponse) {
             batchResponse->setOk(true);
@@ -137,6 +158,13 @@ public:
         return _mockEndpoints.vector();
     }
 
+    /**
+     * Endpoints of the responses returned so far, in the order they were returned.
+     */
+    const std::vector<ConnectionString>& getReceived() const {
+        return _received;
+    }
+
 private:
     // Find a MockEndpoint* by host, and release it so we don't see it again
     MockWriteResult* releaseByHost(const ConnectionString& endpoint) {
@@ -158,6 +186,9 @@ private:
     OwnedPointerVector<MockWriteResult> _mockEndpoints;
 
     std::deque<ConnectionString> _pending;
+    std::vector<ConnectionString> _received;
+
+    ConnectionString _slowEndpoint;
 };
 
 }  // namespace mongo
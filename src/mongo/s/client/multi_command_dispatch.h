@@ -52,15 +52,16 @@ public:
      * Adds a command to this multi-command dispatch.  Commands are registered with a
      * ConnectionString endpoint and a BSON request object.
      *
-     * Commands are not sent immediately, they are sent on sendAll.
+     * Commands are not sent immediately, they are sent on sendAll.  Commands may be added while
+     * earlier ones are still awaiting responses.
      */
     virtual void addCommand(const ConnectionString& endpoint,
                             StringData dbName,
                             const BSONObj& request) = 0;
 
     /**
-     * Sends all the commands in this dispatch to their endpoints, in undefined order and
-     * without waiting for responses.  May block on full send queue (though this should be
+     * Sends all the commands added since the last sendAll to their endpoints, in undefined order
+     * and without waiting for responses.  May block on full send queue (though this should be
      * rare).
      *
      * Any error which occurs during sendAll will be reported on recvAny, *does not throw.*
@@ -74,7 +75,8 @@ public:
 
     /**
      * Blocks until a command response has come back.  Any outstanding command response may be
-     * returned with associated endpoint.
+     * returned with associated endpoint, but responses from the same endpoint are returned in
+     * the order their commands were sent.
      *
      * Returns !OK on send/recv/parse failure, otherwise command-level errors are returned in
      * the response object itself.
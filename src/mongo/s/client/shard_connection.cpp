@@ -137,12 +137,18 @@ class ClientConnections {
 
 public:
     struct Status {
-        Status() : created(0), avail(0) {}
+        Status() : created(0), avail(0), checkedOut(0), extraCheckedOut(0) {}
 
         // May be read concurrently, but only written from
         // this thread.
         long long created;
         DBClientBase* avail;
+
+        // Only used from this thread. The number of connections to the host which this thread has
+        // checked out, and how many of them were checked out while others already were. Each of
+        // the latter may find 'avail' taken when it is returned, which is then expected.
+        int checkedOut;
+        int extraCheckedOut;
     };
 
     // Gets or creates the status object for the host
@@ -226,6 +232,12 @@ public:
             s->created++;
         }
 
+        // A thread may deliberately keep several connections to the same host checked out, for
+        // instance to have several write batches in flight to it.
+        if (s->checkedOut++ > 0) {
+            s->extraCheckedOut++;
+        }
+
         return c.release();
     }
 
@@ -236,14 +248,19 @@ public:
         const bool isConnGood = shardConnectionPool.isConnectionGood(addr, conn);
 
         if (s->avail != NULL) {
-            warning() << "Detected additional sharded connection in the "
-                      << "thread local pool for " << addr;
+            if (s->extraCheckedOut > 0) {
+                s->extraCheckedOut--;
+            } else {
+                warning() << "Detected additional sharded connection in the "
+                          << "thread local pool for " << addr;
 
-            if (DBException::traceExceptions) {
-                // There shouldn't be more than one connection checked out to the same
-                // host on the same thread.
-                printStackTrace();
+                if (DBException::traceExceptions) {
+                    // There shouldn't be more than one connection checked out to the same
+                    // host on the same thread, other than the ones counted above.
+                    printStackTrace();
+                }
             }
+            _checkedIn(s);
 
             if (!isConnGood) {
                 delete s->avail;
@@ -257,6 +274,8 @@ public:
             return;
         }
 
+        _checkedIn(s);
+
         if (!isConnGood) {
             // Let the internal pool handle the bad connection.
             release(addr, conn);
@@ -271,6 +290,17 @@ public:
         s->avail = conn;
     }
 
+    /**
+     * Accounts for a connection checked out from this pool which was destroyed rather than
+     * returned through done().
+     */
+    void discarded(const string& addr) {
+        auto it = _hosts.find(addr);
+        if (it != _hosts.end()) {
+            _checkedIn(it->second);
+        }
+    }
+
     void checkVersions(OperationContext* txn, const string& ns) {
         vector<ShardId> all;
         grid.shardRegistry()->getAllShardIds(&all);
@@ -311,6 +341,14 @@ public:
         shardConnectionPool.release(addr, conn);
     }
 
+    void _checkedIn(Status* s) {
+        if (s->checkedOut > 0 && --s->checkedOut == 0) {
+            // Start afresh whenever the thread holds no connection to the host, so that the
+            // counts cannot drift.
+            s->extraCheckedOut = 0;
+        }
+    }
+
     /**
      * Appends info about the client connection pool to a BOBuilder
      * Safe to call with activeClientConnections lock
@@ -474,6 +512,7 @@ void ShardConnection::kill() {
             // Let the pool know about the bad connection and also delegate disposal to it.
             ClientConnections::threadInstance()->done(_cs.toString(), _conn);
         } else {
+            ClientConnections::threadInstance()->discarded(_cs.toString());
             delete _conn;
         }
 
@@ -167,6 +167,27 @@ TEST_F(ShardConnFixture, BasicShardConnection) {
     conn3.done();
 }
 
+TEST_F(ShardConnFixture, SeveralConnsToSameHostAreNotReportedAsLeaked) {
+    startCapturingLogMessages();
+    {
+        ShardConnection conn1(ConnectionString(HostAndPort(TARGET_HOST)), "test.user");
+        ShardConnection conn2(ConnectionString(HostAndPort(TARGET_HOST)), "test.user");
+        ShardConnection conn3(ConnectionString(HostAndPort(TARGET_HOST)), "test.user");
+        conn2.done();
+        conn1.done();
+        conn3.done();
+    }
+    {
+        ShardConnection conn1(ConnectionString(HostAndPort(TARGET_HOST)), "test.user");
+        ShardConnection conn2(ConnectionString(HostAndPort(TARGET_HOST)), "test.user");
+        conn1.kill();
+        conn2.done();
+    }
+    stopCapturingLogMessages();
+
+    ASSERT_EQUALS(0, countLogLinesContaining("Detected additional sharded connection"));
+}
+
 TEST_F(ShardConnFixture, InvalidateBadConnInPool) {
     ShardConnection conn1(ConnectionString(HostAndPort(TARGET_HOST)), "test.user");
     ShardConnection conn2(ConnectionString(HostAndPort(TARGET_HOST)), "test.user");
@@ -83,6 +83,7 @@
 #include "mongo/s/version_mongos.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/transport/transport_layer_asio.h"
 #include "mongo/transport/transport_layer_legacy.h"
 #include "mongo/util/admin_access.h"
 #include "mongo/util/cmdline_utils/censor_cmdline.h"
@@ -233,18 +234,33 @@ static ExitCode runMongosServer() {
 
     _initWireSpec();
 
-    transport::TransportLayerLegacy::Options opts;
-    opts.port = serverGlobalParams.port;
-    opts.ipList = serverGlobalParams.bind_ip;
-
     auto sep =
         stdx::make_unique<ServiceEntryPointMongos>(getGlobalServiceContext()->getTransportLayer());
     auto sepPtr = sep.get();
 
     getGlobalServiceContext()->setServiceEntryPoint(std::move(sep));
 
-    auto transportLayer = stdx::make_unique<transport::TransportLayerLegacy>(opts, sepPtr);
-    auto res = transportLayer->setup();
+    std::unique_ptr<transport::TransportLayer> transportLayer;
+    Status res = Status::OK();
+    if (serverGlobalParams.transportLayer == "asio") {
+        transport::TransportLayerASIO::Options opts;
+        opts.port = serverGlobalParams.port;
+        opts.ipList = serverGlobalParams.bind_ip;
+        opts.threadCount = serverGlobalParams.transportLayerThreads;
+
+        auto asioTransportLayer = stdx::make_unique<transport::TransportLayerASIO>(opts, sepPtr);
+        res = asioTransportLayer->setup();
+        transportLayer = std::move(asioTransportLayer);
+    } else {
+        transport::TransportLayerLegacy::Options opts;
+        opts.port = serverGlobalParams.port;
+        opts.ipList = serverGlobalParams.bind_ip;
+
+        auto legacyTransportLayer =
+            stdx::make_unique<transport::TransportLayerLegacy>(opts, sepPtr);
+        res = legacyTransportLayer->setup();
+        transportLayer = std::move(legacyTransportLayer);
+    }
     if (!res.isOK()) {
         return EXIT_NET_ERROR;
     }
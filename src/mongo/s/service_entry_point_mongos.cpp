@@ -74,6 +74,18 @@ using transport::TransportLayer;
 ServiceEntryPointMongos::ServiceEntryPointMongos(TransportLayer* tl) : _tl(tl) {}
 
 void ServiceEntryPointMongos::startSession(transport::SessionHandle session) {
+    if (serverGlobalParams.transportLayer == "asio") {
+        // The session shares the TransportLayer's worker threads, each request running as a task.
+        launchServiceEntryTaskChain(
+            std::move(session), [this](const transport::SessionHandle& session, Message* message) {
+                // Release any cached egress connections for client back to pool
+                auto guard = MakeGuard(ShardConnection::releaseMyConnections);
+                _handleMessage(session, message);
+                return false;
+            });
+        return;
+    }
+
     launchWrappedServiceEntryWorkerThread(
         std::move(session),
         [this](const transport::SessionHandle& session) { _sessionLoop(session); });
@@ -106,42 +118,47 @@ void ServiceEntryPointMongos::_sessionLoop(const transport::SessionHandle& sessi
             uassertStatusOK(status);
         }
 
-        // 2. Build a sharding request
-        Request r(message);
-        auto txn = cc().makeOperationContext();
-
-        try {
-            r.init(txn.get());
-            r.process(txn.get());
-        } catch (const AssertionException& ex) {
-            LOG(ex.isUserAssertion() ? 1 : 0) << "Assertion failed"
-                                              << " while processing "
-                                              << networkOpToString(message.operation()) << " op"
-                                              << " for " << r.getnsIfPresent() << causedBy(ex);
-            if (r.expectResponse()) {
-                message.header().setId(r.id());
-                replyToQuery(ResultFlag_ErrSet, session, message, buildErrReply(ex));
-            }
-
-            // We *always* populate the last error for now
-            LastError::get(cc()).setLastError(ex.getCode(), ex.what());
-        } catch (const DBException& ex) {
-            log() << "Exception thrown"
-                  << " while processing " << networkOpToString(message.operation()) << " op"
-                  << " for " << r.getnsIfPresent() << causedBy(ex);
+        _handleMessage(session, &message);
 
-            if (r.expectResponse()) {
-                message.header().setId(r.id());
-                replyToQuery(ResultFlag_ErrSet, session, message, buildErrReply(ex));
-            }
+        if ((counter++ & 0xf) == 0) {
+            markThreadIdle();
+        }
+    }
+}
 
-            // We *always* populate the last error for now
-            LastError::get(cc()).setLastError(ex.getCode(), ex.what());
+void ServiceEntryPointMongos::_handleMessage(const transport::SessionHandle& session,
+                                             Message* message) {
+    // 2. Build a sharding request
+    Request r(*message);
+    auto txn = cc().makeOperationContext();
+
+    try {
+        r.init(txn.get());
+        r.process(txn.get());
+    } catch (const AssertionException& ex) {
+        LOG(ex.isUserAssertion() ? 1 : 0) << "Assertion failed"
+                                          << " while processing "
+                                          << networkOpToString(message->operation()) << " op"
+                                          << " for " << r.getnsIfPresent() << causedBy(ex);
+        if (r.expectResponse()) {
+            message->header().setId(r.id());
+            replyToQuery(ResultFlag_ErrSet, session, *message, buildErrReply(ex));
         }
 
-        if ((counter++ & 0xf) == 0) {
-            markThreadIdle();
+        // We *always* populate the last error for now
+        LastError::get(cc()).setLastError(ex.getCode(), ex.what());
+    } catch (const DBException& ex) {
+        log() << "Exception thrown"
+              << " while processing " << networkOpToString(message->operation()) << " op"
+              << " for " << r.getnsIfPresent() << causedBy(ex);
+
+        if (r.expectResponse()) {
+            message->header().setId(r.id());
+            replyToQuery(ResultFlag_ErrSet, session, *message, buildErrReply(ex));
         }
+
+        // We *always* populate the last error for now
+        LastError::get(cc()).setLastError(ex.getCode(), ex.what());
     }
 }
 
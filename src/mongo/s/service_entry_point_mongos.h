@@ -35,6 +35,8 @@
 
 namespace mongo {
 
+class Message;
+
 namespace transport {
 class Session;
 class TransportLayer;
@@ -42,7 +44,8 @@ class TransportLayer;
 
 /**
  * The entry point from the TransportLayer into Mongos. startSession() spawns and
- * detaches a new thread for each incoming connection (transport::Session).
+ * detaches a new thread for each incoming connection (transport::Session), unless the asio
+ * transport layer is in use, in which case each request runs as a task on its worker threads.
  */
 class ServiceEntryPointMongos final : public ServiceEntryPoint {
     MONGO_DISALLOW_COPYING(ServiceEntryPointMongos);
@@ -57,6 +60,11 @@ public:
 private:
     void _sessionLoop(const transport::SessionHandle& session);
 
+    /**
+     * Runs one sourced Message, replying to the client as the request requires.
+     */
+    void _handleMessage(const transport::SessionHandle& session, Message* message);
+
     transport::TransportLayer* _tl;
 };
 
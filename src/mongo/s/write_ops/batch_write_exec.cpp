@@ -32,12 +32,17 @@
 
 #include "mongo/s/write_ops/batch_write_exec.h"
 
+#include <deque>
+#include <map>
+#include <memory>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/owned_pointer_map.h"
 #include "mongo/base/status.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/client/connection_string.h"
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/client/multi_command_dispatch.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
@@ -51,6 +56,8 @@ using std::make_pair;
 using std::stringstream;
 using std::vector;
 
+MONGO_EXPORT_SERVER_PARAMETER(batchWriteMaxChildBatchesInFlightPerShard, int, 0);
+
 BatchWriteExec::BatchWriteExec(NSTargeter* targeter, MultiCommandDispatch* dispatcher)
     : _targeter(targeter), _dispatcher(dispatcher) {}
 
@@ -80,10 +87,115 @@ static void noteStaleResponses(const vector<ShardError*>& staleErrors, NSTargete
     }
 }
 
+// Figures out what host we need to dispatch a targeted batch to
+static StatusWith<ConnectionString> resolveShardHost(OperationContext* txn,
+                                                     const ShardEndpoint& endpoint) {
+    auto shardStatus = Grid::get(txn)->shardRegistry()->getShard(txn, endpoint.shardName);
+    if (!shardStatus.isOK()) {
+        return shardStatus.getStatus();
+    }
+
+    const ReadPreferenceSetting readPref(ReadPreference::PrimaryOnly, TagSet());
+    auto swHostAndPort = shardStatus.getValue()->getTargeter()->findHostNoWait(readPref);
+    if (!swHostAndPort.isOK()) {
+        return swHostAndPort.getStatus();
+    }
+
+    return ConnectionString(std::move(swHostAndPort.getValue()));
+}
+
+// Builds the child request for a targeted batch and adds it to the dispatcher
+static void addChildBatch(const BatchedCommandRequest& clientRequest,
+                          const BatchWriteOp& batchOp,
+                          const TargetedWriteBatch& batch,
+                          const ConnectionString& shardHost,
+                          MultiCommandDispatch* dispatcher) {
+    BatchedCommandRequest request(clientRequest.getBatchType());
+    batchOp.buildBatchRequest(batch, &request);
+
+    // Internally we use full namespaces for request/response, but we send the
+    // command to a database with the collection name in the request.
+    NamespaceString nss(request.getNS());
+    request.setNS(nss);
+
+    LOG(4) << "sending write batch to " << shardHost.toString() << ": "
+           << redact(request.toString());
+
+    dispatcher->addCommand(shardHost, nss.db(), request.toBSON());
+}
+
+// Notes the response (or dispatch error) for a child batch. Returns true if any of the writes in
+// the batch failed because the shard's metadata did not match ours.
+static bool noteChildResponse(const ConnectionString& shardHost,
+                              const TargetedWriteBatch& batch,
+                              const Status& dispatchStatus,
+                              const BatchedCommandResponse& response,
+                              NSTargeter* targeter,
+                              BatchWriteOp* batchOp,
+                              BatchWriteExecStats* stats) {
+    if (!dispatchStatus.isOK()) {
+        // Error occurred dispatching, note it
+
+        stringstream msg;
+        msg << "write results unavailable from " << shardHost.toString()
+            << causedBy(dispatchStatus.toString());
+
+        WriteErrorDetail error;
+        buildErrorFrom(Status(ErrorCodes::RemoteResultsUnavailable, msg.str()), &error);
+
+        LOG(4) << "unable to receive write results from " << shardHost.toString()
+               << causedBy(redact(dispatchStatus.toString()));
+
+        batchOp->noteBatchError(batch, error);
+        return false;
+    }
+
+    TrackedErrors trackedErrors;
+    trackedErrors.startTracking(ErrorCodes::StaleShardVersion);
+
+    LOG(4) << "write results received from " << shardHost.toString() << ": "
+           << redact(response.toString());
+
+    // Dispatch was ok, note response
+    batchOp->noteBatchResponse(batch, response, &trackedErrors);
+
+    // Note if anything was stale
+    const vector<ShardError*>& staleErrors = trackedErrors.getErrors(ErrorCodes::StaleShardVersion);
+
+    if (staleErrors.size() > 0) {
+        noteStaleResponses(staleErrors, targeter);
+        ++stats->numStaleBatches;
+    }
+
+    // Remember that we successfully wrote to this shard
+    // NOTE: This will record lastOps for shards where we actually didn't update
+    // or delete any documents, which preserves old behavior but is conservative
+    stats->noteWriteAt(shardHost,
+                       response.isLastOpSet() ? response.getLastOp() : repl::OpTime(),
+                       response.isElectionIdSet() ? response.getElectionId() : OID());
+
+    return staleErrors.size() > 0;
+}
+
 // The number of times we'll try to continue a batch op if no progress is being made
 // This only applies when no writes are occurring and metadata is not changing on reload
 static const int kMaxRoundsWithoutProgress(5);
 
+// Aborts a batch which has stopped making progress. There must be no outstanding child batches.
+static void abortWithoutProgress(const BatchedCommandRequest& clientRequest,
+                                 int numCompletedOps,
+                                 int rounds,
+                                 BatchWriteOp* batchOp) {
+    stringstream msg;
+    msg << "no progress was made executing batch write op in " << clientRequest.getNS().ns()
+        << " after " << kMaxRoundsWithoutProgress << " rounds (" << numCompletedOps
+        << " ops completed in " << rounds << " rounds total)";
+
+    WriteErrorDetail error;
+    buildErrorFrom(Status(ErrorCodes::NoProgressMade, msg.str()), &error);
+    batchOp->abortBatch(error);
+}
+
 void BatchWriteExec::executeBatch(OperationContext* txn,
                                   const BatchedCommandRequest& clientRequest,
                                   BatchedCommandResponse* clientResponse,
@@ -94,13 +206,37 @@ void BatchWriteExec::executeBatch(OperationContext* txn,
     BatchWriteOp batchOp;
     batchOp.initClientRequest(&clientRequest);
 
+    // Ordered batches must see each round's results before they can target the next write, so
+    // only unordered batches can be pipelined.
+    const int maxInFlightPerHost = batchWriteMaxChildBatchesInFlightPerShard.load();
+    if (!clientRequest.getOrdered() && maxInFlightPerHost > 0) {
+        _executePipelined(txn, clientRequest, maxInFlightPerHost, &batchOp, stats);
+    } else {
+        _executeInRounds(txn, clientRequest, &batchOp, stats);
+    }
+
+    batchOp.buildClientResponse(clientResponse);
+
+    LOG(4) << "finished execution of write batch"
+           << (clientResponse->isErrDetailsSet() ? " with write errors" : "")
+           << (clientResponse->isErrDetailsSet() && clientResponse->isWriteConcernErrorSet()
+                   ? " and"
+                   : "")
+           << (clientResponse->isWriteConcernErrorSet() ? " with write concern error" : "")
+           << " for " << clientRequest.getNS();
+}
+
+void BatchWriteExec::_executeInRounds(OperationContext* txn,
+                                      const BatchedCommandRequest& clientRequest,
+                                      BatchWriteOp* batchOp,
+                                      BatchWriteExecStats* stats) {
     // Current batch status
     bool refreshedTargeter = false;
     int rounds = 0;
     int numCompletedOps = 0;
     int numRoundsWithoutProgress = 0;
 
-    while (!batchOp.isFinished()) {
+    while (!batchOp->isFinished()) {
         //
         // Get child batches to send using the targeter
         //
@@ -132,7 +268,7 @@ void BatchWriteExec::executeBatch(OperationContext* txn,
         // record target errors definitively.
         bool recordTargetErrors = refreshedTargeter;
         Status targetStatus =
-            batchOp.targetBatch(txn, *_targeter, recordTargetErrors, &childBatches);
+            batchOp->targetBatch(txn, *_targeter, recordTargetErrors, &childBatches);
         if (!targetStatus.isOK()) {
             // Don't do anything until a targeter refresh
             _targeter->noteCouldNotTarget();
@@ -170,42 +306,22 @@ void BatchWriteExec::executeBatch(OperationContext* txn,
                     continue;
 
                 // Figure out what host we need to dispatch our targeted batch
-                const ReadPreferenceSetting readPref(ReadPreference::PrimaryOnly, TagSet());
-                auto shardStatus = Grid::get(txn)->shardRegistry()->getShard(
-                    txn, nextBatch->getEndpoint().shardName);
+                auto swShardHost = resolveShardHost(txn, nextBatch->getEndpoint());
 
                 bool resolvedHost = false;
                 ConnectionString shardHost;
-                if (!shardStatus.isOK()) {
-                    Status status(std::move(shardStatus.getStatus()));
-
+                if (!swShardHost.isOK()) {
                     // Record a resolve failure
                     // TODO: It may be necessary to refresh the cache if stale, or maybe just
                     // cancel and retarget the batch
                     WriteErrorDetail error;
-                    buildErrorFrom(status, &error);
+                    buildErrorFrom(swShardHost.getStatus(), &error);
                     LOG(4) << "unable to send write batch to " << nextBatch->getEndpoint().shardName
-                           << causedBy(status);
-                    batchOp.noteBatchError(*nextBatch, error);
+                           << causedBy(swShardHost.getStatus());
+                    batchOp->noteBatchError(*nextBatch, error);
                 } else {
-                    auto shard = shardStatus.getValue();
-
-                    auto swHostAndPort = shard->getTargeter()->findHostNoWait(readPref);
-                    if (!swHostAndPort.isOK()) {
-
-                        // Record a resolve failure
-                        // TODO: It may be necessary to refresh the cache if stale, or maybe just
-                        // cancel and retarget the batch
-                        WriteErrorDetail error;
-                        buildErrorFrom(swHostAndPort.getStatus(), &error);
-                        LOG(4) << "unable to send write batch to "
-                               << nextBatch->getEndpoint().shardName
-                               << causedBy(swHostAndPort.getStatus());
-                        batchOp.noteBatchError(*nextBatch, error);
-                    } else {
-                        shardHost = ConnectionString(std::move(swHostAndPort.getValue()));
-                        resolvedHost = true;
-                    }
+                    shardHost = std::move(swShardHost.getValue());
+                    resolvedHost = true;
                 }
 
                 if (!resolvedHost) {
@@ -228,18 +344,7 @@ void BatchWriteExec::executeBatch(OperationContext* txn,
                 // We now have all the info needed to dispatch the batch
                 //
 
-                BatchedCommandRequest request(clientRequest.getBatchType());
-                batchOp.buildBatchRequest(*nextBatch, &request);
-
-                // Internally we use full namespaces for request/response, but we send the
-                // command to a database with the collection name in the request.
-                NamespaceString nss(request.getNS());
-                request.setNS(nss);
-
-                LOG(4) << "sending write batch to " << shardHost.toString() << ": "
-                       << redact(request.toString());
-
-                _dispatcher->addCommand(shardHost, nss.db(), request.toBSON());
+                addChildBatch(clientRequest, *batchOp, *nextBatch, shardHost, _dispatcher);
 
                 // Indicate we're done by setting the batch to NULL
                 // We'll only get duplicate hostEndpoints if we have broadcast and non-broadcast
@@ -269,47 +374,8 @@ void BatchWriteExec::executeBatch(OperationContext* txn,
                 dassert(pendingBatches.find(shardHost) != pendingBatches.end());
                 TargetedWriteBatch* batch = pendingBatches.find(shardHost)->second;
 
-                if (dispatchStatus.isOK()) {
-                    TrackedErrors trackedErrors;
-                    trackedErrors.startTracking(ErrorCodes::StaleShardVersion);
-
-                    LOG(4) << "write results received from " << shardHost.toString() << ": "
-                           << redact(response.toString());
-
-                    // Dispatch was ok, note response
-                    batchOp.noteBatchResponse(*batch, response, &trackedErrors);
-
-                    // Note if anything was stale
-                    const vector<ShardError*>& staleErrors =
-                        trackedErrors.getErrors(ErrorCodes::StaleShardVersion);
-
-                    if (staleErrors.size() > 0) {
-                        noteStaleResponses(staleErrors, _targeter);
-                        ++stats->numStaleBatches;
-                    }
-
-                    // Remember that we successfully wrote to this shard
-                    // NOTE: This will record lastOps for shards where we actually didn't update
-                    // or delete any documents, which preserves old behavior but is conservative
-                    stats->noteWriteAt(
-                        shardHost,
-                        response.isLastOpSet() ? response.getLastOp() : repl::OpTime(),
-                        response.isElectionIdSet() ? response.getElectionId() : OID());
-                } else {
-                    // Error occurred dispatching, note it
-
-                    stringstream msg;
-                    msg << "write results unavailable from " << shardHost.toString()
-                        << causedBy(dispatchStatus.toString());
-
-                    WriteErrorDetail error;
-                    buildErrorFrom(Status(ErrorCodes::RemoteResultsUnavailable, msg.str()), &error);
-
-                    LOG(4) << "unable to receive write results from " << shardHost.toString()
-                           << causedBy(redact(dispatchStatus.toString()));
-
-                    batchOp.noteBatchError(*batch, error);
-                }
+                noteChildResponse(
+                    shardHost, *batch, dispatchStatus, response, _targeter, batchOp, stats);
             }
         }
 
@@ -317,7 +383,7 @@ void BatchWriteExec::executeBatch(OperationContext* txn,
         ++stats->numRounds;
 
         // If we're done, get out
-        if (batchOp.isFinished())
+        if (batchOp->isFinished())
             break;
 
         // MORE WORK TO DO
@@ -339,7 +405,7 @@ void BatchWriteExec::executeBatch(OperationContext* txn,
         // Ensure progress is being made toward completing the batch op
         //
 
-        int currCompletedOps = batchOp.numWriteOpsIn(WriteOpState_Completed);
+        int currCompletedOps = batchOp->numWriteOpsIn(WriteOpState_Completed);
         if (currCompletedOps == numCompletedOps && !targeterChanged) {
             ++numRoundsWithoutProgress;
         } else {
@@ -348,27 +414,184 @@ void BatchWriteExec::executeBatch(OperationContext* txn,
         numCompletedOps = currCompletedOps;
 
         if (numRoundsWithoutProgress > kMaxRoundsWithoutProgress) {
-            stringstream msg;
-            msg << "no progress was made executing batch write op in " << clientRequest.getNS().ns()
-                << " after " << kMaxRoundsWithoutProgress << " rounds (" << numCompletedOps
-                << " ops completed in " << rounds << " rounds total)";
-
-            WriteErrorDetail error;
-            buildErrorFrom(Status(ErrorCodes::NoProgressMade, msg.str()), &error);
-            batchOp.abortBatch(error);
+            abortWithoutProgress(clientRequest, numCompletedOps, rounds, batchOp);
             break;
         }
     }
+}
 
-    batchOp.buildClientResponse(clientResponse);
+void BatchWriteExec::_executePipelined(OperationContext* txn,
+                                       const BatchedCommandRequest& clientRequest,
+                                       size_t maxInFlightPerHost,
+                                       BatchWriteOp* batchOp,
+                                       BatchWriteExecStats* stats) {
+    invariant(!clientRequest.getOrdered());
+    invariant(maxInFlightPerHost > 0);
+
+    // Child batches for a host, in the order they were (or will be) sent. The dispatcher returns
+    // the responses from a host in the order the requests were sent, so the oldest in-flight
+    // batch for a host is the one a response from that host belongs to.
+    struct HostBatches {
+        std::deque<std::unique_ptr<TargetedWriteBatch>> queued;
+        std::deque<std::unique_ptr<TargetedWriteBatch>> inFlight;
+    };
+    std::map<ConnectionString, HostBatches> hostBatches;
 
-    LOG(4) << "finished execution of write batch"
-           << (clientResponse->isErrDetailsSet() ? " with write errors" : "")
-           << (clientResponse->isErrDetailsSet() && clientResponse->isWriteConcernErrorSet()
-                   ? " and"
-                   : "")
-           << (clientResponse->isWriteConcernErrorSet() ? " with write concern error" : "")
-           << " for " << clientRequest.getNS();
+    bool refreshedTargeter = false;
+    bool needsRefresh = false;
+    bool giveUp = false;
+    int rounds = 0;
+    int numCompletedOps = 0;
+    int numRefreshesWithoutProgress = 0;
+
+    while (!batchOp->isFinished()) {
+        //
+        // Target ready write ops (including ones reset by stale responses), but don't get more
+        // than a pipeline's worth of child batches ahead of any host.
+        //
+
+        while (!giveUp && !needsRefresh && batchOp->numWriteOpsIn(WriteOpState_Ready) > 0) {
+            bool hostBacklogged = false;
+            for (const auto& host : hostBatches) {
+                if (host.second.queued.size() >= maxInFlightPerHost) {
+                    hostBacklogged = true;
+                    break;
+                }
+            }
+            if (hostBacklogged)
+                break;
+
+            OwnedPointerVector<TargetedWriteBatch> childBatchesOwned;
+            vector<TargetedWriteBatch*>& childBatches = childBatchesOwned.mutableVector();
+
+            // See _executeInRounds for why target errors are only recorded after a refresh
+            Status targetStatus =
+                batchOp->targetBatch(txn, *_targeter, refreshedTargeter, &childBatches);
+            if (!targetStatus.isOK()) {
+                // Don't target anything else until a targeter refresh
+                _targeter->noteCouldNotTarget();
+                refreshedTargeter = true;
+                needsRefresh = true;
+                ++stats->numTargetErrors;
+                dassert(childBatches.size() == 0u);
+                break;
+            }
+
+            if (childBatches.empty())
+                break;
+
+            for (size_t i = 0; i < childBatches.size(); ++i) {
+                std::unique_ptr<TargetedWriteBatch> batch(childBatchesOwned.releaseAt(i));
+
+                auto swShardHost = resolveShardHost(txn, batch->getEndpoint());
+                if (!swShardHost.isOK()) {
+                    // Record a resolve failure
+                    WriteErrorDetail error;
+                    buildErrorFrom(swShardHost.getStatus(), &error);
+                    LOG(4) << "unable to send write batch to " << batch->getEndpoint().shardName
+                           << causedBy(swShardHost.getStatus());
+                    batchOp->noteBatchError(*batch, error);
+                    ++stats->numResolveErrors;
+                    continue;
+                }
+
+                hostBatches[swShardHost.getValue()].queued.push_back(std::move(batch));
+            }
+        }
+
+        //
+        // Top up every host's pipeline
+        //
+
+        bool addedCommands = false;
+        for (auto& host : hostBatches) {
+            HostBatches& batches = host.second;
+            while (batches.inFlight.size() < maxInFlightPerHost && !batches.queued.empty()) {
+                addChildBatch(
+                    clientRequest, *batchOp, *batches.queued.front(), host.first, _dispatcher);
+                batches.inFlight.push_back(std::move(batches.queued.front()));
+                batches.queued.pop_front();
+                addedCommands = true;
+            }
+        }
+
+        if (addedCommands)
+            _dispatcher->sendAll();
+
+        //
+        // Receive one response, or finish the round if nothing is outstanding
+        //
+
+        if (_dispatcher->numPending() > 0) {
+            ConnectionString shardHost;
+            BatchedCommandResponse response;
+            Status dispatchStatus = _dispatcher->recvAny(&shardHost, &response);
+
+            auto hostIt = hostBatches.find(shardHost);
+            invariant(hostIt != hostBatches.end() && !hostIt->second.inFlight.empty());
+            std::unique_ptr<TargetedWriteBatch> batch =
+                std::move(hostIt->second.inFlight.front());
+            hostIt->second.inFlight.pop_front();
+
+            if (noteChildResponse(shardHost,
+                                  *batch,
+                                  dispatchStatus,
+                                  response,
+                                  _targeter,
+                                  batchOp,
+                                  stats)) {
+                // Retarget just this child's stale writes rather than waiting for the round
+                needsRefresh = true;
+            }
+        } else {
+            ++rounds;
+            ++stats->numRounds;
+
+            if (batchOp->isFinished())
+                break;
+
+            if (giveUp) {
+                abortWithoutProgress(
+                    clientRequest, batchOp->numWriteOpsIn(WriteOpState_Completed), rounds, batchOp);
+                break;
+            }
+
+            // Nothing is outstanding, yet write ops remain, so targeting must have failed.
+            // Refresh and try again; the progress check below bounds the retries.
+            needsRefresh = true;
+        }
+
+        if (!needsRefresh)
+            continue;
+
+        //
+        // Refresh the targeter and make sure the retries are making progress
+        //
+
+        needsRefresh = false;
+
+        bool targeterChanged = false;
+        Status refreshStatus = _targeter->refreshIfNeeded(txn, &targeterChanged);
+
+        if (!refreshStatus.isOK()) {
+            // It's okay if we can't refresh, we'll just record errors for the ops if
+            // needed.
+            warning() << "could not refresh targeter" << causedBy(refreshStatus.reason());
+        }
+
+        int currCompletedOps = batchOp->numWriteOpsIn(WriteOpState_Completed);
+        if (currCompletedOps == numCompletedOps && !targeterChanged) {
+            ++numRefreshesWithoutProgress;
+        } else {
+            numRefreshesWithoutProgress = 0;
+        }
+        numCompletedOps = currCompletedOps;
+
+        // Stop targeting, then abort the remaining writes once the outstanding batches drain
+        if (numRefreshesWithoutProgress > kMaxRoundsWithoutProgress) {
+            giveUp = true;
+        }
+    }
 }
 
 void BatchWriteExecStats::noteWriteAt(const ConnectionString& host,
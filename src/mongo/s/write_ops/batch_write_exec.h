@@ -29,6 +29,7 @@
 #pragma once
 
 
+#include <atomic>
 #include <map>
 #include <string>
 
@@ -41,7 +42,12 @@
 
 namespace mongo {
 
+// How many child batches an unordered batch write keeps outstanding to each shard host. Zero
+// sends all batch writes in lock-step rounds.
+extern std::atomic<int> batchWriteMaxChildBatchesInFlightPerShard;  // NOLINT
+
 class BatchWriteExecStats;
+class BatchWriteOp;
 class MultiCommandDispatch;
 class OperationContext;
 
@@ -59,6 +65,11 @@ class OperationContext;
  * Both the targeter and dispatcher are assumed to be dedicated to this particular
  * BatchWriteExec instance.
  *
+ * Ordered batches are executed in rounds: everything targeted in a round is sent, all responses
+ * are received, and only then is the rest of the batch retargeted. Unordered batches are
+ * pipelined instead when 'batchWriteMaxChildBatchesInFlightPerShard' is non-zero. Each shard host
+ * then has up to that many child batches outstanding, a host gets its next child batch as soon as
+ * one of its responses comes back, and stale responses are retargeted one child batch at a time.
  */
 class BatchWriteExec {
     MONGO_DISALLOW_COPYING(BatchWriteExec);
@@ -78,6 +89,24 @@ public:
                       BatchWriteExecStats* stats);
 
 private:
+    /**
+     * Sends child batches in lock-step rounds until 'batchOp' is finished.
+     */
+    void _executeInRounds(OperationContext* txn,
+                          const BatchedCommandRequest& clientRequest,
+                          BatchWriteOp* batchOp,
+                          BatchWriteExecStats* stats);
+
+    /**
+     * Keeps up to 'maxInFlightPerHost' child batches outstanding to every shard host until
+     * 'batchOp' is finished. Only valid for unordered batches.
+     */
+    void _executePipelined(OperationContext* txn,
+                           const BatchedCommandRequest& clientRequest,
+                           size_t maxInFlightPerHost,
+                           BatchWriteOp* batchOp,
+                           BatchWriteExecStats* stats);
+
     // Not owned here
     NSTargeter* _targeter;
 
@@ -105,7 +134,8 @@ public:
 
     // Expose via helpers if this gets more complex
 
-    // Number of round trips required for the batch
+    // Number of round trips required for the batch. A pipelined batch counts a round each time all
+    // of its outstanding child batches have been answered.
     int numRounds;
     // Number of times targeting failed
     int numTargetErrors;
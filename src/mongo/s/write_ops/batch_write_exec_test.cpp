@@ -52,8 +52,10 @@ using std::vector;
 namespace {
 
 const HostAndPort kTestShardHost = HostAndPort("FakeHost", 12345);
+const HostAndPort kTestSlowShardHost = HostAndPort("FakeSlowHost", 12345);
 const HostAndPort kTestConfigShardHost = HostAndPort("FakeConfigHost", 12345);
 const string shardName = "FakeShard";
+const string slowShardName = "FakeSlowShard";
 
 /**
  * Mimics a single shard backend for a particular collection which can be initialized with a
@@ -303,5 +305,168 @@ TEST_F(BatchWriteExecTest, ManyStaleOpWithMigration) {
     ASSERT_EQUALS(stats.numStaleBatches, 6);
 }
 
+
+//
+// Tests for pipelined execution of unordered batches
+//
+
+class BatchWriteExecPipelinedTest : public BatchWriteExecTest {
+public:
+    void setUp() override {
+        BatchWriteExecTest::setUp();
+        _savedMaxInFlight = batchWriteMaxChildBatchesInFlightPerShard.load();
+        batchWriteMaxChildBatchesInFlightPerShard.store(2);
+    }
+
+    void tearDown() override {
+        batchWriteMaxChildBatchesInFlightPerShard.store(_savedMaxInFlight);
+        BatchWriteExecTest::tearDown();
+    }
+
+private:
+    int _savedMaxInFlight = 0;
+};
+
+TEST_F(BatchWriteExecPipelinedTest, StaleChildBatchRetriedWithoutNewRound) {
+    //
+    // Several child batches go to the same shard, and the first comes back stale. Its write is
+    // retargeted and sent while the other child batches are still outstanding.
+    //
+
+    BatchedCommandRequest request(BatchedCommandRequest::BatchType_Insert);
+    request.setNS(nss);
+    request.setOrdered(false);
+    request.setWriteConcern(BSONObj());
+    // More writes than fit in two child batches
+    const int numDocs = 2 * BatchedCommandRequest::kMaxWriteBatchSize + 500;
+    for (int i = 0; i < numDocs; i++) {
+        request.getInsertRequest()->addToDocuments(BSON("x" << i));
+    }
+
+    vector<MockWriteResult*> mockResults;
+    WriteErrorDetail error;
+    error.setErrCode(ErrorCodes::StaleShardVersion);
+    error.setErrMessage("mock stale error");
+    mockResults.push_back(new MockWriteResult(shardHost, error));
+
+    setMockResults(mockResults);
+
+    BatchedCommandResponse response;
+    BatchWriteExecStats stats;
+    exec->executeBatch(operationContext(), request, &response, &stats);
+    ASSERT(response.getOk());
+    ASSERT(!response.isErrDetailsSet());
+
+    ASSERT_EQUALS(stats.numStaleBatches, 1);
+    ASSERT_EQUALS(stats.numRounds, 1);
+}
+
+TEST_F(BatchWriteExecPipelinedTest, TooManyStaleOp) {
+    //
+    // Stale responses which never make progress abort the batch once nothing is outstanding
+    //
+
+    BatchedCommandRequest request(BatchedCommandRequest::BatchType_Insert);
+    request.setNS(nss);
+    request.setOrdered(false);
+    request.setWriteConcern(BSONObj());
+    request.getInsertRequest()->addToDocuments(BSON("x" << 1));
+    request.getInsertRequest()->addToDocuments(BSON("x" << 2));
+
+    vector<MockWriteResult*> mockResults;
+    WriteErrorDetail error;
+    error.setErrCode(ErrorCodes::StaleShardVersion);
+    error.setErrMessage("mock stale error");
+    for (int i = 0; i < 10; i++) {
+        mockResults.push_back(new MockWriteResult(shardHost, error, request.sizeWriteOps()));
+    }
+
+    setMockResults(mockResults);
+
+    BatchedCommandResponse response;
+    BatchWriteExecStats stats;
+    exec->executeBatch(operationContext(), request, &response, &stats);
+    ASSERT(response.getOk());
+    ASSERT_EQUALS(response.getN(), 0);
+    ASSERT(response.isErrDetailsSet());
+    ASSERT_EQUALS(response.getErrDetailsAt(0)->getErrCode(), ErrorCodes::NoProgressMade);
+    ASSERT_EQUALS(response.getErrDetailsAt(1)->getErrCode(), ErrorCodes::NoProgressMade);
+}
+
+/**
+ * Splits the collection between the fake shard, which owns x >= 0, and a second shard, which
+ * owns x < 0 and is slow to respond.
+ */
+class BatchWriteExecPipelinedSlowShardTest : public BatchWriteExecPipelinedTest {
+public:
+    void setUp() override {
+        BatchWriteExecPipelinedTest::setUp();
+
+        std::unique_ptr<RemoteCommandTargeterMock> targeter(
+            stdx::make_unique<RemoteCommandTargeterMock>());
+        targeter->setConnectionStringReturnValue(ConnectionString(kTestSlowShardHost));
+        targeter->setFindHostReturnValue(kTestSlowShardHost);
+        targeterFactory()->addTargeterToReturn(ConnectionString(kTestSlowShardHost),
+                                               std::move(targeter));
+
+        ShardType shardType;
+        shardType.setName(shardName);
+        shardType.setHost(kTestShardHost.toString());
+        ShardType slowShardType;
+        slowShardType.setName(slowShardName);
+        slowShardType.setHost(kTestSlowShardHost.toString());
+        setupShards({shardType, slowShardType});
+
+        vector<MockRange*> mockRanges;
+        mockRanges.push_back(new MockRange(ShardEndpoint(slowShardName, ChunkVersion::IGNORED()),
+                                           nss,
+                                           BSON("x" << MINKEY),
+                                           BSON("x" << 0)));
+        mockRanges.push_back(new MockRange(ShardEndpoint(shardName, ChunkVersion::IGNORED()),
+                                           nss,
+                                           BSON("x" << 0),
+                                           BSON("x" << MAXKEY)));
+        twoShardTargeter.init(mockRanges);
+
+        dispatcher.setSlowEndpoint(slowShardHost);
+        exec.reset(new BatchWriteExec(&twoShardTargeter, &dispatcher));
+    }
+
+    ConnectionString slowShardHost{kTestSlowShardHost};
+
+    MockNSTargeter twoShardTargeter;
+};
+
+TEST_F(BatchWriteExecPipelinedSlowShardTest, FastShardNotHeldUpBySlowShard) {
+    //
+    // One write goes to the slow shard, and enough for several child batches to the fast shard.
+    // The fast shard's pipeline keeps being topped up while the slow shard's child batch is
+    // outstanding, so every fast response comes back before the slow one.
+    //
+
+    BatchedCommandRequest request(BatchedCommandRequest::BatchType_Insert);
+    request.setNS(nss);
+    request.setOrdered(false);
+    request.setWriteConcern(BSONObj());
+    request.getInsertRequest()->addToDocuments(BSON("x" << -1));
+    const int numFastDocs = 4 * BatchedCommandRequest::kMaxWriteBatchSize;
+    for (int i = 0; i < numFastDocs; i++) {
+        request.getInsertRequest()->addToDocuments(BSON("x" << i));
+    }
+
+    BatchedCommandResponse response;
+    BatchWriteExecStats stats;
+    exec->executeBatch(operationContext(), request, &response, &stats);
+    ASSERT(response.getOk());
+    ASSERT(!response.isErrDetailsSet());
+
+    const vector<ConnectionString>& received = dispatcher.getReceived();
+    ASSERT_GREATER_THAN(received.size(), 2u);
+    for (size_t i = 0; i + 1 < received.size(); i++) {
+        ASSERT_EQUALS(received[i].toString(), shardHost.toString());
+    }
+    ASSERT_EQUALS(received.back().toString(), slowShardHost.toString());
+}
+
 }  // namespace
 }  // namespace mongo
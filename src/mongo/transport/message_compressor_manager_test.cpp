@@ -33,6 +33,8 @@
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_snappy.h"
+#include "mongo/transport/message_compressor_zlib.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/net/message.h"
 
@@ -179,7 +181,28 @@ TEST(NoopMessageCompressor, Fidelity) {
 
 TEST(SnappyMessageCompressor, Fidelity) {
     auto testMessage = buildMessage();
-    checkFidelity(testMessage, stdx::make_unique<NoopMessageCompressor>());
+    checkFidelity(testMessage, stdx::make_unique<SnappyMessageCompressor>());
+}
+
+TEST(ZlibMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>());
+}
+
+TEST(ZlibMessageCompressor, FidelityAtEveryLevel) {
+    auto testMessage = buildMessage();
+    for (int level = -1; level <= 9; level++) {
+        checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>(level));
+    }
+}
+
+TEST(ZlibMessageCompressor, CorruptInputIsRejected) {
+    ZlibMessageCompressor compressor;
+    const std::string garbage(64, 'x');
+    std::vector<char> output(256);
+    auto swLength = compressor.decompressData(ConstDataRange(garbage.data(), garbage.size()),
+                                              DataRange(output.data(), output.size()));
+    ASSERT_NOT_OK(swLength.getStatus());
 }
 
 }  // namespace mongo
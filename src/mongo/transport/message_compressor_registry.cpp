@@ -34,6 +34,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_snappy.h"
+#include "mongo/transport/message_compressor_zlib.h"
 #include "mongo/util/options_parser/option_section.h"
 
 #include <boost/algorithm/string/classification.hpp>
@@ -47,6 +48,8 @@ StringData getMessageCompressorName(MessageCompressor id) {
             return "noop"_sd;
         case MessageCompressor::kSnappy:
             return "snappy"_sd;
+        case MessageCompressor::kZlib:
+            return "zlib"_sd;
         default:
             fassert(40269, "Invalid message compressor ID");
     }
@@ -115,6 +118,17 @@ Status addMessageCompressionOptions(moe::OptionSection* options, bool forShell)
     if (forShell)
         ret.hidden();
 
+    auto zlibLevel =
+        options
+            ->addOptionChaining("net.compression.zlibCompressionLevel",
+                                "zlibNetworkCompressionLevel",
+                                moe::Int,
+                                "Compression level for the zlib network message compressor, from "
+                                "0 (none) to 9 (best), or -1 for the zlib default")
+            .validRange(-1, 9);
+    if (forShell)
+        zlibLevel.hidden();
+
     return Status::OK();
 }
 
@@ -125,6 +139,10 @@ Status storeMessageCompressionOptions(const moe::Environment& params) {
         boost::algorithm::split(restrict, compressorListStr, boost::is_any_of(", "));
     }
 
+    if (params.count("net.compression.zlibCompressionLevel")) {
+        zlibMessageCompressionLevel = params["net.compression.zlibCompressionLevel"].as<int>();
+    }
+
     auto& compressorFactory = MessageCompressorRegistry::get();
     compressorFactory.setSupportedCompressors(std::move(restrict));
 
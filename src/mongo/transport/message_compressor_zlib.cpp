@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_compressor_zlib.h"
+
+#include <zlib.h>
+
+#include "mongo/base/init.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_registry.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+int zlibMessageCompressionLevel = ZlibMessageCompressor::kDefaultCompressionLevel;
+
+ZlibMessageCompressor::ZlibMessageCompressor(int level)
+    : MessageCompressorBase(MessageCompressor::kZlib), _level(level) {}
+
+std::size_t ZlibMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return ::compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZlibMessageCompressor::compressData(ConstDataRange input,
+                                                            DataRange output) {
+    uLongf length = output.length();
+    int ret = ::compress2(reinterpret_cast<Bytef*>(const_cast<char*>(output.data())),
+                          &length,
+                          reinterpret_cast<const Bytef*>(input.data()),
+                          input.length(),
+                          _level);
+
+    if (ret != Z_OK) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not compress input, zlib error " << ret};
+    }
+
+    counterHitCompress(input.length(), length);
+    return {length};
+}
+
+StatusWith<std::size_t> ZlibMessageCompressor::decompressData(ConstDataRange input,
+                                                              DataRange output) {
+    uLongf length = output.length();
+    int ret = ::uncompress(reinterpret_cast<Bytef*>(const_cast<char*>(output.data())),
+                           &length,
+                           reinterpret_cast<const Bytef*>(input.data()),
+                           input.length());
+
+    if (ret != Z_OK || length != output.length()) {
+        return Status{ErrorCodes::BadValue, "Compressed message was invalid or corrupted"};
+    }
+
+    counterHitDecompress(input.length(), output.length());
+    return {output.length()};
+}
+
+
+MONGO_INITIALIZER_GENERAL(ZlibMessageCompressorInit,
+                          ("EndStartupOptionHandling"),
+                          ("AllCompressorsRegistered"))
+(InitializerContext* context) {
+    auto& compressorRegistry = MessageCompressorRegistry::get();
+    compressorRegistry.registerImplementation(
+        stdx::make_unique<ZlibMessageCompressor>(zlibMessageCompressionLevel));
+    return Status::OK();
+}
+}  // namespace mongo
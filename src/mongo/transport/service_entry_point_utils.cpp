@@ -34,12 +34,15 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/log.h"
+#include "mongo/util/net/message.h"
 #include "mongo/util/net/socket_exception.h"
 #include "mongo/util/quick_exit.h"
 
@@ -67,15 +70,14 @@ struct Context {
     stdx::function<void(const transport::SessionHandle&)> task;
 };
 
-void* runFunc(void* ptr) {
-    std::unique_ptr<Context> ctx(static_cast<Context*>(ptr));
-
-    auto tl = ctx->session->getTransportLayer();
-    Client::initThread("conn", ctx->session);
-    setThreadName(std::string(str::stream() << "conn" << ctx->session->id()));
-
+/**
+ * Runs 'fn', logging the exceptions that close a client connection. Returns false if 'fn' threw
+ * and the connection should be closed.
+ */
+bool runServiceEntryTask(const stdx::function<void()>& fn) {
     try {
-        ctx->task(ctx->session);
+        fn();
+        return true;
     } catch (const AssertionException& e) {
         log() << "AssertionException handling request, closing client connection: " << e;
     } catch (const SocketException& e) {
@@ -87,20 +89,112 @@ void* runFunc(void* ptr) {
         error() << "Uncaught std::exception: " << e.what() << ", terminating";
         quickExit(EXIT_UNCAUGHT);
     }
+    return false;
+}
 
-    tl->end(ctx->session);
+void endSession(const transport::SessionHandle& session) {
+    auto tl = session->getTransportLayer();
+    tl->end(session);
 
     if (!serverGlobalParams.quiet) {
         auto conns = tl->sessionStats().numOpenSessions;
         const char* word = (conns == 1 ? " connection" : " connections");
-        log() << "end connection " << ctx->session->remote() << " (" << conns << word
-              << " now open)";
+        log() << "end connection " << session->remote() << " (" << conns << word << " now open)";
     }
+}
+
+void* runFunc(void* ptr) {
+    std::unique_ptr<Context> ctx(static_cast<Context*>(ptr));
+
+    Client::initThread("conn", ctx->session);
+    setThreadName(std::string(str::stream() << "conn" << ctx->session->id()));
+
+    runServiceEntryTask([&] { ctx->task(ctx->session); });
+
+    endSession(ctx->session);
 
     Client::destroy();
 
     return nullptr;
 }
+
+/**
+ * Drives a session through source-Message, run-task cycles without a dedicated thread. Each
+ * cycle holds a reference to the chain through the pending asyncWait() callback, so the chain,
+ * and with it the session and its Client, lives until sourcing fails or a task throws.
+ */
+class TaskChain : public std::enable_shared_from_this<TaskChain> {
+public:
+    TaskChain(transport::SessionHandle session,
+              ServiceEntryTask task,
+              stdx::function<void()> onEnd)
+        : _session(std::move(session)),
+          _task(std::move(task)),
+          _onEnd(std::move(onEnd)),
+          _client(getGlobalServiceContext()->makeClient(
+              str::stream() << "conn" << _session->id(), _session)) {}
+
+    ~TaskChain() {
+        if (_onEnd) {
+            _onEnd();
+        }
+    }
+
+    void sourceNext() {
+        _message.reset();
+        auto self = shared_from_this();
+        _session->sourceMessage(&_message).asyncWait(
+            [self](Status status) { self->_onSourced(std::move(status)); });
+    }
+
+private:
+    void _onSourced(Status status) {
+        if (!status.isOK()) {
+            // Interruptions, network errors and sessions closed internally end the session
+            // quietly, as they do for the thread-per-session loops.
+            if (!ErrorCodes::isInterruption(status.code()) &&
+                !ErrorCodes::isNetworkError(status.code()) &&
+                status != transport::TransportLayer::TicketSessionClosedStatus) {
+                log() << "Error receiving request from client, closing client connection: "
+                      << status;
+            }
+            _end();
+            return;
+        }
+
+        // Borrow this worker thread for the session while its request runs.
+        const std::string workerName = getThreadName();
+        setThreadName(_client->desc());
+        Client::setCurrent(std::move(_client));
+
+        const bool ok = runServiceEntryTask([this] {
+            while (_task(_session, &_message)) {
+            }
+        });
+
+        _client = Client::releaseCurrent();
+        setThreadName(workerName);
+
+        if (!ok) {
+            _end();
+            return;
+        }
+
+        sourceNext();
+    }
+
+    void _end() {
+        endSession(_session);
+        _client.reset();
+    }
+
+    transport::SessionHandle _session;
+    ServiceEntryTask _task;
+    stdx::function<void()> _onEnd;
+    ServiceContext::UniqueClient _client;
+    Message _message;
+};
+
 }  // namespace
 
 void launchWrappedServiceEntryWorkerThread(
@@ -155,4 +249,11 @@ void launchWrappedServiceEntryWorkerThread(
     }
 }
 
+void launchServiceEntryTaskChain(transport::SessionHandle session,
+                                 ServiceEntryTask task,
+                                 stdx::function<void()> onEnd) {
+    std::make_shared<TaskChain>(std::move(session), std::move(task), std::move(onEnd))
+        ->sourceNext();
+}
+
 }  // namespace mongo
@@ -33,7 +33,28 @@
 
 namespace mongo {
 
+class Message;
+
 void launchWrappedServiceEntryWorkerThread(
     transport::SessionHandle session, stdx::function<void(const transport::SessionHandle&)> task);
 
+/**
+ * Handles one sourced Message for a session: runs it, and sinks any reply synchronously. Returns
+ * true if the handler replaced the contents of the Message with a follow-up request that must be
+ * run before sourcing again (as with exhaust cursors).
+ */
+using ServiceEntryTask = stdx::function<bool(const transport::SessionHandle&, Message*)>;
+
+/**
+ * Runs the session without dedicating a thread to it. Each Message is sourced with asyncWait()
+ * and 'task' is run on whichever TransportLayer thread completes the source, with the session's
+ * Client installed on that thread for the duration of the task. The session ends once sourcing
+ * fails or the task throws, after which 'onEnd', if set, is called.
+ *
+ * The session's TransportLayer must support asyncWait().
+ */
+void launchServiceEntryTaskChain(transport::SessionHandle session,
+                                 ServiceEntryTask task,
+                                 stdx::function<void()> onEnd = {});
+
 }  // namespace mongo
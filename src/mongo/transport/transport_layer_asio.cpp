@@ -0,0 +1,688 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_asio.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/config.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/stats/counters.h"
+#include "mongo/stdx/future.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/log.h"
+#include "mongo/util/net/listen.h"
+#include "mongo/util/net/sock.h"
+#include "mongo/util/net/ssl_options.h"
+#include "mongo/util/net/ssl_types.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/stringutils.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+const size_t kHeaderSize = sizeof(MSGHEADER::Value);
+
+Status errorCodeToStatus(const std::error_code& ec) {
+    if (ec == asio::error::eof) {
+        return {ErrorCodes::HostUnreachable, "Connection closed by peer"};
+    }
+    return {ErrorCodes::HostUnreachable, ec.message()};
+}
+
+HostAndPort endpointToHostAndPort(const asio::ip::tcp::endpoint& endpoint) {
+    return HostAndPort(endpoint.address().to_string(), endpoint.port());
+}
+
+}  // namespace
+
+TransportLayerASIO::ASIOSession::ASIOSession(TransportLayerASIO* tl, asio::ip::tcp::socket socket)
+    : _tl(tl), _socket(std::move(socket)), _closed(false) {
+    std::error_code ec;
+    auto remoteEndpoint = _socket.remote_endpoint(ec);
+    if (!ec) {
+        _remote = endpointToHostAndPort(remoteEndpoint);
+    }
+    auto localEndpoint = _socket.local_endpoint(ec);
+    if (!ec) {
+        _local = endpointToHostAndPort(localEndpoint);
+    }
+}
+
+TransportLayerASIO::ASIOSession::~ASIOSession() {
+    _tl->_destroy(*this);
+}
+
+bool TransportLayerASIO::ASIOSession::close() {
+    if (_closed.swap(true)) {
+        return false;
+    }
+
+    // Shutting the socket down, rather than closing it, is safe while another thread is blocked
+    // in or has an outstanding operation on it. The descriptor is released with the session.
+    std::error_code ec;
+    _socket.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+    return true;
+}
+
+TransportLayerASIO::ASIOTicket::ASIOTicket(const ASIOSessionHandle& session, Date_t expiration)
+    : _session(session), _sessionId(session->id()), _expiration(expiration) {}
+
+TransportLayerASIO::ASIOSessionHandle TransportLayerASIO::ASIOTicket::getSession() {
+    return _session.lock();
+}
+
+SessionId TransportLayerASIO::ASIOTicket::sessionId() const {
+    return _sessionId;
+}
+
+Date_t TransportLayerASIO::ASIOTicket::expiration() const {
+    return _expiration;
+}
+
+TransportLayerASIO::ASIOSourceTicket::ASIOSourceTicket(const ASIOSessionHandle& session,
+                                                       Date_t expiration,
+                                                       Message* target)
+    : ASIOTicket(session, expiration), _target(target) {}
+
+StatusWith<size_t> TransportLayerASIO::ASIOSourceTicket::_prepareBody() {
+    MsgData::ConstView md(_buffer.get());
+    const int msgLen = md.getLen();
+    if (static_cast<size_t>(msgLen) < kHeaderSize ||
+        static_cast<size_t>(msgLen) > MaxMessageSizeBytes) {
+        return {ErrorCodes::ProtocolError,
+                str::stream() << "recv(): message len " << msgLen << " is invalid. "
+                              << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes};
+    }
+
+    _buffer.realloc(msgLen);
+    return static_cast<size_t>(msgLen) - kHeaderSize;
+}
+
+Status TransportLayerASIO::ASIOSourceTicket::_finish(ASIOSession* session) {
+    _target->setData(std::move(_buffer));
+
+    networkCounter.hitPhysical(_target->size(), 0);
+    if (_target->operation() == dbCompressed) {
+        auto swm = session->getCompressorManager().decompressMessage(*_target);
+        if (!swm.isOK())
+            return swm.getStatus();
+        *_target = swm.getValue();
+    }
+    networkCounter.hitLogical(_target->size(), 0);
+    return Status::OK();
+}
+
+Status TransportLayerASIO::ASIOSourceTicket::fill(ASIOSession* session) {
+    std::error_code ec;
+    _buffer = SharedBuffer::allocate(kHeaderSize);
+    asio::read(session->getSocket(), asio::buffer(_buffer.get(), kHeaderSize), ec);
+    if (ec) {
+        return errorCodeToStatus(ec);
+    }
+
+    auto swBodySize = _prepareBody();
+    if (!swBodySize.isOK()) {
+        return swBodySize.getStatus();
+    }
+
+    asio::read(session->getSocket(),
+               asio::buffer(_buffer.get() + kHeaderSize, swBodySize.getValue()),
+               ec);
+    if (ec) {
+        return errorCodeToStatus(ec);
+    }
+
+    return _finish(session);
+}
+
+void TransportLayerASIO::ASIOSourceTicket::fillAsync(ASIOSessionHandle session,
+                                                     TicketCallback callback) {
+    _buffer = SharedBuffer::allocate(kHeaderSize);
+    auto& socket = session->getSocket();
+    asio::async_read(
+        socket,
+        asio::buffer(_buffer.get(), kHeaderSize),
+        [this, session, callback](const std::error_code& ec, size_t) {
+            if (ec) {
+                callback(errorCodeToStatus(ec));
+                return;
+            }
+
+            auto swBodySize = _prepareBody();
+            if (!swBodySize.isOK()) {
+                callback(swBodySize.getStatus());
+                return;
+            }
+
+            auto& socket = session->getSocket();
+            asio::async_read(socket,
+                             asio::buffer(_buffer.get() + kHeaderSize, swBodySize.getValue()),
+                             [this, session, callback](const std::error_code& ec, size_t) {
+                                 if (ec) {
+                                     callback(errorCodeToStatus(ec));
+                                     return;
+                                 }
+                                 callback(_finish(session.get()));
+                             });
+        });
+}
+
+TransportLayerASIO::ASIOSinkTicket::ASIOSinkTicket(const ASIOSessionHandle& session,
+                                                   Date_t expiration,
+                                                   const Message& msg)
+    : ASIOTicket(session, expiration), _msgToSend(msg) {}
+
+Status TransportLayerASIO::ASIOSinkTicket::_prepare(ASIOSession* session) {
+    networkCounter.hitLogical(0, _msgToSend.size());
+    auto swm = session->getCompressorManager().compressMessage(_msgToSend);
+    if (!swm.isOK())
+        return swm.getStatus();
+    _compressed = std::move(swm.getValue());
+    return Status::OK();
+}
+
+Status TransportLayerASIO::ASIOSinkTicket::fill(ASIOSession* session) {
+    auto status = _prepare(session);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    std::error_code ec;
+    asio::write(session->getSocket(), asio::buffer(_compressed.buf(), _compressed.size()), ec);
+    if (ec) {
+        return errorCodeToStatus(ec);
+    }
+
+    networkCounter.hitPhysical(0, _compressed.size());
+    return Status::OK();
+}
+
+void TransportLayerASIO::ASIOSinkTicket::fillAsync(ASIOSessionHandle session,
+                                                   TicketCallback callback) {
+    auto status = _prepare(session.get());
+    if (!status.isOK()) {
+        callback(std::move(status));
+        return;
+    }
+
+    auto& socket = session->getSocket();
+    asio::async_write(socket,
+                      asio::buffer(_compressed.buf(), _compressed.size()),
+                      [this, session, callback](const std::error_code& ec, size_t) {
+                          if (ec) {
+                              callback(errorCodeToStatus(ec));
+                              return;
+                          }
+                          networkCounter.hitPhysical(0, _compressed.size());
+                          callback(Status::OK());
+                      });
+}
+
+constexpr size_t TransportLayerASIO::kDefaultThreadsPerCore;
+
+TransportLayerASIO::TransportLayerASIO(const TransportLayerASIO::Options& opts,
+                                       ServiceEntryPoint* sep)
+    : _sep(sep), _running(false), _options(opts), _acceptorStrand(_ioService) {}
+
+TransportLayerASIO::~TransportLayerASIO() = default;
+
+Status TransportLayerASIO::setup() {
+#ifdef MONGO_CONFIG_SSL
+    if (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled) {
+        return {ErrorCodes::BadValue, "The asio transport layer does not support SSL"};
+    }
+#endif
+
+    std::vector<std::string> addresses;
+    if (_options.ipList.empty()) {
+        addresses.push_back("0.0.0.0");
+        if (IPv6Enabled()) {
+            addresses.push_back("::");
+        }
+    } else {
+        splitStringDelim(_options.ipList, &addresses, ',');
+    }
+
+    asio::ip::tcp::resolver resolver(_ioService);
+    for (auto&& address : addresses) {
+        std::error_code ec;
+        auto it = resolver.resolve(
+            asio::ip::tcp::resolver::query(address,
+                                           std::to_string(_options.port),
+                                           asio::ip::tcp::resolver::query::numeric_service),
+            ec);
+        if (ec) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Failed to resolve bind address " << address << ": "
+                                  << ec.message()};
+        }
+
+        for (; it != asio::ip::tcp::resolver::iterator(); ++it) {
+            const auto endpoint = it->endpoint();
+            if (endpoint.address().is_v6() && !IPv6Enabled()) {
+                continue;
+            }
+
+            auto acceptor = stdx::make_unique<asio::ip::tcp::acceptor>(_ioService);
+            acceptor->open(endpoint.protocol(), ec);
+            if (!ec) {
+                acceptor->set_option(asio::ip::tcp::acceptor::reuse_address(true), ec);
+            }
+            if (!ec && endpoint.address().is_v6()) {
+                acceptor->set_option(asio::ip::v6_only(true), ec);
+            }
+            if (!ec) {
+                acceptor->bind(endpoint, ec);
+            }
+            if (!ec) {
+                acceptor->listen(asio::socket_base::max_connections, ec);
+            }
+            if (ec) {
+                error() << "Failed to set up listener on " << endpointToHostAndPort(endpoint)
+                        << ": " << ec.message();
+                return {ErrorCodes::InternalError, "Failed to set up sockets"};
+            }
+
+            log() << "asio transport layer listening on " << endpointToHostAndPort(endpoint);
+            _acceptors.push_back(std::move(acceptor));
+        }
+    }
+
+    if (_acceptors.empty()) {
+        return {ErrorCodes::BadValue, "No addresses to listen on"};
+    }
+
+    return Status::OK();
+}
+
+int TransportLayerASIO::listenerPort() const {
+    invariant(!_acceptors.empty());
+    std::error_code ec;
+    return _acceptors.front()->local_endpoint(ec).port();
+}
+
+Status TransportLayerASIO::start() {
+    if (_running.swap(true)) {
+        return {ErrorCodes::InternalError, "TransportLayer is already running"};
+    }
+
+    size_t threadCount = _options.threadCount;
+    if (threadCount == 0) {
+        ProcessInfo p;
+        threadCount = kDefaultThreadsPerCore * p.getNumAvailableCores().value_or(p.getNumCores());
+        threadCount = std::max(threadCount, kDefaultThreadsPerCore);
+    }
+
+    _baseWorkers = threadCount;
+    _work = stdx::make_unique<asio::io_service::work>(_ioService);
+
+    for (auto&& acceptor : _acceptors) {
+        _acceptConnection(*acceptor);
+    }
+
+    log() << "asio transport layer starting " << threadCount << " worker threads";
+    for (size_t i = 0; i < threadCount; ++i) {
+        _spawnWorker();
+    }
+
+    return Status::OK();
+}
+
+void TransportLayerASIO::_spawnWorker() {
+    stdx::lock_guard<stdx::mutex> lk(_workersMutex);
+
+    for (auto&& id : _retiredWorkers) {
+        auto it = std::find_if(_workers.begin(), _workers.end(), [&](const stdx::thread& worker) {
+            return worker.get_id() == id;
+        });
+        invariant(it != _workers.end());
+        it->join();
+        _workers.erase(it);
+    }
+    _retiredWorkers.clear();
+
+    _numWorkers.fetchAndAdd(1);
+    const size_t workerId = _nextWorkerId++;
+    _workers.emplace_back([this, workerId] { _runWorker(workerId); });
+}
+
+void TransportLayerASIO::_runWorker(size_t workerId) {
+    const std::string threadName = str::stream() << "transport-asio-" << workerId;
+    setThreadName(threadName);
+    try {
+        while (true) {
+            std::error_code ec;
+            const size_t numRun = _ioService.run_one(ec);
+            if (ec) {
+                severe() << "Failure in asio transport layer worker: " << ec.message();
+                fassertFailed(40354);
+            }
+
+            // The io_service has run out of work, which only happens on shutdown.
+            if (numRun == 0) {
+                return;
+            }
+
+            if (_tryRetire()) {
+                LOG(1) << "asio transport layer worker " << workerId << " retiring";
+                stdx::lock_guard<stdx::mutex> lk(_workersMutex);
+                _retiredWorkers.push_back(stdx::this_thread::get_id());
+                return;
+            }
+        }
+    } catch (...) {
+        severe() << "Uncaught exception in asio transport layer worker thread: "
+                 << exceptionToStatus();
+        fassertFailed(40355);
+    }
+}
+
+void TransportLayerASIO::_onCallbackStart() {
+    const size_t busy = _busyWorkers.addAndFetch(1);
+    if (busy >= _numWorkers.load() && _running.load()) {
+        LOG(1) << "all " << busy << " asio transport layer workers are busy, adding a worker";
+        _spawnWorker();
+    }
+}
+
+void TransportLayerASIO::_onCallbackFinish() {
+    _busyWorkers.subtractAndFetch(1);
+    _requestRetirementIfSurplus();
+}
+
+void TransportLayerASIO::_requestRetirementIfSurplus() {
+    const size_t workers = _numWorkers.load();
+    if (workers > _baseWorkers && workers > _busyWorkers.load() + _baseWorkers &&
+        _retirementRequested.compareAndSwap(0, 1) == 0) {
+        // Wake up an idle worker, which will notice the request once the handler has run.
+        _ioService.post([] {});
+    }
+}
+
+bool TransportLayerASIO::_tryRetire() {
+    if (_retirementRequested.compareAndSwap(1, 0) != 1) {
+        return false;
+    }
+
+    // Workers may have become busy again since the retirement was requested.
+    const size_t workers = _numWorkers.load();
+    if (workers <= _baseWorkers || workers <= _busyWorkers.load() + _baseWorkers) {
+        return false;
+    }
+
+    _numWorkers.subtractAndFetch(1);
+
+    // Shrink one worker at a time until the pool is back to its size.
+    _requestRetirementIfSurplus();
+    return true;
+}
+
+Ticket TransportLayerASIO::sourceMessage(const SessionHandle& session,
+                                         Message* message,
+                                         Date_t expiration) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    return Ticket(this,
+                  stdx::make_unique<ASIOSourceTicket>(std::move(asioSession), expiration, message));
+}
+
+Ticket TransportLayerASIO::sinkMessage(const SessionHandle& session,
+                                       const Message& message,
+                                       Date_t expiration) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    return Ticket(this,
+                  stdx::make_unique<ASIOSinkTicket>(std::move(asioSession), expiration, message));
+}
+
+Status TransportLayerASIO::_checkTicket(const Ticket& ticket) const {
+    if (!_running.load()) {
+        return TransportLayer::ShutdownStatus;
+    }
+
+    if (ticket.expiration() < Date_t::now()) {
+        return Ticket::ExpiredStatus;
+    }
+
+    return Status::OK();
+}
+
+Status TransportLayerASIO::wait(Ticket&& ticket) {
+    auto status = _checkTicket(ticket);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(ticket));
+    auto session = asioTicket->getSession();
+    if (!session || session->isClosed()) {
+        return TransportLayer::TicketSessionClosedStatus;
+    }
+
+    try {
+        return asioTicket->fill(session.get());
+    } catch (...) {
+        return exceptionToStatus();
+    }
+}
+
+void TransportLayerASIO::asyncWait(Ticket&& ticket, TicketCallback callback) {
+    // The ticket must outlive the asynchronous operation, so it is owned by the completion
+    // handler from here on.
+    auto ownedTicket = std::make_shared<Ticket>(std::move(ticket));
+
+    auto status = _checkTicket(*ownedTicket);
+    auto asioTicket = checked_cast<ASIOTicket*>(getTicketImpl(*ownedTicket));
+    auto session = asioTicket->getSession();
+    if (status.isOK() && (!session || session->isClosed())) {
+        status = TransportLayer::TicketSessionClosedStatus;
+    }
+
+    // Failures are reported from a worker thread as well, so that callers never observe their
+    // callback running re-entrantly inside asyncWait().
+    if (!status.isOK()) {
+        _ioService.post([callback, status] { callback(status); });
+        return;
+    }
+
+    asioTicket->fillAsync(std::move(session), [this, ownedTicket, callback](Status status) {
+        _onCallbackStart();
+        ON_BLOCK_EXIT([this] { _onCallbackFinish(); });
+        callback(std::move(status));
+    });
+}
+
+SSLPeerInfo TransportLayerASIO::getX509PeerInfo(const ConstSessionHandle& session) const {
+    return SSLPeerInfo();
+}
+
+TransportLayer::Stats TransportLayerASIO::sessionStats() {
+    Stats stats;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+        stats.numOpenSessions = _sessions.size();
+    }
+
+    stats.numAvailableSessions = Listener::globalTicketHolder.available();
+    stats.numCreatedSessions = Listener::globalConnectionNumber.load();
+
+    return stats;
+}
+
+void TransportLayerASIO::end(const SessionHandle& session) {
+    auto asioSession = checked_pointer_cast<ASIOSession>(session);
+    _closeSession(*asioSession);
+}
+
+void TransportLayerASIO::_closeSession(ASIOSession& session) {
+    if (session.close()) {
+        Listener::globalTicketHolder.release();
+    }
+}
+
+void TransportLayerASIO::endAllSessions(Session::TagMask tags) {
+    log() << "asio transport layer closing all connections";
+
+    std::vector<ASIOSessionHandle> sessions;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+        for (auto&& weakSession : _sessions) {
+            if (auto session = weakSession.lock()) {
+                sessions.push_back(std::move(session));
+            }
+        }
+    }
+
+    // The handles must be released outside of the lock, as the last one to go calls _destroy().
+    for (auto&& session : sessions) {
+        if (session->getTags() & tags) {
+            log() << "Skip closing connection for connection # " << session->id();
+        } else {
+            _closeSession(*session);
+        }
+    }
+}
+
+void TransportLayerASIO::shutdown() {
+    if (!_running.swap(false)) {
+        return;
+    }
+
+    // Close the acceptors on the strand their accept handlers run on, and wait for that, so that
+    // no new session can start once the existing ones have been ended.
+    stdx::promise<void> acceptorsClosed;
+    _acceptorStrand.post([this, &acceptorsClosed] {
+        for (auto&& acceptor : _acceptors) {
+            std::error_code ec;
+            acceptor->close(ec);
+        }
+        acceptorsClosed.set_value();
+    });
+    acceptorsClosed.get_future().wait();
+
+    endAllSessions(Session::kEmptyTagMask);
+
+    // Let the workers drain the io_service rather than stopping it, so that the callbacks of
+    // every pending operation run and end their sessions. The callbacks of operations started
+    // from here on fail with ShutdownStatus.
+    _work.reset();
+
+    std::vector<stdx::thread> workers;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_workersMutex);
+        workers.swap(_workers);
+        _retiredWorkers.clear();
+    }
+    // A request running on a worker, like the shutdown command, may be shutting us down. The
+    // io_service can't drain until that request returns, so the workers can't be waited for.
+    const bool onWorker =
+        std::any_of(workers.begin(), workers.end(), [](const stdx::thread& worker) {
+            return worker.get_id() == stdx::this_thread::get_id();
+        });
+    for (auto&& worker : workers) {
+        if (onWorker) {
+            worker.detach();
+        } else {
+            worker.join();
+        }
+    }
+}
+
+void TransportLayerASIO::_destroy(ASIOSession& session) {
+    _closeSession(session);
+
+    stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+    _sessions.erase(session.getIter());
+}
+
+void TransportLayerASIO::_acceptConnection(asio::ip::tcp::acceptor& acceptor) {
+    auto socket = std::make_shared<asio::ip::tcp::socket>(_ioService);
+    acceptor.async_accept(
+        *socket, _acceptorStrand.wrap([this, &acceptor, socket](const std::error_code& ec) {
+            if (ec == asio::error::operation_aborted || !_running.load()) {
+                return;
+            }
+
+            if (ec) {
+                log() << "Error accepting new connection: " << ec.message();
+            } else {
+                _handleNewConnection(std::move(*socket));
+            }
+
+            _acceptConnection(acceptor);
+        }));
+}
+
+void TransportLayerASIO::_handleNewConnection(asio::ip::tcp::socket socket) {
+    std::error_code ec;
+    if (!Listener::globalTicketHolder.tryAcquire()) {
+        log() << "connection refused because too many open connections: "
+              << Listener::globalTicketHolder.used();
+        socket.close(ec);
+        return;
+    }
+
+    socket.set_option(asio::ip::tcp::no_delay(true), ec);
+    socket.set_option(asio::socket_base::keep_alive(true), ec);
+
+    auto session = std::make_shared<ASIOSession>(this, std::move(socket));
+    const long long connectionNumber = Listener::globalConnectionNumber.addAndFetch(1);
+
+    stdx::list<std::weak_ptr<ASIOSession>> list;
+    auto it = list.emplace(list.begin(), session);
+
+    size_t numOpen;
+    {
+        // Add the new session to our list
+        stdx::lock_guard<stdx::mutex> lk(_sessionsMutex);
+        session->setIter(it);
+        _sessions.splice(_sessions.begin(), list, it);
+        numOpen = _sessions.size();
+    }
+
+    if (!serverGlobalParams.quiet) {
+        const char* word = (numOpen == 1 ? " connection" : " connections");
+        log() << "connection accepted from " << session->remote() << " #" << connectionNumber
+              << " (" << numOpen << word << " now open)";
+    }
+
+    invariant(_sep);
+    _sep->startSession(std::move(session));
+}
+
+}  // namespace transport
+}  // namespace mongo
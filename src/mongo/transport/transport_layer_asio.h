@@ -0,0 +1,350 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <asio.hpp>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/list.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/ticket_impl.h"
+#include "mongo/transport/transport_layer.h"
+#include "mongo/util/net/message.h"
+
+namespace mongo {
+
+class ServiceEntryPoint;
+
+namespace transport {
+
+/**
+ * A TransportLayer implementation built on ASIO that multiplexes all of its sessions over a
+ * pool of worker threads.
+ *
+ * Sessions are not bound to a thread. A ServiceEntryPoint that wants to take advantage of this
+ * should source Messages with asyncWait(); the completion callback runs on one of this
+ * TransportLayer's worker threads, where the request may be processed and its reply sunk with
+ * a synchronous wait() before the next asynchronous source is issued. An idle session therefore
+ * costs a socket and a pending read, rather than an OS thread and its stack.
+ *
+ * Since a callback may block for as long as its request does, the pool is grown by a thread
+ * whenever every worker is running a callback, so that blocked requests can never keep others
+ * (such as the ones that would unblock them) from being read and run. Workers beyond
+ * Options::threadCount retire once they are no longer needed.
+ *
+ * This implementation only speaks plain TCP; it does not support SSL or UNIX domain sockets.
+ */
+class TransportLayerASIO final : public TransportLayer {
+    MONGO_DISALLOW_COPYING(TransportLayerASIO);
+
+public:
+    struct Options {
+        int port = 0;            // port to bind to
+        std::string ipList;      // addresses to bind to
+        size_t threadCount = 0;  // number of worker threads, 0 selects a default
+
+        Options() = default;
+    };
+
+    /**
+     * Number of worker threads per available core used when Options::threadCount is 0. Requests
+     * run to completion on a worker, so the pool is sized to tolerate some of them blocking on
+     * locks or disk without having to grow.
+     */
+    static constexpr size_t kDefaultThreadsPerCore = 4;
+
+    TransportLayerASIO(const Options& opts, ServiceEntryPoint* sep);
+
+    ~TransportLayerASIO();
+
+    /**
+     * Binds the listening sockets. Must be called before start().
+     */
+    Status setup();
+    Status start() override;
+
+    Ticket sourceMessage(const SessionHandle& session,
+                         Message* message,
+                         Date_t expiration = Ticket::kNoExpirationDate) override;
+
+    Ticket sinkMessage(const SessionHandle& session,
+                       const Message& message,
+                       Date_t expiration = Ticket::kNoExpirationDate) override;
+
+    Status wait(Ticket&& ticket) override;
+    void asyncWait(Ticket&& ticket, TicketCallback callback) override;
+
+    SSLPeerInfo getX509PeerInfo(const ConstSessionHandle& session) const override;
+
+    Stats sessionStats() override;
+
+    void end(const SessionHandle& session) override;
+    void endAllSessions(transport::Session::TagMask tags) override;
+
+    void shutdown() override;
+
+    /**
+     * Returns the port the first listening socket is bound to. Useful when setup() was asked to
+     * bind to port 0.
+     */
+    int listenerPort() const;
+
+    /**
+     * Returns the number of worker threads servicing sessions, including the ones the pool grew
+     * by while every worker was busy.
+     */
+    size_t numWorkerThreads() const {
+        return _numWorkers.load();
+    }
+
+private:
+    class ASIOSession;
+    class ASIOTicket;
+    class ASIOSourceTicket;
+    class ASIOSinkTicket;
+
+    using ASIOSessionHandle = std::shared_ptr<ASIOSession>;
+    using SessionEntry = std::list<std::weak_ptr<ASIOSession>>::iterator;
+
+    void _acceptConnection(asio::ip::tcp::acceptor& acceptor);
+    void _handleNewConnection(asio::ip::tcp::socket socket);
+
+    Status _checkTicket(const Ticket& ticket) const;
+
+    void _closeSession(ASIOSession& session);
+    void _destroy(ASIOSession& session);
+
+    /**
+     * Starts another worker thread. Also reaps the threads of workers which have retired.
+     */
+    void _spawnWorker();
+    void _runWorker(size_t workerId);
+
+    /**
+     * Called around every asyncWait() callback. Grows the pool when the callback occupies the
+     * last idle worker, and asks a surplus worker to retire when it is done.
+     */
+    void _onCallbackStart();
+    void _onCallbackFinish();
+
+    /**
+     * Asks a surplus worker to retire, if the pool has more idle workers than it needs and no
+     * retirement is already pending.
+     */
+    void _requestRetirementIfSurplus();
+
+    /**
+     * Returns true if the calling worker should exit because a retirement was requested.
+     */
+    bool _tryRetire();
+
+    /**
+     * An implementation of the Session interface for this TransportLayer. Owns the socket.
+     */
+    class ASIOSession : public Session {
+        MONGO_DISALLOW_COPYING(ASIOSession);
+
+    public:
+        ASIOSession(TransportLayerASIO* tl, asio::ip::tcp::socket socket);
+        ~ASIOSession();
+
+        TransportLayer* getTransportLayer() const override {
+            return _tl;
+        }
+
+        const HostAndPort& remote() const override {
+            return _remote;
+        }
+
+        const HostAndPort& local() const override {
+            return _local;
+        }
+
+        asio::ip::tcp::socket& getSocket() {
+            return _socket;
+        }
+
+        bool isClosed() const {
+            return _closed.load();
+        }
+
+        /**
+         * Marks the session closed and shuts the socket down so that any pending read or write
+         * completes. Returns false if the session was already closed.
+         */
+        bool close();
+
+        void setIter(SessionEntry it) {
+            _entry = std::move(it);
+        }
+
+        SessionEntry getIter() const {
+            return _entry;
+        }
+
+    private:
+        TransportLayerASIO* const _tl;
+
+        asio::ip::tcp::socket _socket;
+
+        HostAndPort _remote;
+        HostAndPort _local;
+
+        AtomicWord<bool> _closed;
+
+        // A handle to this session's entry in the TL's session list
+        SessionEntry _entry;
+    };
+
+    /**
+     * Base class for the tickets of this TransportLayer. A ticket is filled either synchronously
+     * on the calling thread, or asynchronously on the worker pool.
+     */
+    class ASIOTicket : public TicketImpl {
+        MONGO_DISALLOW_COPYING(ASIOTicket);
+
+    public:
+        ASIOTicket(const ASIOSessionHandle& session, Date_t expiration);
+
+        SessionId sessionId() const override;
+        Date_t expiration() const override;
+
+        /**
+         * If this ticket's session is still alive, return a shared_ptr. Otherwise,
+         * return nullptr.
+         */
+        ASIOSessionHandle getSession();
+
+        /**
+         * Fills this ticket using blocking socket operations on the calling thread.
+         */
+        virtual Status fill(ASIOSession* session) = 0;
+
+        /**
+         * Starts filling this ticket with asynchronous socket operations. The callback runs on a
+         * worker thread once the ticket is complete. The caller must keep this ticket alive until
+         * then.
+         */
+        virtual void fillAsync(ASIOSessionHandle session, TicketCallback callback) = 0;
+
+    private:
+        std::weak_ptr<ASIOSession> _session;
+
+        SessionId _sessionId;
+        Date_t _expiration;
+    };
+
+    /**
+     * Reads the MSGHEADER, then the remainder of the message, into the target Message.
+     */
+    class ASIOSourceTicket final : public ASIOTicket {
+    public:
+        ASIOSourceTicket(const ASIOSessionHandle& session, Date_t expiration, Message* target);
+
+        Status fill(ASIOSession* session) override;
+        void fillAsync(ASIOSessionHandle session, TicketCallback callback) override;
+
+    private:
+        /**
+         * Validates the header that has been read into _buffer and grows the buffer to hold the
+         * rest of the message. Returns the number of bytes left to read.
+         */
+        StatusWith<size_t> _prepareBody();
+
+        /**
+         * Hands the completed buffer to the target Message, decompressing it if needed.
+         */
+        Status _finish(ASIOSession* session);
+
+        Message* _target;
+        SharedBuffer _buffer;
+    };
+
+    /**
+     * Compresses and writes a Message.
+     */
+    class ASIOSinkTicket final : public ASIOTicket {
+    public:
+        ASIOSinkTicket(const ASIOSessionHandle& session, Date_t expiration, const Message& msg);
+
+        Status fill(ASIOSession* session) override;
+        void fillAsync(ASIOSessionHandle session, TicketCallback callback) override;
+
+    private:
+        Status _prepare(ASIOSession* session);
+
+        const Message& _msgToSend;
+        Message _compressed;
+    };
+
+    ServiceEntryPoint* _sep;
+
+    // TransportLayerASIO holds non-owning pointers to all of its sessions.
+    mutable stdx::mutex _sessionsMutex;
+    stdx::list<std::weak_ptr<ASIOSession>> _sessions;
+
+    AtomicWord<bool> _running;
+
+    Options _options;
+
+    // Declared after the session list: destroying the io_service destroys the handlers still
+    // queued on it, which may hold the last reference to a session.
+    asio::io_service _ioService;
+
+    // Keeps the workers running while there is nothing to do. Released on shutdown so that they
+    // exit once every pending operation has completed.
+    std::unique_ptr<asio::io_service::work> _work;
+
+    // Serializes the use of the acceptors, whose accept handlers and shutdown may otherwise run
+    // on different workers at once.
+    asio::io_service::strand _acceptorStrand;
+    std::vector<std::unique_ptr<asio::ip::tcp::acceptor>> _acceptors;
+
+    // The pool's size when no worker is blocked.
+    size_t _baseWorkers = 0;
+
+    AtomicWord<size_t> _numWorkers{0};
+    AtomicWord<size_t> _busyWorkers{0};
+
+    // 1 while a surplus worker has been asked to retire and none has done so yet.
+    AtomicWord<unsigned> _retirementRequested{0};
+
+    stdx::mutex _workersMutex;
+    size_t _nextWorkerId = 0;
+    std::vector<stdx::thread> _workers;
+
+    // Workers which have exited, but are still to be joined and removed from _workers.
+    std::vector<stdx::thread::id> _retiredWorkers;
+};
+
+}  // namespace transport
+}  // namespace mongo
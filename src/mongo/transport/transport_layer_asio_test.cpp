@@ -0,0 +1,270 @@
+/**
+ *    Copyright (C) 2016 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/transport_layer_asio.h"
+
+#include <asio.hpp>
+#include <vector>
+
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/session.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/net/message.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+const StringData kBlockPayload = "block"_sd;
+
+/**
+ * Echoes every Message it sources back to the client, sourcing asynchronously so that the
+ * sessions never own a thread. Messages whose payload is kBlockPayload are only echoed once
+ * unblock() is called, holding on to their worker until then.
+ */
+class EchoServiceEntryPoint final : public ServiceEntryPoint {
+public:
+    void startSession(SessionHandle session) override {
+        _sourceNext(std::move(session));
+    }
+
+    size_t numBlocked() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        return _numBlocked;
+    }
+
+    void unblock() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _unblocked = true;
+        _cv.notify_all();
+    }
+
+private:
+    void _sourceNext(SessionHandle session) {
+        auto message = std::make_shared<Message>();
+        session->sourceMessage(message.get()).asyncWait([this, session, message](Status status) {
+            if (!status.isOK()) {
+                session->getTransportLayer()->end(session);
+                return;
+            }
+
+            const auto data = message->singleData();
+            if (StringData(data.data(), data.dataLen()) == kBlockPayload) {
+                stdx::unique_lock<stdx::mutex> lk(_mutex);
+                ++_numBlocked;
+                _cv.wait(lk, [this] { return _unblocked; });
+                --_numBlocked;
+            }
+
+            if (!session->sinkMessage(*message).wait().isOK()) {
+                session->getTransportLayer()->end(session);
+                return;
+            }
+
+            _sourceNext(session);
+        });
+    }
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _cv;
+    size_t _numBlocked = 0;
+    bool _unblocked = false;
+};
+
+class TransportLayerASIOTest : public mongo::unittest::Test {
+public:
+    void setUp() override {
+        TransportLayerASIO::Options options;
+        options.ipList = "127.0.0.1";
+        options.threadCount = 2;
+
+        _tl = stdx::make_unique<TransportLayerASIO>(options, &_sep);
+        ASSERT_OK(_tl->setup());
+        ASSERT_OK(_tl->start());
+    }
+
+    void tearDown() override {
+        _tl->shutdown();
+    }
+
+    TransportLayerASIO* tl() {
+        return _tl.get();
+    }
+
+    std::unique_ptr<asio::ip::tcp::socket> connect() {
+        auto socket = stdx::make_unique<asio::ip::tcp::socket>(_clientService);
+        socket->connect(asio::ip::tcp::endpoint(asio::ip::address::from_string("127.0.0.1"),
+                                                tl()->listenerPort()));
+        return socket;
+    }
+
+    EchoServiceEntryPoint* sep() {
+        return &_sep;
+    }
+
+    void waitForOpenSessions(size_t expected) {
+        const auto deadline = Date_t::now() + Seconds(30);
+        while (tl()->sessionStats().numOpenSessions != expected) {
+            ASSERT_LT(Date_t::now(), deadline);
+            sleepmillis(10);
+        }
+    }
+
+    void waitForWorkerThreads(size_t expected) {
+        const auto deadline = Date_t::now() + Seconds(30);
+        while (tl()->numWorkerThreads() != expected) {
+            ASSERT_LT(Date_t::now(), deadline);
+            sleepmillis(10);
+        }
+    }
+
+private:
+    EchoServiceEntryPoint _sep;
+    std::unique_ptr<TransportLayerASIO> _tl;
+    asio::io_service _clientService;
+};
+
+Message makeMessage(StringData payload) {
+    Message message;
+    message.setData(dbQuery, payload.rawData(), payload.size());
+    return message;
+}
+
+std::string roundTrip(asio::ip::tcp::socket* socket, const Message& message) {
+    asio::write(*socket, asio::buffer(message.buf(), message.size()));
+
+    std::vector<char> reply(message.size());
+    asio::read(*socket, asio::buffer(reply.data(), reply.size()));
+    return std::string(reply.data(), reply.size());
+}
+
+TEST_F(TransportLayerASIOTest, ManySessionsShareFewThreads) {
+    const size_t kNumSessions = 100;
+
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> sockets;
+    for (size_t i = 0; i < kNumSessions; ++i) {
+        sockets.push_back(connect());
+    }
+    waitForOpenSessions(kNumSessions);
+    ASSERT_EQUALS(tl()->numWorkerThreads(), 2U);
+
+    // Every session is serviced even though they far outnumber the worker threads.
+    for (size_t i = 0; i < kNumSessions; ++i) {
+        auto message = makeMessage(std::to_string(i));
+        ASSERT_EQUALS(roundTrip(sockets[i].get(), message),
+                      std::string(message.buf(), message.size()));
+    }
+}
+
+TEST_F(TransportLayerASIOTest, PoolGrowsWhileEveryWorkerIsBlocked) {
+    auto blockMessage = makeMessage(kBlockPayload);
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> blockedSockets;
+    for (size_t i = 0; i < 2; ++i) {
+        blockedSockets.push_back(connect());
+        asio::write(*blockedSockets.back(), asio::buffer(blockMessage.buf(), blockMessage.size()));
+    }
+
+    const auto deadline = Date_t::now() + Seconds(30);
+    while (sep()->numBlocked() != 2) {
+        ASSERT_LT(Date_t::now(), deadline);
+        sleepmillis(10);
+    }
+
+    // Both of the original workers are blocked, but another session is still serviced.
+    auto socket = connect();
+    auto message = makeMessage("hello");
+    ASSERT_EQUALS(roundTrip(socket.get(), message), std::string(message.buf(), message.size()));
+    ASSERT_GT(tl()->numWorkerThreads(), 2U);
+
+    sep()->unblock();
+    for (auto&& blockedSocket : blockedSockets) {
+        std::vector<char> reply(blockMessage.size());
+        asio::read(*blockedSocket, asio::buffer(reply.data(), reply.size()));
+    }
+
+    // The workers added while the others were blocked retire.
+    waitForWorkerThreads(2);
+}
+
+TEST_F(TransportLayerASIOTest, ShutdownEndsEverySession) {
+    std::vector<std::unique_ptr<asio::ip::tcp::socket>> sockets;
+    for (size_t i = 0; i < 10; ++i) {
+        sockets.push_back(connect());
+    }
+    waitForOpenSessions(10);
+
+    // Every pending read completes and ends its session before shutdown returns.
+    tl()->shutdown();
+    ASSERT_EQUALS(tl()->sessionStats().numOpenSessions, 0U);
+}
+
+TEST_F(TransportLayerASIOTest, SessionEndsWhenClientDisconnects) {
+    auto socket = connect();
+    waitForOpenSessions(1);
+
+    auto message = makeMessage("hello");
+    ASSERT_EQUALS(roundTrip(socket.get(), message), std::string(message.buf(), message.size()));
+
+    socket->close();
+    waitForOpenSessions(0);
+}
+
+TEST_F(TransportLayerASIOTest, EndAllSessionsClosesConnections) {
+    auto socket = connect();
+    waitForOpenSessions(1);
+
+    tl()->endAllSessions(Session::kEmptyTagMask);
+
+    char byte;
+    std::error_code ec;
+    asio::read(*socket, asio::buffer(&byte, 1), ec);
+    ASSERT_TRUE(ec == asio::error::eof);
+    waitForOpenSessions(0);
+}
+
+TEST_F(TransportLayerASIOTest, InvalidMessageLengthEndsSession) {
+    auto socket = connect();
+    waitForOpenSessions(1);
+
+    // A header claiming a length shorter than the header itself.
+    auto message = makeMessage("");
+    MsgData::View(message.buf()).setLen(4);
+    asio::write(*socket, asio::buffer(message.buf(), message.size()));
+
+    waitForOpenSessions(0);
+}
+
+}  // namespace
+}  // namespace transport
+}  // namespace mongo
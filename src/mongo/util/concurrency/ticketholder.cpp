@@ -31,7 +31,7 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
+#include <algorithm>
 
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -83,6 +83,8 @@ void TicketHolder::waitForTicket() {
 }
 
 void TicketHolder::release() {
+    if (_takePendingShrink())
+        return;
     _check(sem_post(&_sem));
 }
 
@@ -99,13 +101,16 @@ Status TicketHolder::resize(int newSize) {
                                     << "; given "
                                     << newSize);
 
+    // Growing first cancels whatever is left of an earlier shrink.
     while (_outof.load() < newSize) {
         release();
         _outof.fetchAndAdd(1);
     }
 
+    // Shrinking must not wait for tickets in use, since the caller may be holding one itself.
     while (_outof.load() > newSize) {
-        waitForTicket();
+        if (!tryAcquire())
+            _pendingShrink.fetchAndAdd(1);
         _outof.subtractAndFetch(1);
     }
 
@@ -120,13 +125,24 @@ int TicketHolder::available() const {
 }
 
 int TicketHolder::used() const {
-    return outof() - available();
+    return outof() + _pendingShrink.load() - available();
 }
 
 int TicketHolder::outof() const {
     return _outof.load();
 }
 
+bool TicketHolder::_takePendingShrink() {
+    int pending = _pendingShrink.load();
+    while (pending > 0) {
+        const int seen = _pendingShrink.compareAndSwap(pending, pending - 1);
+        if (seen == pending)
+            return true;
+        pending = seen;
+    }
+    return false;
+}
+
 #else
 
 TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
@@ -157,19 +173,10 @@ void TicketHolder::release() {
 Status TicketHolder::resize(int newSize) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
 
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
-
-        std::string errmsg = ss.str();
-        log() << errmsg;
-        return Status(ErrorCodes::BadValue, errmsg);
-    }
-
+    // If more tickets are in use than 'newSize', _num goes negative and the excess is absorbed as
+    // the tickets are released.
+    _num += newSize - _outof.load();
     _outof.store(newSize);
-    _num = _outof.load() - used;
 
     // Potentially wasteful, but easier to see is correct
     _newTicket.notify_all();
@@ -177,7 +184,7 @@ Status TicketHolder::resize(int newSize) {
 }
 
 int TicketHolder::available() const {
-    return _num;
+    return std::max(_num, 0);
 }
 
 int TicketHolder::used() const {
@@ -190,9 +197,6 @@ int TicketHolder::outof() const {
 
 bool TicketHolder::_tryAcquire() {
     if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
-        }
         return false;
     }
     _num--;
@@ -50,6 +50,11 @@ public:
 
     void release();
 
+    /**
+     * Changes the number of tickets to 'newSize' without blocking. Shrinking takes the tickets
+     * that are available right away; any remainder is taken out of circulation by release() as
+     * the tickets in use are returned.
+     */
     Status resize(int newSize);
 
     int available() const;
@@ -62,13 +67,21 @@ private:
 #if defined(__linux__)
     mutable sem_t _sem;
 
+    bool _takePendingShrink();
+
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicInt32 _outof;
     stdx::mutex _resizeMutex;
+
+    // Tickets still in use that resize() has removed from _outof, and which release() must
+    // therefore absorb instead of posting back to the semaphore.
+    AtomicInt32 _pendingShrink;
 #else
     bool _tryAcquire();
 
     AtomicInt32 _outof;
+
+    // Negative while a shrink is waiting for tickets in use to be released.
     int _num;
     stdx::mutex _mutex;
     stdx::condition_variable _newTicket;
@@ -130,6 +130,12 @@ public:
      */
     virtual bool isStillConnected() const = 0;
 
+    /**
+     * The descriptor of the underlying socket, which may be polled for incoming data, or -1 if
+     * there is no such socket.
+     */
+    virtual int rawFD() = 0;
+
     /**
      * Point in time (in micro seconds) when this was created.
      */
@@ -609,6 +609,10 @@ bool ASIOMessagingPort::isStillConnected() const {
     return _getSocket().is_open();
 }
 
+int ASIOMessagingPort::rawFD() {
+    return _getSocket().is_open() ? static_cast<int>(_getSocket().native_handle()) : -1;
+}
+
 uint64_t ASIOMessagingPort::getSockCreationMicroSec() const {
     return _creationTime;
 }
@@ -132,6 +132,10 @@ public:
         return _psock->isStillConnected();
     }
 
+    int rawFD() override {
+        return _psock->rawFD();
+    }
+
     uint64_t getSockCreationMicroSec() const override {
         return _psock->getSockCreationMicroSec();
     }
@@ -69,6 +69,8 @@ public:
 
     bool isStillConnected() const override;
 
+    int rawFD() override;
+
     void setLogLevel(logger::LogSeverity logLevel) override;
 
     void clearCounters() override;